@@ -0,0 +1,59 @@
+#ifndef THIN_ALLOC_COUNT_INCLUDED_
+#define THIN_ALLOC_COUNT_INCLUDED_
+
+
+/*
+  Counts heap allocations for bench.cpp and replay.cpp. glibc lets the
+  executable interpose malloc, count through that. Elsewhere alloc_counting
+  is false and the tools report allocations as null.
+
+  Defines malloc, calloc and realloc, include it from one translation unit
+  of an executable only.
+*/
+
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+// -----------------------------------------------------------[ Allocations ]--
+
+#if defined(__GLIBC__)
+
+extern "C" void *__libc_malloc(size_t size);
+extern "C" void *__libc_calloc(size_t count, size_t size);
+extern "C" void *__libc_realloc(void *ptr, size_t size);
+
+static uint64_t alloc_count = 0;
+static const bool alloc_counting = true;
+
+extern "C" void *
+malloc(size_t size)
+{
+  ++alloc_count;
+  return __libc_malloc(size);
+}
+
+extern "C" void *
+calloc(size_t count, size_t size)
+{
+  ++alloc_count;
+  return __libc_calloc(count, size);
+}
+
+extern "C" void *
+realloc(void *ptr, size_t size)
+{
+  ++alloc_count;
+  return __libc_realloc(ptr, size);
+}
+
+#else
+
+static uint64_t alloc_count = 0;
+static const bool alloc_counting = false;
+
+#endif
+
+
+#endif // inc guard
@@ -0,0 +1,432 @@
+
+/*
+  Times Device's hot paths and writes one JSON object, to the file given as
+  the first argument or stdout.
+
+  Built twice by the rakefile, against THIN_NULL_BACKEND to see what thin
+  itself costs, and against a headless EGL context (llvmpipe on CI) to see
+  it next to a real driver. Keep the benchmark names stable, results are
+  diffed between runs to catch regressions.
+
+  The rakefile builds it with THIN_NO_EXTRA_CHECKS so the numbers are the
+  bind cache's and not the debug glGetErrors, "extra_checks" in the JSON
+  says which build ran.
+*/
+
+#ifndef THIN_NULL_BACKEND
+#define THIN_HEADLESS_IMPL
+#include <thin/ogl_headless.hpp>
+#endif
+
+#define THIN_DEVICE_IMPL
+#include <thin/ogl_device.hpp>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+
+#include "alloc_count.hpp"
+
+
+// ------------------------------------------------------------------[ Bench ]--
+
+Device gl;
+
+constexpr int bench_repeats = 5;
+constexpr double bench_target_ns = 20e6;
+constexpr uint64_t bench_max_iterations = 10000000;
+
+static bool bench_first = true;
+static FILE *bench_out = nullptr;
+
+#ifndef THIN_NULL_BACKEND
+// Real drivers don't count calls, stubs in the glad slots do it for them.
+static uint64_t bench_driver_calls = 0;
+static void *bench_real_functions[gl_id_count];
+
+template<typename fn_type>
+struct BenchCountStub;
+
+template<typename R, typename ...Args>
+struct BenchCountStub<R(APIENTRYP)(Args...)>
+{
+  template<size_t id>
+  static R APIENTRY
+  call(Args... args)
+  {
+    ++bench_driver_calls;
+    return ((R(APIENTRYP)(Args...))bench_real_functions[id])(args...);
+  }
+};
+
+static void
+benchCountCalls(const bool count)
+{
+  if(!count)
+  {
+    for(size_t i = 0; i < gl_id_count; ++i)
+    {
+      *gl_function_slots[i] = bench_real_functions[i];
+    }
+
+    return;
+  }
+
+  for(size_t i = 0; i < gl_id_count; ++i)
+  {
+    bench_real_functions[i] = *gl_function_slots[i];
+  }
+
+  // Missing functions stay null so support checks still see them missing.
+  #define THIN_GL_FUNCTION(name) \
+    if(glad_##name) { glad_##name = &BenchCountStub<decltype(glad_##name)>::template call<gl_id_##name>; }
+  #include <thin/glad_functions.inl>
+  #undef THIN_GL_FUNCTION
+
+  #define THIN_GL_EXTRA(name, ptr) \
+    if(ptr) { ptr = &BenchCountStub<decltype(ptr)>::template call<gl_id_##name>; }
+  THIN_GL_EXTRA_FUNCTIONS(THIN_GL_EXTRA)
+  #undef THIN_GL_EXTRA
+}
+#endif
+
+static uint64_t
+benchDriverCalls()
+{
+  #ifdef THIN_NULL_BACKEND
+  return glNullCallCount();
+  #else
+  return bench_driver_calls;
+  #endif
+}
+
+template<typename Fn>
+static double
+benchTime(Fn &fn, const uint64_t iterations)
+{
+  const auto start = std::chrono::steady_clock::now();
+
+  for(uint64_t i = 0; i < iterations; ++i)
+  {
+    fn();
+  }
+
+  // Real drivers queue, make sure the work is inside the timing.
+  #ifndef THIN_NULL_BACKEND
+  glFinish();
+  #endif
+
+  const auto end = std::chrono::steady_clock::now();
+
+  return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
+
+template<typename Fn>
+static void
+bench(const char *name, Fn fn)
+{
+  // First call pays for lazy driver work (shader variants, allocations), keep
+  // it out of the calibration.
+  benchTime(fn, 1);
+
+  // Double until a run is long enough to time, then scale that to an
+  // iteration count that runs for ~20ms.
+  uint64_t iterations = 1;
+  double warm_ns = benchTime(fn, iterations);
+
+  while(warm_ns < bench_target_ns / 16. && iterations < bench_max_iterations)
+  {
+    iterations *= 2;
+    warm_ns = benchTime(fn, iterations);
+  }
+
+  const double scale = bench_target_ns / (warm_ns > 1. ? warm_ns : 1.);
+
+  iterations = (uint64_t)((double)iterations * scale);
+  iterations = iterations < 1 ? 1 : iterations;
+  iterations = iterations > bench_max_iterations ? bench_max_iterations : iterations;
+
+  double best_ns = 0.;
+  uint64_t allocs = 0;
+
+  for(int r = 0; r < bench_repeats; ++r)
+  {
+    const uint64_t start_allocs = alloc_count;
+
+    const double ns = benchTime(fn, iterations) / (double)iterations;
+
+    // Least disturbed run, allocs are the same every run.
+    if(r == 0 || ns < best_ns)
+    {
+      best_ns = ns;
+    }
+
+    allocs = alloc_count - start_allocs;
+  }
+
+  // Calls are counted in a run of their own, outside the timing and without
+  // benchTime's glFinish.
+  const uint64_t call_iterations = iterations < 1000 ? iterations : 1000;
+
+  #ifndef THIN_NULL_BACKEND
+  benchCountCalls(true);
+  #endif
+
+  const uint64_t start_calls = benchDriverCalls();
+
+  for(uint64_t i = 0; i < call_iterations; ++i)
+  {
+    fn();
+  }
+
+  const uint64_t calls = benchDriverCalls() - start_calls;
+
+  #ifndef THIN_NULL_BACKEND
+  benchCountCalls(false);
+  #endif
+
+  fprintf(bench_out, "%s\n    {\"name\": \"%s\", \"iterations\": %llu, \"ns_per_op\": %.2f, ",
+          bench_first ? "" : ",",
+          name,
+          (unsigned long long)iterations,
+          best_ns);
+
+  if(alloc_counting)
+  {
+    fprintf(bench_out, "\"allocs_per_op\": %.2f, ", (double)allocs / (double)iterations);
+  }
+  else
+  {
+    fprintf(bench_out, "\"allocs_per_op\": null, ");
+  }
+
+  fprintf(bench_out, "\"driver_calls_per_op\": %.2f}", (double)calls / (double)call_iterations);
+
+  bench_first = false;
+}
+
+template<typename Gen, typename Del>
+static void
+benchGenDelete(const char *name, const size_t count, Gen gen, Del del)
+{
+  uintptr_t *names = (uintptr_t*)malloc(count * sizeof(uintptr_t));
+
+  char full_name[64];
+  snprintf(full_name, sizeof(full_name), "%s_%zu", name, count);
+
+  bench(full_name, [&]()
+  {
+    gen(count, names);
+    del(count, names);
+  });
+
+  free(names);
+}
+
+
+// ---------------------------------------------------------------[ Shaders ]--
+
+const char *bench_vs =
+  "#version 150 core\n"
+  "in vec2 position;"
+  "uniform int index;"
+  "void main() { gl_Position = vec4(position, float(index) * 0.0, 1.0); }";
+
+const char *bench_fs =
+  "#version 150 core\n"
+  "out vec4 color;"
+  "uniform sampler2D tex;"
+  "void main() { color = texture(tex, vec2(0.5)); }";
+
+
+// -------------------------------------------------------------------[ Main ]--
+
+int
+main(int argc, char **argv)
+{
+  bench_out = argc > 1 ? fopen(argv[1], "w") : stdout;
+
+  if(!bench_out)
+  {
+    fprintf(stderr, "Failed to open %s\n", argv[1]);
+    return 1;
+  }
+
+  #ifdef THIN_NULL_BACKEND
+  gl.initialize();
+  #else
+  HeadlessContext headless;
+
+  // Tiny target, draws should measure submission not fill.
+  if(!createHeadlessContext(&headless, 8, 8, 3, 3))
+  {
+    fprintf(stderr, "Failed to create a headless context\n");
+    return 1;
+  }
+
+  gl.initialize(GLLoading::all, headlessGetProc);
+  #endif
+
+  fprintf(bench_out,
+          "{\n  \"backend\": \"%s\",\n  \"renderer\": \"%s\",\n  \"extra_checks\": %s,\n  \"benchmarks\": [",
+          #ifdef THIN_NULL_BACKEND
+          "null",
+          #else
+          "gl",
+          #endif
+          (const char*)glGetString(GL_RENDERER),
+          #ifdef THIN_EXTRA_ERROR_CHECKS
+          "true");
+          #else
+          "false");
+          #endif
+
+  // Objects the binds and draws work with.
+  const uintptr_t program = gl.createProgram(bench_vs, "", bench_fs);
+  gl.bindFragDataLocation(program, 0, "color");
+  gl.useProgram(program);
+
+  const intptr_t uniform = gl.getUniformLocation(program, "index");
+
+  uintptr_t textures[2];
+  gl.genTextures(2, textures);
+
+  uintptr_t buffers[2];
+  gl.genBuffers(2, buffers);
+
+  const float verts[] = {-1.f, -1.f, 1.f, -1.f, 0.f, 1.f};
+  const uint16_t indices[] = {0, 1, 2};
+
+  gl.bindBuffer(GL_ARRAY_BUFFER, buffers[0]);
+  gl.bufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW);
+
+  VertexLayout layout;
+  memset(&layout, 0, sizeof(layout));
+  layout.attribs[0].index = (GLuint)gl.getAttribLocation(program, "position");
+  layout.attribs[0].size = 2;
+  layout.attribs[0].type = GL_FLOAT;
+  layout.attrib_count = 1;
+  layout.strides[0] = 2 * sizeof(float);
+
+  gl.bindVertexLayout(layout, 1, &buffers[0], buffers[1]);
+  gl.bufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+
+  const uint64_t layout_hash = vertexLayoutHash(layout);
+
+  // State binds, alternate so nothing can be skipped as redundant.
+  uint32_t flip = 0;
+
+  bench("bindTexture", [&]()
+  {
+    gl.bindTexture(GL_TEXTURE_2D, textures[++flip & 1]);
+  });
+
+  bench("bindActiveTexture", [&]()
+  {
+    const GLuint slot = ++flip & 1;
+    gl.bindActiveTexture(GL_TEXTURE0 + slot, GL_TEXTURE_2D, textures[(flip >> 1) & 1]);
+  });
+
+  // Same texture every time, measures the bind cache dropping it.
+  gl.bindActiveTexture(GL_TEXTURE0, GL_TEXTURE_2D, textures[0]);
+
+  bench("bindTextureRedundant", [&]()
+  {
+    gl.bindTexture(GL_TEXTURE_2D, textures[0]);
+  });
+
+  // A material's worth of units, every unit changes every call.
+  uintptr_t texture_sets[2][8];
+
+  for(size_t i = 0; i < 8; ++i)
+  {
+    texture_sets[0][i] = textures[i & 1];
+    texture_sets[1][i] = textures[(i + 1) & 1];
+  }
+
+  bench("bindTextures_8", [&]()
+  {
+    gl.bindTextures(0, 8, texture_sets[++flip & 1]);
+  });
+
+  bench("bindBuffer", [&]()
+  {
+    gl.bindBuffer(GL_ARRAY_BUFFER, buffers[++flip & 1]);
+  });
+
+  bench("useProgram", [&]()
+  {
+    gl.useProgram((++flip & 1) ? program : 0);
+  });
+
+  gl.useProgram(program);
+
+  bench("bindVertexLayout", [&]()
+  {
+    gl.bindVertexLayout(layout_hash, layout, 1, &buffers[0], buffers[1]);
+  });
+
+  // Uniforms
+  bench("uniform1i", [&]()
+  {
+    gl.uniform1i(uniform, (GLint)(++flip & 1));
+  });
+
+  // Draw submission
+  gl.bindActiveTexture(GL_TEXTURE0, GL_TEXTURE_2D, textures[0]);
+  gl.bindVertexLayout(layout_hash, layout, 1, &buffers[0], buffers[1]);
+
+  bench("drawArrays", [&]()
+  {
+    gl.drawArrays(GL_TRIANGLES, 0, 3);
+  });
+
+  bench("drawElements", [&]()
+  {
+    gl.drawElements(GL_TRIANGLES, 3, GL_UNSIGNED_SHORT, nullptr);
+  });
+
+  // Object churn
+  const size_t counts[] = {1, 100, 10000};
+
+  for(const size_t count : counts)
+  {
+    benchGenDelete("genDeleteBuffers", count,
+      [](const size_t n, uintptr_t *names) { gl.genBuffers(n, names); },
+      [](const size_t n, uintptr_t *names) { gl.deleteBuffers(n, names); });
+
+    benchGenDelete("genDeleteTextures", count,
+      [](const size_t n, uintptr_t *names) { gl.genTextures(n, names); },
+      [](const size_t n, uintptr_t *names) { gl.deleteTextures(n, names); });
+
+    benchGenDelete("genDeleteVertexArrays", count,
+      [](const size_t n, uintptr_t *names) { gl.genVertexArrays(n, names); },
+      [](const size_t n, uintptr_t *names) { gl.deleteVertexArrays(n, names); });
+  }
+
+  // Shaders
+  bench("createProgram", [&]()
+  {
+    gl.deleteProgram(gl.createProgram(bench_vs, "", bench_fs));
+  });
+
+  fprintf(bench_out, "\n  ]\n}\n");
+
+  gl.clearVertexArrayCache();
+  gl.deleteBuffers(2, buffers);
+  gl.deleteTextures(2, textures);
+  gl.deleteProgram(program);
+
+  #ifndef THIN_NULL_BACKEND
+  destroyHeadlessContext(&headless);
+  #endif
+
+  if(bench_out != stdout)
+  {
+    fclose(bench_out);
+  }
+
+  return 0;
+}
@@ -0,0 +1,843 @@
+/*
+  Every entry point glad loads, one THIN_GL_FUNCTION(name) per line. Define
+  THIN_GL_FUNCTION before including to build tables or stubs from the list.
+
+  Generated from glad.c, regenerate with the loader:
+
+    grep "^PFN.* glad_gl" glad.c | sed 's/.* glad_\(gl[A-Za-z0-9_]*\);/THIN_GL_FUNCTION(\1)/' | sort
+*/
+
+THIN_GL_FUNCTION(glAccum)
+THIN_GL_FUNCTION(glActiveTexture)
+THIN_GL_FUNCTION(glAlphaFunc)
+THIN_GL_FUNCTION(glAreTexturesResident)
+THIN_GL_FUNCTION(glArrayElement)
+THIN_GL_FUNCTION(glAttachShader)
+THIN_GL_FUNCTION(glBegin)
+THIN_GL_FUNCTION(glBeginConditionalRender)
+THIN_GL_FUNCTION(glBeginQuery)
+THIN_GL_FUNCTION(glBeginQueryIndexed)
+THIN_GL_FUNCTION(glBeginTransformFeedback)
+THIN_GL_FUNCTION(glBindAttribLocation)
+THIN_GL_FUNCTION(glBindBuffer)
+THIN_GL_FUNCTION(glBindBufferBase)
+THIN_GL_FUNCTION(glBindBufferRange)
+THIN_GL_FUNCTION(glBindFragDataLocation)
+THIN_GL_FUNCTION(glBindFragDataLocationIndexed)
+THIN_GL_FUNCTION(glBindFramebuffer)
+THIN_GL_FUNCTION(glBindRenderbuffer)
+THIN_GL_FUNCTION(glBindSampler)
+THIN_GL_FUNCTION(glBindTexture)
+THIN_GL_FUNCTION(glBindTransformFeedback)
+THIN_GL_FUNCTION(glBindVertexArray)
+THIN_GL_FUNCTION(glBitmap)
+THIN_GL_FUNCTION(glBlendColor)
+THIN_GL_FUNCTION(glBlendEquation)
+THIN_GL_FUNCTION(glBlendEquationSeparate)
+THIN_GL_FUNCTION(glBlendEquationSeparatei)
+THIN_GL_FUNCTION(glBlendEquationi)
+THIN_GL_FUNCTION(glBlendFunc)
+THIN_GL_FUNCTION(glBlendFuncSeparate)
+THIN_GL_FUNCTION(glBlendFuncSeparatei)
+THIN_GL_FUNCTION(glBlendFunci)
+THIN_GL_FUNCTION(glBlitFramebuffer)
+THIN_GL_FUNCTION(glBufferData)
+THIN_GL_FUNCTION(glBufferSubData)
+THIN_GL_FUNCTION(glCallCommandListNV)
+THIN_GL_FUNCTION(glCallList)
+THIN_GL_FUNCTION(glCallLists)
+THIN_GL_FUNCTION(glCheckFramebufferStatus)
+THIN_GL_FUNCTION(glClampColor)
+THIN_GL_FUNCTION(glClear)
+THIN_GL_FUNCTION(glClearAccum)
+THIN_GL_FUNCTION(glClearBufferfi)
+THIN_GL_FUNCTION(glClearBufferfv)
+THIN_GL_FUNCTION(glClearBufferiv)
+THIN_GL_FUNCTION(glClearBufferuiv)
+THIN_GL_FUNCTION(glClearColor)
+THIN_GL_FUNCTION(glClearDepth)
+THIN_GL_FUNCTION(glClearIndex)
+THIN_GL_FUNCTION(glClearStencil)
+THIN_GL_FUNCTION(glClientActiveTexture)
+THIN_GL_FUNCTION(glClientWaitSync)
+THIN_GL_FUNCTION(glClipPlane)
+THIN_GL_FUNCTION(glColor3b)
+THIN_GL_FUNCTION(glColor3bv)
+THIN_GL_FUNCTION(glColor3d)
+THIN_GL_FUNCTION(glColor3dv)
+THIN_GL_FUNCTION(glColor3f)
+THIN_GL_FUNCTION(glColor3fv)
+THIN_GL_FUNCTION(glColor3i)
+THIN_GL_FUNCTION(glColor3iv)
+THIN_GL_FUNCTION(glColor3s)
+THIN_GL_FUNCTION(glColor3sv)
+THIN_GL_FUNCTION(glColor3ub)
+THIN_GL_FUNCTION(glColor3ubv)
+THIN_GL_FUNCTION(glColor3ui)
+THIN_GL_FUNCTION(glColor3uiv)
+THIN_GL_FUNCTION(glColor3us)
+THIN_GL_FUNCTION(glColor3usv)
+THIN_GL_FUNCTION(glColor4b)
+THIN_GL_FUNCTION(glColor4bv)
+THIN_GL_FUNCTION(glColor4d)
+THIN_GL_FUNCTION(glColor4dv)
+THIN_GL_FUNCTION(glColor4f)
+THIN_GL_FUNCTION(glColor4fv)
+THIN_GL_FUNCTION(glColor4i)
+THIN_GL_FUNCTION(glColor4iv)
+THIN_GL_FUNCTION(glColor4s)
+THIN_GL_FUNCTION(glColor4sv)
+THIN_GL_FUNCTION(glColor4ub)
+THIN_GL_FUNCTION(glColor4ubv)
+THIN_GL_FUNCTION(glColor4ui)
+THIN_GL_FUNCTION(glColor4uiv)
+THIN_GL_FUNCTION(glColor4us)
+THIN_GL_FUNCTION(glColor4usv)
+THIN_GL_FUNCTION(glColorMask)
+THIN_GL_FUNCTION(glColorMaski)
+THIN_GL_FUNCTION(glColorMaterial)
+THIN_GL_FUNCTION(glColorP3ui)
+THIN_GL_FUNCTION(glColorP3uiv)
+THIN_GL_FUNCTION(glColorP4ui)
+THIN_GL_FUNCTION(glColorP4uiv)
+THIN_GL_FUNCTION(glColorPointer)
+THIN_GL_FUNCTION(glCommandListSegmentsNV)
+THIN_GL_FUNCTION(glCompileCommandListNV)
+THIN_GL_FUNCTION(glCompileShader)
+THIN_GL_FUNCTION(glCompressedTexImage1D)
+THIN_GL_FUNCTION(glCompressedTexImage2D)
+THIN_GL_FUNCTION(glCompressedTexImage3D)
+THIN_GL_FUNCTION(glCompressedTexSubImage1D)
+THIN_GL_FUNCTION(glCompressedTexSubImage2D)
+THIN_GL_FUNCTION(glCompressedTexSubImage3D)
+THIN_GL_FUNCTION(glCopyBufferSubData)
+THIN_GL_FUNCTION(glCopyPixels)
+THIN_GL_FUNCTION(glCopyTexImage1D)
+THIN_GL_FUNCTION(glCopyTexImage2D)
+THIN_GL_FUNCTION(glCopyTexSubImage1D)
+THIN_GL_FUNCTION(glCopyTexSubImage2D)
+THIN_GL_FUNCTION(glCopyTexSubImage3D)
+THIN_GL_FUNCTION(glCreateCommandListsNV)
+THIN_GL_FUNCTION(glCreateProgram)
+THIN_GL_FUNCTION(glCreateShader)
+THIN_GL_FUNCTION(glCreateStatesNV)
+THIN_GL_FUNCTION(glCullFace)
+THIN_GL_FUNCTION(glDebugMessageCallback)
+THIN_GL_FUNCTION(glDebugMessageCallbackAMD)
+THIN_GL_FUNCTION(glDebugMessageCallbackARB)
+THIN_GL_FUNCTION(glDebugMessageCallbackKHR)
+THIN_GL_FUNCTION(glDebugMessageControl)
+THIN_GL_FUNCTION(glDebugMessageControlARB)
+THIN_GL_FUNCTION(glDebugMessageControlKHR)
+THIN_GL_FUNCTION(glDebugMessageEnableAMD)
+THIN_GL_FUNCTION(glDebugMessageInsert)
+THIN_GL_FUNCTION(glDebugMessageInsertAMD)
+THIN_GL_FUNCTION(glDebugMessageInsertARB)
+THIN_GL_FUNCTION(glDebugMessageInsertKHR)
+THIN_GL_FUNCTION(glDeleteBuffers)
+THIN_GL_FUNCTION(glDeleteCommandListsNV)
+THIN_GL_FUNCTION(glDeleteFramebuffers)
+THIN_GL_FUNCTION(glDeleteLists)
+THIN_GL_FUNCTION(glDeleteProgram)
+THIN_GL_FUNCTION(glDeleteQueries)
+THIN_GL_FUNCTION(glDeleteRenderbuffers)
+THIN_GL_FUNCTION(glDeleteSamplers)
+THIN_GL_FUNCTION(glDeleteShader)
+THIN_GL_FUNCTION(glDeleteStatesNV)
+THIN_GL_FUNCTION(glDeleteSync)
+THIN_GL_FUNCTION(glDeleteTextures)
+THIN_GL_FUNCTION(glDeleteTransformFeedbacks)
+THIN_GL_FUNCTION(glDeleteVertexArrays)
+THIN_GL_FUNCTION(glDepthFunc)
+THIN_GL_FUNCTION(glDepthMask)
+THIN_GL_FUNCTION(glDepthRange)
+THIN_GL_FUNCTION(glDetachShader)
+THIN_GL_FUNCTION(glDisable)
+THIN_GL_FUNCTION(glDisableClientState)
+THIN_GL_FUNCTION(glDisableVertexAttribArray)
+THIN_GL_FUNCTION(glDisablei)
+THIN_GL_FUNCTION(glDrawArrays)
+THIN_GL_FUNCTION(glDrawArraysIndirect)
+THIN_GL_FUNCTION(glDrawArraysInstanced)
+THIN_GL_FUNCTION(glDrawBuffer)
+THIN_GL_FUNCTION(glDrawBuffers)
+THIN_GL_FUNCTION(glDrawCommandsAddressNV)
+THIN_GL_FUNCTION(glDrawCommandsNV)
+THIN_GL_FUNCTION(glDrawCommandsStatesAddressNV)
+THIN_GL_FUNCTION(glDrawCommandsStatesNV)
+THIN_GL_FUNCTION(glDrawElements)
+THIN_GL_FUNCTION(glDrawElementsBaseVertex)
+THIN_GL_FUNCTION(glDrawElementsIndirect)
+THIN_GL_FUNCTION(glDrawElementsInstanced)
+THIN_GL_FUNCTION(glDrawElementsInstancedBaseVertex)
+THIN_GL_FUNCTION(glDrawPixels)
+THIN_GL_FUNCTION(glDrawRangeElements)
+THIN_GL_FUNCTION(glDrawRangeElementsBaseVertex)
+THIN_GL_FUNCTION(glDrawTransformFeedback)
+THIN_GL_FUNCTION(glDrawTransformFeedbackStream)
+THIN_GL_FUNCTION(glEdgeFlag)
+THIN_GL_FUNCTION(glEdgeFlagPointer)
+THIN_GL_FUNCTION(glEdgeFlagv)
+THIN_GL_FUNCTION(glEnable)
+THIN_GL_FUNCTION(glEnableClientState)
+THIN_GL_FUNCTION(glEnableVertexAttribArray)
+THIN_GL_FUNCTION(glEnablei)
+THIN_GL_FUNCTION(glEnd)
+THIN_GL_FUNCTION(glEndConditionalRender)
+THIN_GL_FUNCTION(glEndList)
+THIN_GL_FUNCTION(glEndQuery)
+THIN_GL_FUNCTION(glEndQueryIndexed)
+THIN_GL_FUNCTION(glEndTransformFeedback)
+THIN_GL_FUNCTION(glEvalCoord1d)
+THIN_GL_FUNCTION(glEvalCoord1dv)
+THIN_GL_FUNCTION(glEvalCoord1f)
+THIN_GL_FUNCTION(glEvalCoord1fv)
+THIN_GL_FUNCTION(glEvalCoord2d)
+THIN_GL_FUNCTION(glEvalCoord2dv)
+THIN_GL_FUNCTION(glEvalCoord2f)
+THIN_GL_FUNCTION(glEvalCoord2fv)
+THIN_GL_FUNCTION(glEvalMesh1)
+THIN_GL_FUNCTION(glEvalMesh2)
+THIN_GL_FUNCTION(glEvalPoint1)
+THIN_GL_FUNCTION(glEvalPoint2)
+THIN_GL_FUNCTION(glFeedbackBuffer)
+THIN_GL_FUNCTION(glFenceSync)
+THIN_GL_FUNCTION(glFinish)
+THIN_GL_FUNCTION(glFlush)
+THIN_GL_FUNCTION(glFlushMappedBufferRange)
+THIN_GL_FUNCTION(glFogCoordPointer)
+THIN_GL_FUNCTION(glFogCoordd)
+THIN_GL_FUNCTION(glFogCoorddv)
+THIN_GL_FUNCTION(glFogCoordf)
+THIN_GL_FUNCTION(glFogCoordfv)
+THIN_GL_FUNCTION(glFogf)
+THIN_GL_FUNCTION(glFogfv)
+THIN_GL_FUNCTION(glFogi)
+THIN_GL_FUNCTION(glFogiv)
+THIN_GL_FUNCTION(glFramebufferRenderbuffer)
+THIN_GL_FUNCTION(glFramebufferTexture)
+THIN_GL_FUNCTION(glFramebufferTexture1D)
+THIN_GL_FUNCTION(glFramebufferTexture2D)
+THIN_GL_FUNCTION(glFramebufferTexture3D)
+THIN_GL_FUNCTION(glFramebufferTextureLayer)
+THIN_GL_FUNCTION(glFrontFace)
+THIN_GL_FUNCTION(glFrustum)
+THIN_GL_FUNCTION(glGenBuffers)
+THIN_GL_FUNCTION(glGenFramebuffers)
+THIN_GL_FUNCTION(glGenLists)
+THIN_GL_FUNCTION(glGenQueries)
+THIN_GL_FUNCTION(glGenRenderbuffers)
+THIN_GL_FUNCTION(glGenSamplers)
+THIN_GL_FUNCTION(glGenTextures)
+THIN_GL_FUNCTION(glGenTransformFeedbacks)
+THIN_GL_FUNCTION(glGenVertexArrays)
+THIN_GL_FUNCTION(glGenerateMipmap)
+THIN_GL_FUNCTION(glGetActiveAttrib)
+THIN_GL_FUNCTION(glGetActiveSubroutineName)
+THIN_GL_FUNCTION(glGetActiveSubroutineUniformName)
+THIN_GL_FUNCTION(glGetActiveSubroutineUniformiv)
+THIN_GL_FUNCTION(glGetActiveUniform)
+THIN_GL_FUNCTION(glGetActiveUniformBlockName)
+THIN_GL_FUNCTION(glGetActiveUniformBlockiv)
+THIN_GL_FUNCTION(glGetActiveUniformName)
+THIN_GL_FUNCTION(glGetActiveUniformsiv)
+THIN_GL_FUNCTION(glGetAttachedShaders)
+THIN_GL_FUNCTION(glGetAttribLocation)
+THIN_GL_FUNCTION(glGetBooleani_v)
+THIN_GL_FUNCTION(glGetBooleanv)
+THIN_GL_FUNCTION(glGetBufferParameteri64v)
+THIN_GL_FUNCTION(glGetBufferParameteriv)
+THIN_GL_FUNCTION(glGetBufferPointerv)
+THIN_GL_FUNCTION(glGetBufferSubData)
+THIN_GL_FUNCTION(glGetClipPlane)
+THIN_GL_FUNCTION(glGetCommandHeaderNV)
+THIN_GL_FUNCTION(glGetCompressedTexImage)
+THIN_GL_FUNCTION(glGetDebugMessageLog)
+THIN_GL_FUNCTION(glGetDebugMessageLogAMD)
+THIN_GL_FUNCTION(glGetDebugMessageLogARB)
+THIN_GL_FUNCTION(glGetDebugMessageLogKHR)
+THIN_GL_FUNCTION(glGetDoublev)
+THIN_GL_FUNCTION(glGetError)
+THIN_GL_FUNCTION(glGetFloatv)
+THIN_GL_FUNCTION(glGetFragDataIndex)
+THIN_GL_FUNCTION(glGetFragDataLocation)
+THIN_GL_FUNCTION(glGetFramebufferAttachmentParameteriv)
+THIN_GL_FUNCTION(glGetImageHandleNV)
+THIN_GL_FUNCTION(glGetInteger64i_v)
+THIN_GL_FUNCTION(glGetInteger64v)
+THIN_GL_FUNCTION(glGetIntegeri_v)
+THIN_GL_FUNCTION(glGetIntegerv)
+THIN_GL_FUNCTION(glGetLightfv)
+THIN_GL_FUNCTION(glGetLightiv)
+THIN_GL_FUNCTION(glGetMapdv)
+THIN_GL_FUNCTION(glGetMapfv)
+THIN_GL_FUNCTION(glGetMapiv)
+THIN_GL_FUNCTION(glGetMaterialfv)
+THIN_GL_FUNCTION(glGetMaterialiv)
+THIN_GL_FUNCTION(glGetMultisamplefv)
+THIN_GL_FUNCTION(glGetObjectLabel)
+THIN_GL_FUNCTION(glGetObjectLabelEXT)
+THIN_GL_FUNCTION(glGetObjectLabelKHR)
+THIN_GL_FUNCTION(glGetObjectPtrLabel)
+THIN_GL_FUNCTION(glGetObjectPtrLabelKHR)
+THIN_GL_FUNCTION(glGetPixelMapfv)
+THIN_GL_FUNCTION(glGetPixelMapuiv)
+THIN_GL_FUNCTION(glGetPixelMapusv)
+THIN_GL_FUNCTION(glGetPointerv)
+THIN_GL_FUNCTION(glGetPointervKHR)
+THIN_GL_FUNCTION(glGetPolygonStipple)
+THIN_GL_FUNCTION(glGetProgramInfoLog)
+THIN_GL_FUNCTION(glGetProgramStageiv)
+THIN_GL_FUNCTION(glGetProgramiv)
+THIN_GL_FUNCTION(glGetQueryIndexediv)
+THIN_GL_FUNCTION(glGetQueryObjecti64v)
+THIN_GL_FUNCTION(glGetQueryObjectiv)
+THIN_GL_FUNCTION(glGetQueryObjectui64v)
+THIN_GL_FUNCTION(glGetQueryObjectuiv)
+THIN_GL_FUNCTION(glGetQueryiv)
+THIN_GL_FUNCTION(glGetRenderbufferParameteriv)
+THIN_GL_FUNCTION(glGetSamplerParameterIiv)
+THIN_GL_FUNCTION(glGetSamplerParameterIuiv)
+THIN_GL_FUNCTION(glGetSamplerParameterfv)
+THIN_GL_FUNCTION(glGetSamplerParameteriv)
+THIN_GL_FUNCTION(glGetShaderInfoLog)
+THIN_GL_FUNCTION(glGetShaderSource)
+THIN_GL_FUNCTION(glGetShaderiv)
+THIN_GL_FUNCTION(glGetStageIndexNV)
+THIN_GL_FUNCTION(glGetString)
+THIN_GL_FUNCTION(glGetStringi)
+THIN_GL_FUNCTION(glGetSubroutineIndex)
+THIN_GL_FUNCTION(glGetSubroutineUniformLocation)
+THIN_GL_FUNCTION(glGetSynciv)
+THIN_GL_FUNCTION(glGetTexEnvfv)
+THIN_GL_FUNCTION(glGetTexEnviv)
+THIN_GL_FUNCTION(glGetTexGendv)
+THIN_GL_FUNCTION(glGetTexGenfv)
+THIN_GL_FUNCTION(glGetTexGeniv)
+THIN_GL_FUNCTION(glGetTexImage)
+THIN_GL_FUNCTION(glGetTexLevelParameterfv)
+THIN_GL_FUNCTION(glGetTexLevelParameteriv)
+THIN_GL_FUNCTION(glGetTexParameterIiv)
+THIN_GL_FUNCTION(glGetTexParameterIuiv)
+THIN_GL_FUNCTION(glGetTexParameterfv)
+THIN_GL_FUNCTION(glGetTexParameteriv)
+THIN_GL_FUNCTION(glGetTextureHandleNV)
+THIN_GL_FUNCTION(glGetTextureSamplerHandleNV)
+THIN_GL_FUNCTION(glGetTransformFeedbackVarying)
+THIN_GL_FUNCTION(glGetUniformBlockIndex)
+THIN_GL_FUNCTION(glGetUniformIndices)
+THIN_GL_FUNCTION(glGetUniformLocation)
+THIN_GL_FUNCTION(glGetUniformSubroutineuiv)
+THIN_GL_FUNCTION(glGetUniformdv)
+THIN_GL_FUNCTION(glGetUniformfv)
+THIN_GL_FUNCTION(glGetUniformiv)
+THIN_GL_FUNCTION(glGetUniformuiv)
+THIN_GL_FUNCTION(glGetVertexAttribIiv)
+THIN_GL_FUNCTION(glGetVertexAttribIuiv)
+THIN_GL_FUNCTION(glGetVertexAttribPointerv)
+THIN_GL_FUNCTION(glGetVertexAttribdv)
+THIN_GL_FUNCTION(glGetVertexAttribfv)
+THIN_GL_FUNCTION(glGetVertexAttribiv)
+THIN_GL_FUNCTION(glHint)
+THIN_GL_FUNCTION(glIndexMask)
+THIN_GL_FUNCTION(glIndexPointer)
+THIN_GL_FUNCTION(glIndexd)
+THIN_GL_FUNCTION(glIndexdv)
+THIN_GL_FUNCTION(glIndexf)
+THIN_GL_FUNCTION(glIndexfv)
+THIN_GL_FUNCTION(glIndexi)
+THIN_GL_FUNCTION(glIndexiv)
+THIN_GL_FUNCTION(glIndexs)
+THIN_GL_FUNCTION(glIndexsv)
+THIN_GL_FUNCTION(glIndexub)
+THIN_GL_FUNCTION(glIndexubv)
+THIN_GL_FUNCTION(glInitNames)
+THIN_GL_FUNCTION(glInsertEventMarkerEXT)
+THIN_GL_FUNCTION(glInterleavedArrays)
+THIN_GL_FUNCTION(glIsBuffer)
+THIN_GL_FUNCTION(glIsCommandListNV)
+THIN_GL_FUNCTION(glIsEnabled)
+THIN_GL_FUNCTION(glIsEnabledi)
+THIN_GL_FUNCTION(glIsFramebuffer)
+THIN_GL_FUNCTION(glIsImageHandleResidentNV)
+THIN_GL_FUNCTION(glIsList)
+THIN_GL_FUNCTION(glIsProgram)
+THIN_GL_FUNCTION(glIsQuery)
+THIN_GL_FUNCTION(glIsRenderbuffer)
+THIN_GL_FUNCTION(glIsSampler)
+THIN_GL_FUNCTION(glIsShader)
+THIN_GL_FUNCTION(glIsStateNV)
+THIN_GL_FUNCTION(glIsSync)
+THIN_GL_FUNCTION(glIsTexture)
+THIN_GL_FUNCTION(glIsTextureHandleResidentNV)
+THIN_GL_FUNCTION(glIsTransformFeedback)
+THIN_GL_FUNCTION(glIsVertexArray)
+THIN_GL_FUNCTION(glLabelObjectEXT)
+THIN_GL_FUNCTION(glLightModelf)
+THIN_GL_FUNCTION(glLightModelfv)
+THIN_GL_FUNCTION(glLightModeli)
+THIN_GL_FUNCTION(glLightModeliv)
+THIN_GL_FUNCTION(glLightf)
+THIN_GL_FUNCTION(glLightfv)
+THIN_GL_FUNCTION(glLighti)
+THIN_GL_FUNCTION(glLightiv)
+THIN_GL_FUNCTION(glLineStipple)
+THIN_GL_FUNCTION(glLineWidth)
+THIN_GL_FUNCTION(glLinkProgram)
+THIN_GL_FUNCTION(glListBase)
+THIN_GL_FUNCTION(glListDrawCommandsStatesClientNV)
+THIN_GL_FUNCTION(glLoadIdentity)
+THIN_GL_FUNCTION(glLoadMatrixd)
+THIN_GL_FUNCTION(glLoadMatrixf)
+THIN_GL_FUNCTION(glLoadName)
+THIN_GL_FUNCTION(glLoadTransposeMatrixd)
+THIN_GL_FUNCTION(glLoadTransposeMatrixf)
+THIN_GL_FUNCTION(glLogicOp)
+THIN_GL_FUNCTION(glMakeImageHandleNonResidentNV)
+THIN_GL_FUNCTION(glMakeImageHandleResidentNV)
+THIN_GL_FUNCTION(glMakeTextureHandleNonResidentNV)
+THIN_GL_FUNCTION(glMakeTextureHandleResidentNV)
+THIN_GL_FUNCTION(glMap1d)
+THIN_GL_FUNCTION(glMap1f)
+THIN_GL_FUNCTION(glMap2d)
+THIN_GL_FUNCTION(glMap2f)
+THIN_GL_FUNCTION(glMapBuffer)
+THIN_GL_FUNCTION(glMapBufferRange)
+THIN_GL_FUNCTION(glMapGrid1d)
+THIN_GL_FUNCTION(glMapGrid1f)
+THIN_GL_FUNCTION(glMapGrid2d)
+THIN_GL_FUNCTION(glMapGrid2f)
+THIN_GL_FUNCTION(glMaterialf)
+THIN_GL_FUNCTION(glMaterialfv)
+THIN_GL_FUNCTION(glMateriali)
+THIN_GL_FUNCTION(glMaterialiv)
+THIN_GL_FUNCTION(glMatrixMode)
+THIN_GL_FUNCTION(glMinSampleShading)
+THIN_GL_FUNCTION(glMultMatrixd)
+THIN_GL_FUNCTION(glMultMatrixf)
+THIN_GL_FUNCTION(glMultTransposeMatrixd)
+THIN_GL_FUNCTION(glMultTransposeMatrixf)
+THIN_GL_FUNCTION(glMultiDrawArrays)
+THIN_GL_FUNCTION(glMultiDrawElements)
+THIN_GL_FUNCTION(glMultiDrawElementsBaseVertex)
+THIN_GL_FUNCTION(glMultiTexCoord1d)
+THIN_GL_FUNCTION(glMultiTexCoord1dv)
+THIN_GL_FUNCTION(glMultiTexCoord1f)
+THIN_GL_FUNCTION(glMultiTexCoord1fv)
+THIN_GL_FUNCTION(glMultiTexCoord1i)
+THIN_GL_FUNCTION(glMultiTexCoord1iv)
+THIN_GL_FUNCTION(glMultiTexCoord1s)
+THIN_GL_FUNCTION(glMultiTexCoord1sv)
+THIN_GL_FUNCTION(glMultiTexCoord2d)
+THIN_GL_FUNCTION(glMultiTexCoord2dv)
+THIN_GL_FUNCTION(glMultiTexCoord2f)
+THIN_GL_FUNCTION(glMultiTexCoord2fv)
+THIN_GL_FUNCTION(glMultiTexCoord2i)
+THIN_GL_FUNCTION(glMultiTexCoord2iv)
+THIN_GL_FUNCTION(glMultiTexCoord2s)
+THIN_GL_FUNCTION(glMultiTexCoord2sv)
+THIN_GL_FUNCTION(glMultiTexCoord3d)
+THIN_GL_FUNCTION(glMultiTexCoord3dv)
+THIN_GL_FUNCTION(glMultiTexCoord3f)
+THIN_GL_FUNCTION(glMultiTexCoord3fv)
+THIN_GL_FUNCTION(glMultiTexCoord3i)
+THIN_GL_FUNCTION(glMultiTexCoord3iv)
+THIN_GL_FUNCTION(glMultiTexCoord3s)
+THIN_GL_FUNCTION(glMultiTexCoord3sv)
+THIN_GL_FUNCTION(glMultiTexCoord4d)
+THIN_GL_FUNCTION(glMultiTexCoord4dv)
+THIN_GL_FUNCTION(glMultiTexCoord4f)
+THIN_GL_FUNCTION(glMultiTexCoord4fv)
+THIN_GL_FUNCTION(glMultiTexCoord4i)
+THIN_GL_FUNCTION(glMultiTexCoord4iv)
+THIN_GL_FUNCTION(glMultiTexCoord4s)
+THIN_GL_FUNCTION(glMultiTexCoord4sv)
+THIN_GL_FUNCTION(glMultiTexCoordP1ui)
+THIN_GL_FUNCTION(glMultiTexCoordP1uiv)
+THIN_GL_FUNCTION(glMultiTexCoordP2ui)
+THIN_GL_FUNCTION(glMultiTexCoordP2uiv)
+THIN_GL_FUNCTION(glMultiTexCoordP3ui)
+THIN_GL_FUNCTION(glMultiTexCoordP3uiv)
+THIN_GL_FUNCTION(glMultiTexCoordP4ui)
+THIN_GL_FUNCTION(glMultiTexCoordP4uiv)
+THIN_GL_FUNCTION(glNewList)
+THIN_GL_FUNCTION(glNormal3b)
+THIN_GL_FUNCTION(glNormal3bv)
+THIN_GL_FUNCTION(glNormal3d)
+THIN_GL_FUNCTION(glNormal3dv)
+THIN_GL_FUNCTION(glNormal3f)
+THIN_GL_FUNCTION(glNormal3fv)
+THIN_GL_FUNCTION(glNormal3i)
+THIN_GL_FUNCTION(glNormal3iv)
+THIN_GL_FUNCTION(glNormal3s)
+THIN_GL_FUNCTION(glNormal3sv)
+THIN_GL_FUNCTION(glNormalP3ui)
+THIN_GL_FUNCTION(glNormalP3uiv)
+THIN_GL_FUNCTION(glNormalPointer)
+THIN_GL_FUNCTION(glObjectLabel)
+THIN_GL_FUNCTION(glObjectLabelKHR)
+THIN_GL_FUNCTION(glObjectPtrLabel)
+THIN_GL_FUNCTION(glObjectPtrLabelKHR)
+THIN_GL_FUNCTION(glOrtho)
+THIN_GL_FUNCTION(glPassThrough)
+THIN_GL_FUNCTION(glPatchParameterfv)
+THIN_GL_FUNCTION(glPatchParameteri)
+THIN_GL_FUNCTION(glPauseTransformFeedback)
+THIN_GL_FUNCTION(glPixelMapfv)
+THIN_GL_FUNCTION(glPixelMapuiv)
+THIN_GL_FUNCTION(glPixelMapusv)
+THIN_GL_FUNCTION(glPixelStoref)
+THIN_GL_FUNCTION(glPixelStorei)
+THIN_GL_FUNCTION(glPixelTransferf)
+THIN_GL_FUNCTION(glPixelTransferi)
+THIN_GL_FUNCTION(glPixelZoom)
+THIN_GL_FUNCTION(glPointParameterf)
+THIN_GL_FUNCTION(glPointParameterfv)
+THIN_GL_FUNCTION(glPointParameteri)
+THIN_GL_FUNCTION(glPointParameteriv)
+THIN_GL_FUNCTION(glPointSize)
+THIN_GL_FUNCTION(glPolygonMode)
+THIN_GL_FUNCTION(glPolygonOffset)
+THIN_GL_FUNCTION(glPolygonStipple)
+THIN_GL_FUNCTION(glPopAttrib)
+THIN_GL_FUNCTION(glPopClientAttrib)
+THIN_GL_FUNCTION(glPopDebugGroup)
+THIN_GL_FUNCTION(glPopDebugGroupKHR)
+THIN_GL_FUNCTION(glPopGroupMarkerEXT)
+THIN_GL_FUNCTION(glPopMatrix)
+THIN_GL_FUNCTION(glPopName)
+THIN_GL_FUNCTION(glPrimitiveRestartIndex)
+THIN_GL_FUNCTION(glPrioritizeTextures)
+THIN_GL_FUNCTION(glProgramUniformHandleui64NV)
+THIN_GL_FUNCTION(glProgramUniformHandleui64vNV)
+THIN_GL_FUNCTION(glProvokingVertex)
+THIN_GL_FUNCTION(glPushAttrib)
+THIN_GL_FUNCTION(glPushClientAttrib)
+THIN_GL_FUNCTION(glPushDebugGroup)
+THIN_GL_FUNCTION(glPushDebugGroupKHR)
+THIN_GL_FUNCTION(glPushGroupMarkerEXT)
+THIN_GL_FUNCTION(glPushMatrix)
+THIN_GL_FUNCTION(glPushName)
+THIN_GL_FUNCTION(glQueryCounter)
+THIN_GL_FUNCTION(glRasterPos2d)
+THIN_GL_FUNCTION(glRasterPos2dv)
+THIN_GL_FUNCTION(glRasterPos2f)
+THIN_GL_FUNCTION(glRasterPos2fv)
+THIN_GL_FUNCTION(glRasterPos2i)
+THIN_GL_FUNCTION(glRasterPos2iv)
+THIN_GL_FUNCTION(glRasterPos2s)
+THIN_GL_FUNCTION(glRasterPos2sv)
+THIN_GL_FUNCTION(glRasterPos3d)
+THIN_GL_FUNCTION(glRasterPos3dv)
+THIN_GL_FUNCTION(glRasterPos3f)
+THIN_GL_FUNCTION(glRasterPos3fv)
+THIN_GL_FUNCTION(glRasterPos3i)
+THIN_GL_FUNCTION(glRasterPos3iv)
+THIN_GL_FUNCTION(glRasterPos3s)
+THIN_GL_FUNCTION(glRasterPos3sv)
+THIN_GL_FUNCTION(glRasterPos4d)
+THIN_GL_FUNCTION(glRasterPos4dv)
+THIN_GL_FUNCTION(glRasterPos4f)
+THIN_GL_FUNCTION(glRasterPos4fv)
+THIN_GL_FUNCTION(glRasterPos4i)
+THIN_GL_FUNCTION(glRasterPos4iv)
+THIN_GL_FUNCTION(glRasterPos4s)
+THIN_GL_FUNCTION(glRasterPos4sv)
+THIN_GL_FUNCTION(glReadBuffer)
+THIN_GL_FUNCTION(glReadPixels)
+THIN_GL_FUNCTION(glRectd)
+THIN_GL_FUNCTION(glRectdv)
+THIN_GL_FUNCTION(glRectf)
+THIN_GL_FUNCTION(glRectfv)
+THIN_GL_FUNCTION(glRecti)
+THIN_GL_FUNCTION(glRectiv)
+THIN_GL_FUNCTION(glRects)
+THIN_GL_FUNCTION(glRectsv)
+THIN_GL_FUNCTION(glRenderMode)
+THIN_GL_FUNCTION(glRenderbufferStorage)
+THIN_GL_FUNCTION(glRenderbufferStorageMultisample)
+THIN_GL_FUNCTION(glResumeTransformFeedback)
+THIN_GL_FUNCTION(glRotated)
+THIN_GL_FUNCTION(glRotatef)
+THIN_GL_FUNCTION(glSampleCoverage)
+THIN_GL_FUNCTION(glSampleMaski)
+THIN_GL_FUNCTION(glSamplerParameterIiv)
+THIN_GL_FUNCTION(glSamplerParameterIuiv)
+THIN_GL_FUNCTION(glSamplerParameterf)
+THIN_GL_FUNCTION(glSamplerParameterfv)
+THIN_GL_FUNCTION(glSamplerParameteri)
+THIN_GL_FUNCTION(glSamplerParameteriv)
+THIN_GL_FUNCTION(glScaled)
+THIN_GL_FUNCTION(glScalef)
+THIN_GL_FUNCTION(glScissor)
+THIN_GL_FUNCTION(glSecondaryColor3b)
+THIN_GL_FUNCTION(glSecondaryColor3bv)
+THIN_GL_FUNCTION(glSecondaryColor3d)
+THIN_GL_FUNCTION(glSecondaryColor3dv)
+THIN_GL_FUNCTION(glSecondaryColor3f)
+THIN_GL_FUNCTION(glSecondaryColor3fv)
+THIN_GL_FUNCTION(glSecondaryColor3i)
+THIN_GL_FUNCTION(glSecondaryColor3iv)
+THIN_GL_FUNCTION(glSecondaryColor3s)
+THIN_GL_FUNCTION(glSecondaryColor3sv)
+THIN_GL_FUNCTION(glSecondaryColor3ub)
+THIN_GL_FUNCTION(glSecondaryColor3ubv)
+THIN_GL_FUNCTION(glSecondaryColor3ui)
+THIN_GL_FUNCTION(glSecondaryColor3uiv)
+THIN_GL_FUNCTION(glSecondaryColor3us)
+THIN_GL_FUNCTION(glSecondaryColor3usv)
+THIN_GL_FUNCTION(glSecondaryColorP3ui)
+THIN_GL_FUNCTION(glSecondaryColorP3uiv)
+THIN_GL_FUNCTION(glSecondaryColorPointer)
+THIN_GL_FUNCTION(glSelectBuffer)
+THIN_GL_FUNCTION(glShadeModel)
+THIN_GL_FUNCTION(glShaderSource)
+THIN_GL_FUNCTION(glStateCaptureNV)
+THIN_GL_FUNCTION(glStencilFunc)
+THIN_GL_FUNCTION(glStencilFuncSeparate)
+THIN_GL_FUNCTION(glStencilMask)
+THIN_GL_FUNCTION(glStencilMaskSeparate)
+THIN_GL_FUNCTION(glStencilOp)
+THIN_GL_FUNCTION(glStencilOpSeparate)
+THIN_GL_FUNCTION(glTexBuffer)
+THIN_GL_FUNCTION(glTexCoord1d)
+THIN_GL_FUNCTION(glTexCoord1dv)
+THIN_GL_FUNCTION(glTexCoord1f)
+THIN_GL_FUNCTION(glTexCoord1fv)
+THIN_GL_FUNCTION(glTexCoord1i)
+THIN_GL_FUNCTION(glTexCoord1iv)
+THIN_GL_FUNCTION(glTexCoord1s)
+THIN_GL_FUNCTION(glTexCoord1sv)
+THIN_GL_FUNCTION(glTexCoord2d)
+THIN_GL_FUNCTION(glTexCoord2dv)
+THIN_GL_FUNCTION(glTexCoord2f)
+THIN_GL_FUNCTION(glTexCoord2fv)
+THIN_GL_FUNCTION(glTexCoord2i)
+THIN_GL_FUNCTION(glTexCoord2iv)
+THIN_GL_FUNCTION(glTexCoord2s)
+THIN_GL_FUNCTION(glTexCoord2sv)
+THIN_GL_FUNCTION(glTexCoord3d)
+THIN_GL_FUNCTION(glTexCoord3dv)
+THIN_GL_FUNCTION(glTexCoord3f)
+THIN_GL_FUNCTION(glTexCoord3fv)
+THIN_GL_FUNCTION(glTexCoord3i)
+THIN_GL_FUNCTION(glTexCoord3iv)
+THIN_GL_FUNCTION(glTexCoord3s)
+THIN_GL_FUNCTION(glTexCoord3sv)
+THIN_GL_FUNCTION(glTexCoord4d)
+THIN_GL_FUNCTION(glTexCoord4dv)
+THIN_GL_FUNCTION(glTexCoord4f)
+THIN_GL_FUNCTION(glTexCoord4fv)
+THIN_GL_FUNCTION(glTexCoord4i)
+THIN_GL_FUNCTION(glTexCoord4iv)
+THIN_GL_FUNCTION(glTexCoord4s)
+THIN_GL_FUNCTION(glTexCoord4sv)
+THIN_GL_FUNCTION(glTexCoordP1ui)
+THIN_GL_FUNCTION(glTexCoordP1uiv)
+THIN_GL_FUNCTION(glTexCoordP2ui)
+THIN_GL_FUNCTION(glTexCoordP2uiv)
+THIN_GL_FUNCTION(glTexCoordP3ui)
+THIN_GL_FUNCTION(glTexCoordP3uiv)
+THIN_GL_FUNCTION(glTexCoordP4ui)
+THIN_GL_FUNCTION(glTexCoordP4uiv)
+THIN_GL_FUNCTION(glTexCoordPointer)
+THIN_GL_FUNCTION(glTexEnvf)
+THIN_GL_FUNCTION(glTexEnvfv)
+THIN_GL_FUNCTION(glTexEnvi)
+THIN_GL_FUNCTION(glTexEnviv)
+THIN_GL_FUNCTION(glTexGend)
+THIN_GL_FUNCTION(glTexGendv)
+THIN_GL_FUNCTION(glTexGenf)
+THIN_GL_FUNCTION(glTexGenfv)
+THIN_GL_FUNCTION(glTexGeni)
+THIN_GL_FUNCTION(glTexGeniv)
+THIN_GL_FUNCTION(glTexImage1D)
+THIN_GL_FUNCTION(glTexImage2D)
+THIN_GL_FUNCTION(glTexImage2DMultisample)
+THIN_GL_FUNCTION(glTexImage3D)
+THIN_GL_FUNCTION(glTexImage3DMultisample)
+THIN_GL_FUNCTION(glTexParameterIiv)
+THIN_GL_FUNCTION(glTexParameterIuiv)
+THIN_GL_FUNCTION(glTexParameterf)
+THIN_GL_FUNCTION(glTexParameterfv)
+THIN_GL_FUNCTION(glTexParameteri)
+THIN_GL_FUNCTION(glTexParameteriv)
+THIN_GL_FUNCTION(glTexSubImage1D)
+THIN_GL_FUNCTION(glTexSubImage2D)
+THIN_GL_FUNCTION(glTexSubImage3D)
+THIN_GL_FUNCTION(glTransformFeedbackVaryings)
+THIN_GL_FUNCTION(glTranslated)
+THIN_GL_FUNCTION(glTranslatef)
+THIN_GL_FUNCTION(glUniform1d)
+THIN_GL_FUNCTION(glUniform1dv)
+THIN_GL_FUNCTION(glUniform1f)
+THIN_GL_FUNCTION(glUniform1fv)
+THIN_GL_FUNCTION(glUniform1i)
+THIN_GL_FUNCTION(glUniform1iv)
+THIN_GL_FUNCTION(glUniform1ui)
+THIN_GL_FUNCTION(glUniform1uiv)
+THIN_GL_FUNCTION(glUniform2d)
+THIN_GL_FUNCTION(glUniform2dv)
+THIN_GL_FUNCTION(glUniform2f)
+THIN_GL_FUNCTION(glUniform2fv)
+THIN_GL_FUNCTION(glUniform2i)
+THIN_GL_FUNCTION(glUniform2iv)
+THIN_GL_FUNCTION(glUniform2ui)
+THIN_GL_FUNCTION(glUniform2uiv)
+THIN_GL_FUNCTION(glUniform3d)
+THIN_GL_FUNCTION(glUniform3dv)
+THIN_GL_FUNCTION(glUniform3f)
+THIN_GL_FUNCTION(glUniform3fv)
+THIN_GL_FUNCTION(glUniform3i)
+THIN_GL_FUNCTION(glUniform3iv)
+THIN_GL_FUNCTION(glUniform3ui)
+THIN_GL_FUNCTION(glUniform3uiv)
+THIN_GL_FUNCTION(glUniform4d)
+THIN_GL_FUNCTION(glUniform4dv)
+THIN_GL_FUNCTION(glUniform4f)
+THIN_GL_FUNCTION(glUniform4fv)
+THIN_GL_FUNCTION(glUniform4i)
+THIN_GL_FUNCTION(glUniform4iv)
+THIN_GL_FUNCTION(glUniform4ui)
+THIN_GL_FUNCTION(glUniform4uiv)
+THIN_GL_FUNCTION(glUniformBlockBinding)
+THIN_GL_FUNCTION(glUniformHandleui64NV)
+THIN_GL_FUNCTION(glUniformHandleui64vNV)
+THIN_GL_FUNCTION(glUniformMatrix2dv)
+THIN_GL_FUNCTION(glUniformMatrix2fv)
+THIN_GL_FUNCTION(glUniformMatrix2x3dv)
+THIN_GL_FUNCTION(glUniformMatrix2x3fv)
+THIN_GL_FUNCTION(glUniformMatrix2x4dv)
+THIN_GL_FUNCTION(glUniformMatrix2x4fv)
+THIN_GL_FUNCTION(glUniformMatrix3dv)
+THIN_GL_FUNCTION(glUniformMatrix3fv)
+THIN_GL_FUNCTION(glUniformMatrix3x2dv)
+THIN_GL_FUNCTION(glUniformMatrix3x2fv)
+THIN_GL_FUNCTION(glUniformMatrix3x4dv)
+THIN_GL_FUNCTION(glUniformMatrix3x4fv)
+THIN_GL_FUNCTION(glUniformMatrix4dv)
+THIN_GL_FUNCTION(glUniformMatrix4fv)
+THIN_GL_FUNCTION(glUniformMatrix4x2dv)
+THIN_GL_FUNCTION(glUniformMatrix4x2fv)
+THIN_GL_FUNCTION(glUniformMatrix4x3dv)
+THIN_GL_FUNCTION(glUniformMatrix4x3fv)
+THIN_GL_FUNCTION(glUniformSubroutinesuiv)
+THIN_GL_FUNCTION(glUnmapBuffer)
+THIN_GL_FUNCTION(glUseProgram)
+THIN_GL_FUNCTION(glValidateProgram)
+THIN_GL_FUNCTION(glVertex2d)
+THIN_GL_FUNCTION(glVertex2dv)
+THIN_GL_FUNCTION(glVertex2f)
+THIN_GL_FUNCTION(glVertex2fv)
+THIN_GL_FUNCTION(glVertex2i)
+THIN_GL_FUNCTION(glVertex2iv)
+THIN_GL_FUNCTION(glVertex2s)
+THIN_GL_FUNCTION(glVertex2sv)
+THIN_GL_FUNCTION(glVertex3d)
+THIN_GL_FUNCTION(glVertex3dv)
+THIN_GL_FUNCTION(glVertex3f)
+THIN_GL_FUNCTION(glVertex3fv)
+THIN_GL_FUNCTION(glVertex3i)
+THIN_GL_FUNCTION(glVertex3iv)
+THIN_GL_FUNCTION(glVertex3s)
+THIN_GL_FUNCTION(glVertex3sv)
+THIN_GL_FUNCTION(glVertex4d)
+THIN_GL_FUNCTION(glVertex4dv)
+THIN_GL_FUNCTION(glVertex4f)
+THIN_GL_FUNCTION(glVertex4fv)
+THIN_GL_FUNCTION(glVertex4i)
+THIN_GL_FUNCTION(glVertex4iv)
+THIN_GL_FUNCTION(glVertex4s)
+THIN_GL_FUNCTION(glVertex4sv)
+THIN_GL_FUNCTION(glVertexAttrib1d)
+THIN_GL_FUNCTION(glVertexAttrib1dv)
+THIN_GL_FUNCTION(glVertexAttrib1f)
+THIN_GL_FUNCTION(glVertexAttrib1fv)
+THIN_GL_FUNCTION(glVertexAttrib1s)
+THIN_GL_FUNCTION(glVertexAttrib1sv)
+THIN_GL_FUNCTION(glVertexAttrib2d)
+THIN_GL_FUNCTION(glVertexAttrib2dv)
+THIN_GL_FUNCTION(glVertexAttrib2f)
+THIN_GL_FUNCTION(glVertexAttrib2fv)
+THIN_GL_FUNCTION(glVertexAttrib2s)
+THIN_GL_FUNCTION(glVertexAttrib2sv)
+THIN_GL_FUNCTION(glVertexAttrib3d)
+THIN_GL_FUNCTION(glVertexAttrib3dv)
+THIN_GL_FUNCTION(glVertexAttrib3f)
+THIN_GL_FUNCTION(glVertexAttrib3fv)
+THIN_GL_FUNCTION(glVertexAttrib3s)
+THIN_GL_FUNCTION(glVertexAttrib3sv)
+THIN_GL_FUNCTION(glVertexAttrib4Nbv)
+THIN_GL_FUNCTION(glVertexAttrib4Niv)
+THIN_GL_FUNCTION(glVertexAttrib4Nsv)
+THIN_GL_FUNCTION(glVertexAttrib4Nub)
+THIN_GL_FUNCTION(glVertexAttrib4Nubv)
+THIN_GL_FUNCTION(glVertexAttrib4Nuiv)
+THIN_GL_FUNCTION(glVertexAttrib4Nusv)
+THIN_GL_FUNCTION(glVertexAttrib4bv)
+THIN_GL_FUNCTION(glVertexAttrib4d)
+THIN_GL_FUNCTION(glVertexAttrib4dv)
+THIN_GL_FUNCTION(glVertexAttrib4f)
+THIN_GL_FUNCTION(glVertexAttrib4fv)
+THIN_GL_FUNCTION(glVertexAttrib4iv)
+THIN_GL_FUNCTION(glVertexAttrib4s)
+THIN_GL_FUNCTION(glVertexAttrib4sv)
+THIN_GL_FUNCTION(glVertexAttrib4ubv)
+THIN_GL_FUNCTION(glVertexAttrib4uiv)
+THIN_GL_FUNCTION(glVertexAttrib4usv)
+THIN_GL_FUNCTION(glVertexAttribDivisor)
+THIN_GL_FUNCTION(glVertexAttribI1i)
+THIN_GL_FUNCTION(glVertexAttribI1iv)
+THIN_GL_FUNCTION(glVertexAttribI1ui)
+THIN_GL_FUNCTION(glVertexAttribI1uiv)
+THIN_GL_FUNCTION(glVertexAttribI2i)
+THIN_GL_FUNCTION(glVertexAttribI2iv)
+THIN_GL_FUNCTION(glVertexAttribI2ui)
+THIN_GL_FUNCTION(glVertexAttribI2uiv)
+THIN_GL_FUNCTION(glVertexAttribI3i)
+THIN_GL_FUNCTION(glVertexAttribI3iv)
+THIN_GL_FUNCTION(glVertexAttribI3ui)
+THIN_GL_FUNCTION(glVertexAttribI3uiv)
+THIN_GL_FUNCTION(glVertexAttribI4bv)
+THIN_GL_FUNCTION(glVertexAttribI4i)
+THIN_GL_FUNCTION(glVertexAttribI4iv)
+THIN_GL_FUNCTION(glVertexAttribI4sv)
+THIN_GL_FUNCTION(glVertexAttribI4ubv)
+THIN_GL_FUNCTION(glVertexAttribI4ui)
+THIN_GL_FUNCTION(glVertexAttribI4uiv)
+THIN_GL_FUNCTION(glVertexAttribI4usv)
+THIN_GL_FUNCTION(glVertexAttribIPointer)
+THIN_GL_FUNCTION(glVertexAttribP1ui)
+THIN_GL_FUNCTION(glVertexAttribP1uiv)
+THIN_GL_FUNCTION(glVertexAttribP2ui)
+THIN_GL_FUNCTION(glVertexAttribP2uiv)
+THIN_GL_FUNCTION(glVertexAttribP3ui)
+THIN_GL_FUNCTION(glVertexAttribP3uiv)
+THIN_GL_FUNCTION(glVertexAttribP4ui)
+THIN_GL_FUNCTION(glVertexAttribP4uiv)
+THIN_GL_FUNCTION(glVertexAttribPointer)
+THIN_GL_FUNCTION(glVertexP2ui)
+THIN_GL_FUNCTION(glVertexP2uiv)
+THIN_GL_FUNCTION(glVertexP3ui)
+THIN_GL_FUNCTION(glVertexP3uiv)
+THIN_GL_FUNCTION(glVertexP4ui)
+THIN_GL_FUNCTION(glVertexP4uiv)
+THIN_GL_FUNCTION(glVertexPointer)
+THIN_GL_FUNCTION(glViewport)
+THIN_GL_FUNCTION(glWaitSync)
+THIN_GL_FUNCTION(glWindowPos2d)
+THIN_GL_FUNCTION(glWindowPos2dv)
+THIN_GL_FUNCTION(glWindowPos2f)
+THIN_GL_FUNCTION(glWindowPos2fv)
+THIN_GL_FUNCTION(glWindowPos2i)
+THIN_GL_FUNCTION(glWindowPos2iv)
+THIN_GL_FUNCTION(glWindowPos2s)
+THIN_GL_FUNCTION(glWindowPos2sv)
+THIN_GL_FUNCTION(glWindowPos3d)
+THIN_GL_FUNCTION(glWindowPos3dv)
+THIN_GL_FUNCTION(glWindowPos3f)
+THIN_GL_FUNCTION(glWindowPos3fv)
+THIN_GL_FUNCTION(glWindowPos3i)
+THIN_GL_FUNCTION(glWindowPos3iv)
+THIN_GL_FUNCTION(glWindowPos3s)
+THIN_GL_FUNCTION(glWindowPos3sv)
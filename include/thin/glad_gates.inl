@@ -0,0 +1,852 @@
+/*
+  Which glad flag each entry point in glad_functions.inl hangs off, one
+  THIN_GL_GATE(name, flag, extension) per load, a name can appear more than
+  once. extension is 1 for extension groups, 0 for core versions. Lazy
+  loading uses it to leave out what gladLoadGL would have left null.
+
+  Generated from glad.c, regenerate with the loader:
+
+    awk '/^static void load_GL_/ { g = substr($3, 9, index($3, "(") - 9) }
+         /glad_gl.*load\("/ { match($0, /glad_gl[A-Za-z0-9_]+/);
+           printf "THIN_GL_GATE(%s, GLAD_GL_%s, %d)\n",
+                  substr($0, RSTART + 5, RLENGTH - 5), g, g !~ /^VERSION_/ }' glad.c | sort -u
+*/
+
+THIN_GL_GATE(glAccum, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glActiveTexture, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glAlphaFunc, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glAreTexturesResident, GLAD_GL_VERSION_1_1, 0)
+THIN_GL_GATE(glArrayElement, GLAD_GL_VERSION_1_1, 0)
+THIN_GL_GATE(glAttachShader, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glBegin, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glBeginConditionalRender, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glBeginQuery, GLAD_GL_VERSION_1_5, 0)
+THIN_GL_GATE(glBeginQueryIndexed, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glBeginTransformFeedback, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glBindAttribLocation, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glBindBuffer, GLAD_GL_VERSION_1_5, 0)
+THIN_GL_GATE(glBindBufferBase, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glBindBufferBase, GLAD_GL_VERSION_3_1, 0)
+THIN_GL_GATE(glBindBufferRange, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glBindBufferRange, GLAD_GL_VERSION_3_1, 0)
+THIN_GL_GATE(glBindFragDataLocation, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glBindFragDataLocationIndexed, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glBindFramebuffer, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glBindRenderbuffer, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glBindSampler, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glBindTexture, GLAD_GL_VERSION_1_1, 0)
+THIN_GL_GATE(glBindTransformFeedback, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glBindVertexArray, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glBitmap, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glBlendColor, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glBlendEquation, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glBlendEquationSeparate, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glBlendEquationSeparatei, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glBlendEquationi, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glBlendFunc, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glBlendFuncSeparate, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glBlendFuncSeparatei, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glBlendFunci, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glBlitFramebuffer, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glBufferData, GLAD_GL_VERSION_1_5, 0)
+THIN_GL_GATE(glBufferSubData, GLAD_GL_VERSION_1_5, 0)
+THIN_GL_GATE(glCallCommandListNV, GLAD_GL_NV_command_list, 1)
+THIN_GL_GATE(glCallList, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glCallLists, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glCheckFramebufferStatus, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glClampColor, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glClear, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glClearAccum, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glClearBufferfi, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glClearBufferfv, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glClearBufferiv, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glClearBufferuiv, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glClearColor, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glClearDepth, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glClearIndex, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glClearStencil, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glClientActiveTexture, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glClientWaitSync, GLAD_GL_VERSION_3_2, 0)
+THIN_GL_GATE(glClipPlane, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glColor3b, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glColor3bv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glColor3d, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glColor3dv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glColor3f, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glColor3fv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glColor3i, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glColor3iv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glColor3s, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glColor3sv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glColor3ub, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glColor3ubv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glColor3ui, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glColor3uiv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glColor3us, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glColor3usv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glColor4b, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glColor4bv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glColor4d, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glColor4dv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glColor4f, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glColor4fv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glColor4i, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glColor4iv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glColor4s, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glColor4sv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glColor4ub, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glColor4ubv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glColor4ui, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glColor4uiv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glColor4us, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glColor4usv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glColorMask, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glColorMaski, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glColorMaterial, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glColorP3ui, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glColorP3uiv, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glColorP4ui, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glColorP4uiv, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glColorPointer, GLAD_GL_VERSION_1_1, 0)
+THIN_GL_GATE(glCommandListSegmentsNV, GLAD_GL_NV_command_list, 1)
+THIN_GL_GATE(glCompileCommandListNV, GLAD_GL_NV_command_list, 1)
+THIN_GL_GATE(glCompileShader, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glCompressedTexImage1D, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glCompressedTexImage2D, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glCompressedTexImage3D, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glCompressedTexSubImage1D, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glCompressedTexSubImage2D, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glCompressedTexSubImage3D, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glCopyBufferSubData, GLAD_GL_VERSION_3_1, 0)
+THIN_GL_GATE(glCopyPixels, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glCopyTexImage1D, GLAD_GL_VERSION_1_1, 0)
+THIN_GL_GATE(glCopyTexImage2D, GLAD_GL_VERSION_1_1, 0)
+THIN_GL_GATE(glCopyTexSubImage1D, GLAD_GL_VERSION_1_1, 0)
+THIN_GL_GATE(glCopyTexSubImage2D, GLAD_GL_VERSION_1_1, 0)
+THIN_GL_GATE(glCopyTexSubImage3D, GLAD_GL_VERSION_1_2, 0)
+THIN_GL_GATE(glCreateCommandListsNV, GLAD_GL_NV_command_list, 1)
+THIN_GL_GATE(glCreateProgram, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glCreateShader, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glCreateStatesNV, GLAD_GL_NV_command_list, 1)
+THIN_GL_GATE(glCullFace, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glDebugMessageCallback, GLAD_GL_KHR_debug, 1)
+THIN_GL_GATE(glDebugMessageCallbackAMD, GLAD_GL_AMD_debug_output, 1)
+THIN_GL_GATE(glDebugMessageCallbackARB, GLAD_GL_ARB_debug_output, 1)
+THIN_GL_GATE(glDebugMessageCallbackKHR, GLAD_GL_KHR_debug, 1)
+THIN_GL_GATE(glDebugMessageControl, GLAD_GL_KHR_debug, 1)
+THIN_GL_GATE(glDebugMessageControlARB, GLAD_GL_ARB_debug_output, 1)
+THIN_GL_GATE(glDebugMessageControlKHR, GLAD_GL_KHR_debug, 1)
+THIN_GL_GATE(glDebugMessageEnableAMD, GLAD_GL_AMD_debug_output, 1)
+THIN_GL_GATE(glDebugMessageInsert, GLAD_GL_KHR_debug, 1)
+THIN_GL_GATE(glDebugMessageInsertAMD, GLAD_GL_AMD_debug_output, 1)
+THIN_GL_GATE(glDebugMessageInsertARB, GLAD_GL_ARB_debug_output, 1)
+THIN_GL_GATE(glDebugMessageInsertKHR, GLAD_GL_KHR_debug, 1)
+THIN_GL_GATE(glDeleteBuffers, GLAD_GL_VERSION_1_5, 0)
+THIN_GL_GATE(glDeleteCommandListsNV, GLAD_GL_NV_command_list, 1)
+THIN_GL_GATE(glDeleteFramebuffers, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glDeleteLists, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glDeleteProgram, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glDeleteQueries, GLAD_GL_VERSION_1_5, 0)
+THIN_GL_GATE(glDeleteRenderbuffers, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glDeleteSamplers, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glDeleteShader, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glDeleteStatesNV, GLAD_GL_NV_command_list, 1)
+THIN_GL_GATE(glDeleteSync, GLAD_GL_VERSION_3_2, 0)
+THIN_GL_GATE(glDeleteTextures, GLAD_GL_VERSION_1_1, 0)
+THIN_GL_GATE(glDeleteTransformFeedbacks, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glDeleteVertexArrays, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glDepthFunc, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glDepthMask, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glDepthRange, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glDetachShader, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glDisable, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glDisableClientState, GLAD_GL_VERSION_1_1, 0)
+THIN_GL_GATE(glDisableVertexAttribArray, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glDisablei, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glDrawArrays, GLAD_GL_VERSION_1_1, 0)
+THIN_GL_GATE(glDrawArraysIndirect, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glDrawArraysInstanced, GLAD_GL_VERSION_3_1, 0)
+THIN_GL_GATE(glDrawBuffer, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glDrawBuffers, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glDrawCommandsAddressNV, GLAD_GL_NV_command_list, 1)
+THIN_GL_GATE(glDrawCommandsNV, GLAD_GL_NV_command_list, 1)
+THIN_GL_GATE(glDrawCommandsStatesAddressNV, GLAD_GL_NV_command_list, 1)
+THIN_GL_GATE(glDrawCommandsStatesNV, GLAD_GL_NV_command_list, 1)
+THIN_GL_GATE(glDrawElements, GLAD_GL_VERSION_1_1, 0)
+THIN_GL_GATE(glDrawElementsBaseVertex, GLAD_GL_VERSION_3_2, 0)
+THIN_GL_GATE(glDrawElementsIndirect, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glDrawElementsInstanced, GLAD_GL_VERSION_3_1, 0)
+THIN_GL_GATE(glDrawElementsInstancedBaseVertex, GLAD_GL_VERSION_3_2, 0)
+THIN_GL_GATE(glDrawPixels, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glDrawRangeElements, GLAD_GL_VERSION_1_2, 0)
+THIN_GL_GATE(glDrawRangeElementsBaseVertex, GLAD_GL_VERSION_3_2, 0)
+THIN_GL_GATE(glDrawTransformFeedback, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glDrawTransformFeedbackStream, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glEdgeFlag, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glEdgeFlagPointer, GLAD_GL_VERSION_1_1, 0)
+THIN_GL_GATE(glEdgeFlagv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glEnable, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glEnableClientState, GLAD_GL_VERSION_1_1, 0)
+THIN_GL_GATE(glEnableVertexAttribArray, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glEnablei, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glEnd, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glEndConditionalRender, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glEndList, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glEndQuery, GLAD_GL_VERSION_1_5, 0)
+THIN_GL_GATE(glEndQueryIndexed, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glEndTransformFeedback, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glEvalCoord1d, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glEvalCoord1dv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glEvalCoord1f, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glEvalCoord1fv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glEvalCoord2d, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glEvalCoord2dv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glEvalCoord2f, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glEvalCoord2fv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glEvalMesh1, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glEvalMesh2, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glEvalPoint1, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glEvalPoint2, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glFeedbackBuffer, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glFenceSync, GLAD_GL_VERSION_3_2, 0)
+THIN_GL_GATE(glFinish, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glFlush, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glFlushMappedBufferRange, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glFogCoordPointer, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glFogCoordd, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glFogCoorddv, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glFogCoordf, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glFogCoordfv, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glFogf, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glFogfv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glFogi, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glFogiv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glFramebufferRenderbuffer, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glFramebufferTexture, GLAD_GL_VERSION_3_2, 0)
+THIN_GL_GATE(glFramebufferTexture1D, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glFramebufferTexture2D, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glFramebufferTexture3D, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glFramebufferTextureLayer, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glFrontFace, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glFrustum, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glGenBuffers, GLAD_GL_VERSION_1_5, 0)
+THIN_GL_GATE(glGenFramebuffers, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glGenLists, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glGenQueries, GLAD_GL_VERSION_1_5, 0)
+THIN_GL_GATE(glGenRenderbuffers, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glGenSamplers, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glGenTextures, GLAD_GL_VERSION_1_1, 0)
+THIN_GL_GATE(glGenTransformFeedbacks, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glGenVertexArrays, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glGenerateMipmap, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glGetActiveAttrib, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glGetActiveSubroutineName, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glGetActiveSubroutineUniformName, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glGetActiveSubroutineUniformiv, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glGetActiveUniform, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glGetActiveUniformBlockName, GLAD_GL_VERSION_3_1, 0)
+THIN_GL_GATE(glGetActiveUniformBlockiv, GLAD_GL_VERSION_3_1, 0)
+THIN_GL_GATE(glGetActiveUniformName, GLAD_GL_VERSION_3_1, 0)
+THIN_GL_GATE(glGetActiveUniformsiv, GLAD_GL_VERSION_3_1, 0)
+THIN_GL_GATE(glGetAttachedShaders, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glGetAttribLocation, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glGetBooleani_v, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glGetBooleanv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glGetBufferParameteri64v, GLAD_GL_VERSION_3_2, 0)
+THIN_GL_GATE(glGetBufferParameteriv, GLAD_GL_VERSION_1_5, 0)
+THIN_GL_GATE(glGetBufferPointerv, GLAD_GL_VERSION_1_5, 0)
+THIN_GL_GATE(glGetBufferSubData, GLAD_GL_VERSION_1_5, 0)
+THIN_GL_GATE(glGetClipPlane, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glGetCommandHeaderNV, GLAD_GL_NV_command_list, 1)
+THIN_GL_GATE(glGetCompressedTexImage, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glGetDebugMessageLog, GLAD_GL_KHR_debug, 1)
+THIN_GL_GATE(glGetDebugMessageLogAMD, GLAD_GL_AMD_debug_output, 1)
+THIN_GL_GATE(glGetDebugMessageLogARB, GLAD_GL_ARB_debug_output, 1)
+THIN_GL_GATE(glGetDebugMessageLogKHR, GLAD_GL_KHR_debug, 1)
+THIN_GL_GATE(glGetDoublev, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glGetError, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glGetFloatv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glGetFragDataIndex, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glGetFragDataLocation, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glGetFramebufferAttachmentParameteriv, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glGetImageHandleNV, GLAD_GL_NV_bindless_texture, 1)
+THIN_GL_GATE(glGetInteger64i_v, GLAD_GL_VERSION_3_2, 0)
+THIN_GL_GATE(glGetInteger64v, GLAD_GL_VERSION_3_2, 0)
+THIN_GL_GATE(glGetIntegeri_v, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glGetIntegeri_v, GLAD_GL_VERSION_3_1, 0)
+THIN_GL_GATE(glGetIntegerv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glGetLightfv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glGetLightiv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glGetMapdv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glGetMapfv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glGetMapiv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glGetMaterialfv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glGetMaterialiv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glGetMultisamplefv, GLAD_GL_VERSION_3_2, 0)
+THIN_GL_GATE(glGetObjectLabel, GLAD_GL_KHR_debug, 1)
+THIN_GL_GATE(glGetObjectLabelEXT, GLAD_GL_EXT_debug_label, 1)
+THIN_GL_GATE(glGetObjectLabelKHR, GLAD_GL_KHR_debug, 1)
+THIN_GL_GATE(glGetObjectPtrLabel, GLAD_GL_KHR_debug, 1)
+THIN_GL_GATE(glGetObjectPtrLabelKHR, GLAD_GL_KHR_debug, 1)
+THIN_GL_GATE(glGetPixelMapfv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glGetPixelMapuiv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glGetPixelMapusv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glGetPointerv, GLAD_GL_KHR_debug, 1)
+THIN_GL_GATE(glGetPointerv, GLAD_GL_VERSION_1_1, 0)
+THIN_GL_GATE(glGetPointervKHR, GLAD_GL_KHR_debug, 1)
+THIN_GL_GATE(glGetPolygonStipple, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glGetProgramInfoLog, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glGetProgramStageiv, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glGetProgramiv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glGetQueryIndexediv, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glGetQueryObjecti64v, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glGetQueryObjectiv, GLAD_GL_VERSION_1_5, 0)
+THIN_GL_GATE(glGetQueryObjectui64v, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glGetQueryObjectuiv, GLAD_GL_VERSION_1_5, 0)
+THIN_GL_GATE(glGetQueryiv, GLAD_GL_VERSION_1_5, 0)
+THIN_GL_GATE(glGetRenderbufferParameteriv, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glGetSamplerParameterIiv, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glGetSamplerParameterIuiv, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glGetSamplerParameterfv, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glGetSamplerParameteriv, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glGetShaderInfoLog, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glGetShaderSource, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glGetShaderiv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glGetStageIndexNV, GLAD_GL_NV_command_list, 1)
+THIN_GL_GATE(glGetString, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glGetStringi, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glGetSubroutineIndex, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glGetSubroutineUniformLocation, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glGetSynciv, GLAD_GL_VERSION_3_2, 0)
+THIN_GL_GATE(glGetTexEnvfv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glGetTexEnviv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glGetTexGendv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glGetTexGenfv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glGetTexGeniv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glGetTexImage, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glGetTexLevelParameterfv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glGetTexLevelParameteriv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glGetTexParameterIiv, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glGetTexParameterIuiv, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glGetTexParameterfv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glGetTexParameteriv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glGetTextureHandleNV, GLAD_GL_NV_bindless_texture, 1)
+THIN_GL_GATE(glGetTextureSamplerHandleNV, GLAD_GL_NV_bindless_texture, 1)
+THIN_GL_GATE(glGetTransformFeedbackVarying, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glGetUniformBlockIndex, GLAD_GL_VERSION_3_1, 0)
+THIN_GL_GATE(glGetUniformIndices, GLAD_GL_VERSION_3_1, 0)
+THIN_GL_GATE(glGetUniformLocation, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glGetUniformSubroutineuiv, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glGetUniformdv, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glGetUniformfv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glGetUniformiv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glGetUniformuiv, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glGetVertexAttribIiv, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glGetVertexAttribIuiv, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glGetVertexAttribPointerv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glGetVertexAttribdv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glGetVertexAttribfv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glGetVertexAttribiv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glHint, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glIndexMask, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glIndexPointer, GLAD_GL_VERSION_1_1, 0)
+THIN_GL_GATE(glIndexd, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glIndexdv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glIndexf, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glIndexfv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glIndexi, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glIndexiv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glIndexs, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glIndexsv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glIndexub, GLAD_GL_VERSION_1_1, 0)
+THIN_GL_GATE(glIndexubv, GLAD_GL_VERSION_1_1, 0)
+THIN_GL_GATE(glInitNames, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glInsertEventMarkerEXT, GLAD_GL_EXT_debug_marker, 1)
+THIN_GL_GATE(glInterleavedArrays, GLAD_GL_VERSION_1_1, 0)
+THIN_GL_GATE(glIsBuffer, GLAD_GL_VERSION_1_5, 0)
+THIN_GL_GATE(glIsCommandListNV, GLAD_GL_NV_command_list, 1)
+THIN_GL_GATE(glIsEnabled, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glIsEnabledi, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glIsFramebuffer, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glIsImageHandleResidentNV, GLAD_GL_NV_bindless_texture, 1)
+THIN_GL_GATE(glIsList, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glIsProgram, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glIsQuery, GLAD_GL_VERSION_1_5, 0)
+THIN_GL_GATE(glIsRenderbuffer, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glIsSampler, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glIsShader, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glIsStateNV, GLAD_GL_NV_command_list, 1)
+THIN_GL_GATE(glIsSync, GLAD_GL_VERSION_3_2, 0)
+THIN_GL_GATE(glIsTexture, GLAD_GL_VERSION_1_1, 0)
+THIN_GL_GATE(glIsTextureHandleResidentNV, GLAD_GL_NV_bindless_texture, 1)
+THIN_GL_GATE(glIsTransformFeedback, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glIsVertexArray, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glLabelObjectEXT, GLAD_GL_EXT_debug_label, 1)
+THIN_GL_GATE(glLightModelf, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glLightModelfv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glLightModeli, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glLightModeliv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glLightf, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glLightfv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glLighti, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glLightiv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glLineStipple, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glLineWidth, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glLinkProgram, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glListBase, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glListDrawCommandsStatesClientNV, GLAD_GL_NV_command_list, 1)
+THIN_GL_GATE(glLoadIdentity, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glLoadMatrixd, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glLoadMatrixf, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glLoadName, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glLoadTransposeMatrixd, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glLoadTransposeMatrixf, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glLogicOp, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glMakeImageHandleNonResidentNV, GLAD_GL_NV_bindless_texture, 1)
+THIN_GL_GATE(glMakeImageHandleResidentNV, GLAD_GL_NV_bindless_texture, 1)
+THIN_GL_GATE(glMakeTextureHandleNonResidentNV, GLAD_GL_NV_bindless_texture, 1)
+THIN_GL_GATE(glMakeTextureHandleResidentNV, GLAD_GL_NV_bindless_texture, 1)
+THIN_GL_GATE(glMap1d, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glMap1f, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glMap2d, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glMap2f, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glMapBuffer, GLAD_GL_VERSION_1_5, 0)
+THIN_GL_GATE(glMapBufferRange, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glMapGrid1d, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glMapGrid1f, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glMapGrid2d, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glMapGrid2f, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glMaterialf, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glMaterialfv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glMateriali, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glMaterialiv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glMatrixMode, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glMinSampleShading, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glMultMatrixd, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glMultMatrixf, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glMultTransposeMatrixd, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glMultTransposeMatrixf, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glMultiDrawArrays, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glMultiDrawElements, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glMultiDrawElementsBaseVertex, GLAD_GL_VERSION_3_2, 0)
+THIN_GL_GATE(glMultiTexCoord1d, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glMultiTexCoord1dv, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glMultiTexCoord1f, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glMultiTexCoord1fv, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glMultiTexCoord1i, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glMultiTexCoord1iv, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glMultiTexCoord1s, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glMultiTexCoord1sv, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glMultiTexCoord2d, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glMultiTexCoord2dv, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glMultiTexCoord2f, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glMultiTexCoord2fv, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glMultiTexCoord2i, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glMultiTexCoord2iv, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glMultiTexCoord2s, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glMultiTexCoord2sv, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glMultiTexCoord3d, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glMultiTexCoord3dv, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glMultiTexCoord3f, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glMultiTexCoord3fv, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glMultiTexCoord3i, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glMultiTexCoord3iv, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glMultiTexCoord3s, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glMultiTexCoord3sv, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glMultiTexCoord4d, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glMultiTexCoord4dv, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glMultiTexCoord4f, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glMultiTexCoord4fv, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glMultiTexCoord4i, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glMultiTexCoord4iv, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glMultiTexCoord4s, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glMultiTexCoord4sv, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glMultiTexCoordP1ui, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glMultiTexCoordP1uiv, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glMultiTexCoordP2ui, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glMultiTexCoordP2uiv, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glMultiTexCoordP3ui, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glMultiTexCoordP3uiv, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glMultiTexCoordP4ui, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glMultiTexCoordP4uiv, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glNewList, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glNormal3b, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glNormal3bv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glNormal3d, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glNormal3dv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glNormal3f, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glNormal3fv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glNormal3i, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glNormal3iv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glNormal3s, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glNormal3sv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glNormalP3ui, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glNormalP3uiv, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glNormalPointer, GLAD_GL_VERSION_1_1, 0)
+THIN_GL_GATE(glObjectLabel, GLAD_GL_KHR_debug, 1)
+THIN_GL_GATE(glObjectLabelKHR, GLAD_GL_KHR_debug, 1)
+THIN_GL_GATE(glObjectPtrLabel, GLAD_GL_KHR_debug, 1)
+THIN_GL_GATE(glObjectPtrLabelKHR, GLAD_GL_KHR_debug, 1)
+THIN_GL_GATE(glOrtho, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glPassThrough, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glPatchParameterfv, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glPatchParameteri, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glPauseTransformFeedback, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glPixelMapfv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glPixelMapuiv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glPixelMapusv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glPixelStoref, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glPixelStorei, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glPixelTransferf, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glPixelTransferi, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glPixelZoom, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glPointParameterf, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glPointParameterfv, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glPointParameteri, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glPointParameteriv, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glPointSize, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glPolygonMode, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glPolygonOffset, GLAD_GL_VERSION_1_1, 0)
+THIN_GL_GATE(glPolygonStipple, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glPopAttrib, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glPopClientAttrib, GLAD_GL_VERSION_1_1, 0)
+THIN_GL_GATE(glPopDebugGroup, GLAD_GL_KHR_debug, 1)
+THIN_GL_GATE(glPopDebugGroupKHR, GLAD_GL_KHR_debug, 1)
+THIN_GL_GATE(glPopGroupMarkerEXT, GLAD_GL_EXT_debug_marker, 1)
+THIN_GL_GATE(glPopMatrix, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glPopName, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glPrimitiveRestartIndex, GLAD_GL_VERSION_3_1, 0)
+THIN_GL_GATE(glPrioritizeTextures, GLAD_GL_VERSION_1_1, 0)
+THIN_GL_GATE(glProgramUniformHandleui64NV, GLAD_GL_NV_bindless_texture, 1)
+THIN_GL_GATE(glProgramUniformHandleui64vNV, GLAD_GL_NV_bindless_texture, 1)
+THIN_GL_GATE(glProvokingVertex, GLAD_GL_VERSION_3_2, 0)
+THIN_GL_GATE(glPushAttrib, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glPushClientAttrib, GLAD_GL_VERSION_1_1, 0)
+THIN_GL_GATE(glPushDebugGroup, GLAD_GL_KHR_debug, 1)
+THIN_GL_GATE(glPushDebugGroupKHR, GLAD_GL_KHR_debug, 1)
+THIN_GL_GATE(glPushGroupMarkerEXT, GLAD_GL_EXT_debug_marker, 1)
+THIN_GL_GATE(glPushMatrix, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glPushName, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glQueryCounter, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glRasterPos2d, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glRasterPos2dv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glRasterPos2f, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glRasterPos2fv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glRasterPos2i, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glRasterPos2iv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glRasterPos2s, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glRasterPos2sv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glRasterPos3d, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glRasterPos3dv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glRasterPos3f, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glRasterPos3fv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glRasterPos3i, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glRasterPos3iv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glRasterPos3s, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glRasterPos3sv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glRasterPos4d, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glRasterPos4dv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glRasterPos4f, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glRasterPos4fv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glRasterPos4i, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glRasterPos4iv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glRasterPos4s, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glRasterPos4sv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glReadBuffer, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glReadPixels, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glRectd, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glRectdv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glRectf, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glRectfv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glRecti, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glRectiv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glRects, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glRectsv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glRenderMode, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glRenderbufferStorage, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glRenderbufferStorageMultisample, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glResumeTransformFeedback, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glRotated, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glRotatef, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glSampleCoverage, GLAD_GL_VERSION_1_3, 0)
+THIN_GL_GATE(glSampleMaski, GLAD_GL_VERSION_3_2, 0)
+THIN_GL_GATE(glSamplerParameterIiv, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glSamplerParameterIuiv, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glSamplerParameterf, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glSamplerParameterfv, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glSamplerParameteri, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glSamplerParameteriv, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glScaled, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glScalef, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glScissor, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glSecondaryColor3b, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glSecondaryColor3bv, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glSecondaryColor3d, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glSecondaryColor3dv, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glSecondaryColor3f, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glSecondaryColor3fv, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glSecondaryColor3i, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glSecondaryColor3iv, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glSecondaryColor3s, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glSecondaryColor3sv, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glSecondaryColor3ub, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glSecondaryColor3ubv, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glSecondaryColor3ui, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glSecondaryColor3uiv, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glSecondaryColor3us, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glSecondaryColor3usv, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glSecondaryColorP3ui, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glSecondaryColorP3uiv, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glSecondaryColorPointer, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glSelectBuffer, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glShadeModel, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glShaderSource, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glStateCaptureNV, GLAD_GL_NV_command_list, 1)
+THIN_GL_GATE(glStencilFunc, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glStencilFuncSeparate, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glStencilMask, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glStencilMaskSeparate, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glStencilOp, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glStencilOpSeparate, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glTexBuffer, GLAD_GL_VERSION_3_1, 0)
+THIN_GL_GATE(glTexCoord1d, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexCoord1dv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexCoord1f, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexCoord1fv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexCoord1i, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexCoord1iv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexCoord1s, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexCoord1sv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexCoord2d, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexCoord2dv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexCoord2f, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexCoord2fv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexCoord2i, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexCoord2iv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexCoord2s, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexCoord2sv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexCoord3d, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexCoord3dv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexCoord3f, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexCoord3fv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexCoord3i, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexCoord3iv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexCoord3s, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexCoord3sv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexCoord4d, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexCoord4dv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexCoord4f, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexCoord4fv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexCoord4i, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexCoord4iv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexCoord4s, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexCoord4sv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexCoordP1ui, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glTexCoordP1uiv, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glTexCoordP2ui, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glTexCoordP2uiv, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glTexCoordP3ui, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glTexCoordP3uiv, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glTexCoordP4ui, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glTexCoordP4uiv, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glTexCoordPointer, GLAD_GL_VERSION_1_1, 0)
+THIN_GL_GATE(glTexEnvf, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexEnvfv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexEnvi, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexEnviv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexGend, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexGendv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexGenf, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexGenfv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexGeni, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexGeniv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexImage1D, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexImage2D, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexImage2DMultisample, GLAD_GL_VERSION_3_2, 0)
+THIN_GL_GATE(glTexImage3D, GLAD_GL_VERSION_1_2, 0)
+THIN_GL_GATE(glTexImage3DMultisample, GLAD_GL_VERSION_3_2, 0)
+THIN_GL_GATE(glTexParameterIiv, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glTexParameterIuiv, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glTexParameterf, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexParameterfv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexParameteri, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexParameteriv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTexSubImage1D, GLAD_GL_VERSION_1_1, 0)
+THIN_GL_GATE(glTexSubImage2D, GLAD_GL_VERSION_1_1, 0)
+THIN_GL_GATE(glTexSubImage3D, GLAD_GL_VERSION_1_2, 0)
+THIN_GL_GATE(glTransformFeedbackVaryings, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glTranslated, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glTranslatef, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glUniform1d, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glUniform1dv, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glUniform1f, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glUniform1fv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glUniform1i, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glUniform1iv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glUniform1ui, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glUniform1uiv, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glUniform2d, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glUniform2dv, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glUniform2f, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glUniform2fv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glUniform2i, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glUniform2iv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glUniform2ui, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glUniform2uiv, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glUniform3d, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glUniform3dv, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glUniform3f, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glUniform3fv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glUniform3i, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glUniform3iv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glUniform3ui, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glUniform3uiv, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glUniform4d, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glUniform4dv, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glUniform4f, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glUniform4fv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glUniform4i, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glUniform4iv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glUniform4ui, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glUniform4uiv, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glUniformBlockBinding, GLAD_GL_VERSION_3_1, 0)
+THIN_GL_GATE(glUniformHandleui64NV, GLAD_GL_NV_bindless_texture, 1)
+THIN_GL_GATE(glUniformHandleui64vNV, GLAD_GL_NV_bindless_texture, 1)
+THIN_GL_GATE(glUniformMatrix2dv, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glUniformMatrix2fv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glUniformMatrix2x3dv, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glUniformMatrix2x3fv, GLAD_GL_VERSION_2_1, 0)
+THIN_GL_GATE(glUniformMatrix2x4dv, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glUniformMatrix2x4fv, GLAD_GL_VERSION_2_1, 0)
+THIN_GL_GATE(glUniformMatrix3dv, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glUniformMatrix3fv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glUniformMatrix3x2dv, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glUniformMatrix3x2fv, GLAD_GL_VERSION_2_1, 0)
+THIN_GL_GATE(glUniformMatrix3x4dv, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glUniformMatrix3x4fv, GLAD_GL_VERSION_2_1, 0)
+THIN_GL_GATE(glUniformMatrix4dv, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glUniformMatrix4fv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glUniformMatrix4x2dv, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glUniformMatrix4x2fv, GLAD_GL_VERSION_2_1, 0)
+THIN_GL_GATE(glUniformMatrix4x3dv, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glUniformMatrix4x3fv, GLAD_GL_VERSION_2_1, 0)
+THIN_GL_GATE(glUniformSubroutinesuiv, GLAD_GL_VERSION_4_0, 0)
+THIN_GL_GATE(glUnmapBuffer, GLAD_GL_VERSION_1_5, 0)
+THIN_GL_GATE(glUseProgram, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glValidateProgram, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glVertex2d, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glVertex2dv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glVertex2f, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glVertex2fv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glVertex2i, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glVertex2iv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glVertex2s, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glVertex2sv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glVertex3d, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glVertex3dv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glVertex3f, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glVertex3fv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glVertex3i, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glVertex3iv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glVertex3s, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glVertex3sv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glVertex4d, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glVertex4dv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glVertex4f, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glVertex4fv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glVertex4i, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glVertex4iv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glVertex4s, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glVertex4sv, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glVertexAttrib1d, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glVertexAttrib1dv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glVertexAttrib1f, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glVertexAttrib1fv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glVertexAttrib1s, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glVertexAttrib1sv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glVertexAttrib2d, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glVertexAttrib2dv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glVertexAttrib2f, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glVertexAttrib2fv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glVertexAttrib2s, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glVertexAttrib2sv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glVertexAttrib3d, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glVertexAttrib3dv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glVertexAttrib3f, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glVertexAttrib3fv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glVertexAttrib3s, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glVertexAttrib3sv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glVertexAttrib4Nbv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glVertexAttrib4Niv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glVertexAttrib4Nsv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glVertexAttrib4Nub, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glVertexAttrib4Nubv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glVertexAttrib4Nuiv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glVertexAttrib4Nusv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glVertexAttrib4bv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glVertexAttrib4d, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glVertexAttrib4dv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glVertexAttrib4f, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glVertexAttrib4fv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glVertexAttrib4iv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glVertexAttrib4s, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glVertexAttrib4sv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glVertexAttrib4ubv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glVertexAttrib4uiv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glVertexAttrib4usv, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glVertexAttribDivisor, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glVertexAttribI1i, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glVertexAttribI1iv, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glVertexAttribI1ui, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glVertexAttribI1uiv, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glVertexAttribI2i, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glVertexAttribI2iv, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glVertexAttribI2ui, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glVertexAttribI2uiv, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glVertexAttribI3i, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glVertexAttribI3iv, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glVertexAttribI3ui, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glVertexAttribI3uiv, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glVertexAttribI4bv, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glVertexAttribI4i, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glVertexAttribI4iv, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glVertexAttribI4sv, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glVertexAttribI4ubv, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glVertexAttribI4ui, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glVertexAttribI4uiv, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glVertexAttribI4usv, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glVertexAttribIPointer, GLAD_GL_VERSION_3_0, 0)
+THIN_GL_GATE(glVertexAttribP1ui, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glVertexAttribP1uiv, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glVertexAttribP2ui, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glVertexAttribP2uiv, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glVertexAttribP3ui, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glVertexAttribP3uiv, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glVertexAttribP4ui, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glVertexAttribP4uiv, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glVertexAttribPointer, GLAD_GL_VERSION_2_0, 0)
+THIN_GL_GATE(glVertexP2ui, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glVertexP2uiv, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glVertexP3ui, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glVertexP3uiv, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glVertexP4ui, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glVertexP4uiv, GLAD_GL_VERSION_3_3, 0)
+THIN_GL_GATE(glVertexPointer, GLAD_GL_VERSION_1_1, 0)
+THIN_GL_GATE(glViewport, GLAD_GL_VERSION_1_0, 0)
+THIN_GL_GATE(glWaitSync, GLAD_GL_VERSION_3_2, 0)
+THIN_GL_GATE(glWindowPos2d, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glWindowPos2dv, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glWindowPos2f, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glWindowPos2fv, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glWindowPos2i, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glWindowPos2iv, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glWindowPos2s, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glWindowPos2sv, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glWindowPos3d, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glWindowPos3dv, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glWindowPos3f, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glWindowPos3fv, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glWindowPos3i, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glWindowPos3iv, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glWindowPos3s, GLAD_GL_VERSION_1_4, 0)
+THIN_GL_GATE(glWindowPos3sv, GLAD_GL_VERSION_1_4, 0)
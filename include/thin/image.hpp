@@ -0,0 +1,886 @@
+#ifndef THIN_IMAGE_INCLUDED_
+#define THIN_IMAGE_INCLUDED_
+
+
+/*
+  CPU side image kernels for preparing texture data off the render thread,
+  channel expansion, premultiplied alpha, swizzles and mip chains. Pixels
+  are 8 bits a channel with rows tightly packed.
+
+  SSE2 (SSSE3 for the RGB expansion) and NEON paths when the compiler
+  targets them, plain C++ otherwise. Work is split across rows through an
+  ImageJobs, which runs everything inline unless given a parallel for.
+*/
+
+
+#include <stdint.h>
+#include <stddef.h>
+
+
+// ------------------------------------------------------------------[ Jobs ]--
+
+using image_rows_fn = void(*)(void *task, size_t first_row, size_t last_row);
+
+/*
+  Runs fn over [0, rows) in any number of row ranges and returns when all
+  of them are done.
+*/
+using image_jobs_fn = void(*)(void *user, size_t rows, image_rows_fn fn, void *task);
+
+struct ImageJobs
+{
+  image_jobs_fn run;        // Null runs inline on the calling thread.
+  void          *user;
+};
+
+/*
+  image_jobs_fn on std::thread, starts threads per call so only worth it
+  for large images. user may point to an unsigned thread count, null uses
+  every hardware thread. Link with -pthread.
+*/
+void
+imageThreads(void *user, size_t rows, image_rows_fn fn, void *task);
+
+// ---------------------------------------------------------------[ Kernels ]--
+
+/*
+  RGB to RGBA with a constant alpha. dst may be src, in place runs back to
+  front on one thread, the buffer then needs room for the RGBA result.
+*/
+void
+imageRGBToRGBA(const uint8_t *src,
+               uint8_t *dst,
+               const size_t width,
+               const size_t height,
+               const uint8_t alpha = 255,
+               const ImageJobs jobs = {});
+
+void
+imagePremultiplyAlpha(uint8_t *rgba,
+                      const size_t width,
+                      const size_t height,
+                      const ImageJobs jobs = {});
+
+/*
+  Output channel c takes input channel order[c], {2, 1, 0, 3} is RGBA to
+  BGRA and back.
+*/
+void
+imageSwizzle(uint8_t *rgba,
+             const size_t width,
+             const size_t height,
+             const uint8_t order[4],
+             const ImageJobs jobs = {});
+
+// ------------------------------------------------------------------[ Mips ]--
+
+enum class ImageFilter : uint8_t
+{
+  box,              // 2x2 average.
+  kaiser,           // Windowed sinc, sharper, costs more.
+};
+
+/*
+  Halves an RGBA image, odd sizes round down to no less than 1. With srgb
+  the color channels are filtered in linear space, alpha always is.
+*/
+void
+imageDownsample(const uint8_t *src,
+                const size_t width,
+                const size_t height,
+                uint8_t *dst,
+                const ImageFilter filter = ImageFilter::box,
+                const bool srgb = true,
+                const ImageJobs jobs = {});
+
+size_t
+imageMipCount(const size_t width, const size_t height);
+
+/*
+  Bytes for an RGBA image and every mip below it, levels packed one after
+  another.
+*/
+size_t
+imageMipChainSize(const size_t width, const size_t height);
+
+/*
+  Fills the levels after level 0, which must already be at the start of
+  chain. Returns the level count.
+*/
+size_t
+imageMipChain(uint8_t *chain,
+              const size_t width,
+              const size_t height,
+              const ImageFilter filter = ImageFilter::box,
+              const bool srgb = true,
+              const ImageJobs jobs = {});
+
+
+#endif // inc guard
+
+
+#if defined(THIN_IMAGE_IMPL) && !defined(THIN_IMAGE_IMPL_INCLUDED_)
+#define THIN_IMAGE_IMPL_INCLUDED_
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define THIN_IMAGE_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(__SSSE3__)
+#define THIN_IMAGE_SSSE3
+#include <tmmintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define THIN_IMAGE_NEON
+#include <arm_neon.h>
+#endif
+
+
+// ------------------------------------------------------------------[ Jobs ]--
+
+void
+imageThreads(void *user, size_t rows, image_rows_fn fn, void *task)
+{
+  const unsigned hardware = std::thread::hardware_concurrency();
+  unsigned thread_count = user ? *(const unsigned*)user : hardware;
+
+  // Not worth a thread for a handful of rows.
+  constexpr size_t min_rows = 16;
+  const size_t max_threads = (rows + min_rows - 1) / min_rows;
+
+  thread_count = thread_count > max_threads ? (unsigned)max_threads : thread_count;
+
+  if(thread_count <= 1)
+  {
+    fn(task, 0, rows);
+    return;
+  }
+
+  constexpr unsigned max_thread_count = 64;
+  thread_count = thread_count > max_thread_count ? max_thread_count : thread_count;
+
+  std::thread threads[max_thread_count];
+  const size_t per_thread = (rows + thread_count - 1) / thread_count;
+
+  // The calling thread takes the first range.
+  for(unsigned i = 1; i < thread_count; ++i)
+  {
+    const size_t first = i * per_thread;
+    const size_t last = first + per_thread < rows ? first + per_thread : rows;
+
+    if(first < last)
+    {
+      threads[i] = std::thread(fn, task, first, last);
+    }
+  }
+
+  fn(task, 0, per_thread < rows ? per_thread : rows);
+
+  for(unsigned i = 1; i < thread_count; ++i)
+  {
+    if(threads[i].joinable())
+    {
+      threads[i].join();
+    }
+  }
+}
+
+static void
+imageRun(const ImageJobs &jobs, const size_t rows, image_rows_fn fn, void *task)
+{
+  if(jobs.run)
+  {
+    jobs.run(jobs.user, rows, fn, task);
+  }
+  else
+  {
+    fn(task, 0, rows);
+  }
+}
+
+
+// ----------------------------------------------------------------[ Expand ]--
+
+static inline void
+imageExpandPixel(const uint8_t *src, uint8_t *dst, const size_t i, const uint8_t alpha)
+{
+  const uint8_t r = src[i * 3 + 0];
+  const uint8_t g = src[i * 3 + 1];
+  const uint8_t b = src[i * 3 + 2];
+
+  dst[i * 4 + 0] = r;
+  dst[i * 4 + 1] = g;
+  dst[i * 4 + 2] = b;
+  dst[i * 4 + 3] = alpha;
+}
+
+static void
+imageExpandPixels(const uint8_t *src, uint8_t *dst, const size_t count, const uint8_t alpha)
+{
+  // Back to front so dst can overlap src, each block is read before it is
+  // written.
+  size_t i = count;
+
+  #if defined(THIN_IMAGE_SSSE3)
+  const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+  const __m128i alpha_mask = _mm_set1_epi32((int)((uint32_t)alpha << 24));
+
+  // 16 bytes in for 4 pixels out, the last 2 pixels go scalar so every
+  // load stays in bounds.
+  const size_t simd_end = count >= 6 ? count - 2 : 0;
+
+  for(; i > simd_end; --i)
+  {
+    imageExpandPixel(src, dst, i - 1, alpha);
+  }
+
+  while(i >= 4)
+  {
+    i -= 4;
+
+    const __m128i rgb = _mm_loadu_si128((const __m128i*)(src + i * 3));
+    const __m128i rgba = _mm_or_si128(_mm_shuffle_epi8(rgb, shuffle), alpha_mask);
+
+    _mm_storeu_si128((__m128i*)(dst + i * 4), rgba);
+  }
+  #elif defined(THIN_IMAGE_NEON)
+  while(i >= 16)
+  {
+    i -= 16;
+
+    const uint8x16x3_t rgb = vld3q_u8(src + i * 3);
+    uint8x16x4_t rgba;
+    rgba.val[0] = rgb.val[0];
+    rgba.val[1] = rgb.val[1];
+    rgba.val[2] = rgb.val[2];
+    rgba.val[3] = vdupq_n_u8(alpha);
+
+    vst4q_u8(dst + i * 4, rgba);
+  }
+  #endif
+
+  for(; i > 0; --i)
+  {
+    imageExpandPixel(src, dst, i - 1, alpha);
+  }
+}
+
+struct ImageExpandTask
+{
+  const uint8_t *src;
+  uint8_t       *dst;
+  size_t        width;
+  uint8_t       alpha;
+};
+
+static void
+imageExpandRows(void *task, size_t first_row, size_t last_row)
+{
+  const ImageExpandTask *t = (const ImageExpandTask*)task;
+
+  imageExpandPixels(t->src + first_row * t->width * 3,
+                    t->dst + first_row * t->width * 4,
+                    (last_row - first_row) * t->width,
+                    t->alpha);
+}
+
+void
+imageRGBToRGBA(const uint8_t *src,
+               uint8_t *dst,
+               const size_t width,
+               const size_t height,
+               const uint8_t alpha,
+               const ImageJobs jobs)
+{
+  const bool overlaps = dst < src + width * height * 3 && src < dst + width * height * 4;
+
+  if(overlaps)
+  {
+    imageExpandPixels(src, dst, width * height, alpha);
+    return;
+  }
+
+  ImageExpandTask task = {src, dst, width, alpha};
+  imageRun(jobs, height, imageExpandRows, &task);
+}
+
+
+// -----------------------------------------------------------[ Premultiply ]--
+
+static inline uint8_t
+imageMulDiv255(const uint32_t a, const uint32_t b)
+{
+  // Exact round(a * b / 255).
+  const uint32_t t = a * b + 128;
+  return (uint8_t)((t + (t >> 8)) >> 8);
+}
+
+static void
+imagePremultiplyRows(void *task, size_t first_row, size_t last_row)
+{
+  const ImageExpandTask *t = (const ImageExpandTask*)task;
+  uint8_t *px = t->dst + first_row * t->width * 4;
+  const size_t count = (last_row - first_row) * t->width;
+  size_t i = 0;
+
+  #if defined(THIN_IMAGE_SSE2)
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i round = _mm_set1_epi16(128);
+  const __m128i alpha_mask = _mm_set1_epi32((int)0xff000000);
+
+  for(; i + 4 <= count; i += 4)
+  {
+    const __m128i src = _mm_loadu_si128((const __m128i*)(px + i * 4));
+
+    __m128i lo = _mm_unpacklo_epi8(src, zero);
+    __m128i hi = _mm_unpackhi_epi8(src, zero);
+
+    const __m128i lo_a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, 0xff), 0xff);
+    const __m128i hi_a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, 0xff), 0xff);
+
+    lo = _mm_add_epi16(_mm_mullo_epi16(lo, lo_a), round);
+    hi = _mm_add_epi16(_mm_mullo_epi16(hi, hi_a), round);
+    lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+    hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+
+    // Alpha itself stays as it was.
+    const __m128i rgb = _mm_andnot_si128(alpha_mask, _mm_packus_epi16(lo, hi));
+    _mm_storeu_si128((__m128i*)(px + i * 4), _mm_or_si128(rgb, _mm_and_si128(src, alpha_mask)));
+  }
+  #elif defined(THIN_IMAGE_NEON)
+  for(; i + 16 <= count; i += 16)
+  {
+    uint8x16x4_t rgba = vld4q_u8(px + i * 4);
+
+    for(int c = 0; c < 3; ++c)
+    {
+      const uint16x8_t lo = vmull_u8(vget_low_u8(rgba.val[c]), vget_low_u8(rgba.val[3]));
+      const uint16x8_t hi = vmull_u8(vget_high_u8(rgba.val[c]), vget_high_u8(rgba.val[3]));
+
+      rgba.val[c] = vcombine_u8(vraddhn_u16(lo, vrshrq_n_u16(lo, 8)),
+                                vraddhn_u16(hi, vrshrq_n_u16(hi, 8)));
+    }
+
+    vst4q_u8(px + i * 4, rgba);
+  }
+  #endif
+
+  for(; i < count; ++i)
+  {
+    const uint32_t a = px[i * 4 + 3];
+
+    px[i * 4 + 0] = imageMulDiv255(px[i * 4 + 0], a);
+    px[i * 4 + 1] = imageMulDiv255(px[i * 4 + 1], a);
+    px[i * 4 + 2] = imageMulDiv255(px[i * 4 + 2], a);
+  }
+}
+
+void
+imagePremultiplyAlpha(uint8_t *rgba,
+                      const size_t width,
+                      const size_t height,
+                      const ImageJobs jobs)
+{
+  ImageExpandTask task = {rgba, rgba, width, 0};
+  imageRun(jobs, height, imagePremultiplyRows, &task);
+}
+
+
+// ---------------------------------------------------------------[ Swizzle ]--
+
+struct ImageSwizzleTask
+{
+  uint8_t *px;
+  size_t  width;
+  uint8_t order[4];
+};
+
+static void
+imageSwizzleRows(void *task, size_t first_row, size_t last_row)
+{
+  const ImageSwizzleTask *t = (const ImageSwizzleTask*)task;
+  uint8_t *px = t->px + first_row * t->width * 4;
+  const size_t count = (last_row - first_row) * t->width;
+  size_t i = 0;
+
+  #if defined(THIN_IMAGE_SSSE3)
+  const __m128i shuffle = _mm_setr_epi8(
+    t->order[0], t->order[1], t->order[2], t->order[3],
+    t->order[0] + 4, t->order[1] + 4, t->order[2] + 4, t->order[3] + 4,
+    t->order[0] + 8, t->order[1] + 8, t->order[2] + 8, t->order[3] + 8,
+    t->order[0] + 12, t->order[1] + 12, t->order[2] + 12, t->order[3] + 12);
+
+  for(; i + 4 <= count; i += 4)
+  {
+    const __m128i src = _mm_loadu_si128((const __m128i*)(px + i * 4));
+    _mm_storeu_si128((__m128i*)(px + i * 4), _mm_shuffle_epi8(src, shuffle));
+  }
+  #elif defined(THIN_IMAGE_SSE2)
+  const __m128i byte_mask = _mm_set1_epi32(0xff);
+  __m128i shifts[4];
+
+  for(int c = 0; c < 4; ++c)
+  {
+    shifts[c] = _mm_cvtsi32_si128(t->order[c] * 8);
+  }
+
+  for(; i + 4 <= count; i += 4)
+  {
+    const __m128i src = _mm_loadu_si128((const __m128i*)(px + i * 4));
+    __m128i out = _mm_setzero_si128();
+
+    for(int c = 0; c < 4; ++c)
+    {
+      const __m128i channel = _mm_and_si128(_mm_srl_epi32(src, shifts[c]), byte_mask);
+      out = _mm_or_si128(out, _mm_sll_epi32(channel, _mm_cvtsi32_si128(c * 8)));
+    }
+
+    _mm_storeu_si128((__m128i*)(px + i * 4), out);
+  }
+  #elif defined(THIN_IMAGE_NEON)
+  for(; i + 16 <= count; i += 16)
+  {
+    const uint8x16x4_t src = vld4q_u8(px + i * 4);
+    uint8x16x4_t out;
+
+    for(int c = 0; c < 4; ++c)
+    {
+      out.val[c] = src.val[t->order[c]];
+    }
+
+    vst4q_u8(px + i * 4, out);
+  }
+  #endif
+
+  for(; i < count; ++i)
+  {
+    uint8_t in[4];
+    memcpy(in, px + i * 4, 4);
+
+    for(int c = 0; c < 4; ++c)
+    {
+      px[i * 4 + c] = in[t->order[c]];
+    }
+  }
+}
+
+void
+imageSwizzle(uint8_t *rgba,
+             const size_t width,
+             const size_t height,
+             const uint8_t order[4],
+             const ImageJobs jobs)
+{
+  ImageSwizzleTask task = {rgba, width, {order[0], order[1], order[2], order[3]}};
+
+  for(int c = 0; c < 4; ++c)
+  {
+    task.order[c] &= 3;
+  }
+
+  imageRun(jobs, height, imageSwizzleRows, &task);
+}
+
+
+// ----------------------------------------------------------------[ Colors ]--
+/*
+  sRGB in 8 bits to linear in 16, and back from the top 12 bits of linear.
+  Built once by the first downsample.
+*/
+
+static uint16_t image_srgb_to_linear[256];
+static uint8_t image_linear_to_srgb[4096];
+static float image_srgb_to_linear_f[256];
+
+static bool
+imageFillTables()
+{
+  for(int i = 0; i < 256; ++i)
+  {
+    const float s = i / 255.f;
+    const float l = s <= 0.04045f ? s / 12.92f : powf((s + 0.055f) / 1.055f, 2.4f);
+
+    image_srgb_to_linear_f[i] = l;
+    image_srgb_to_linear[i] = (uint16_t)(l * 65535.f + 0.5f);
+  }
+
+  for(int i = 0; i < 4096; ++i)
+  {
+    const float l = (i + 0.5f) / 4096.f;
+    const float s = l <= 0.0031308f ? l * 12.92f : 1.055f * powf(l, 1.f / 2.4f) - 0.055f;
+
+    image_linear_to_srgb[i] = (uint8_t)(s * 255.f + 0.5f);
+  }
+
+  return true;
+}
+
+static void
+imageBuildTables()
+{
+  // Function statics initialize once even with several callers.
+  static const bool built = imageFillTables();
+  (void)built;
+}
+
+static inline uint8_t
+imageLinearToSRGB(const float l)
+{
+  const float clamped = l < 0.f ? 0.f : l > 1.f ? 1.f : l;
+  const int index = (int)(clamped * 4095.f + 0.5f);
+
+  return image_linear_to_srgb[index];
+}
+
+
+// -------------------------------------------------------------------[ Box ]--
+
+struct ImageDownsampleTask
+{
+  const uint8_t *src;
+  uint8_t       *dst;
+  size_t        width;
+  size_t        height;
+  size_t        dst_width;
+  size_t        dst_height;
+  bool          srgb;
+  float         *scratch;       // Kaiser only, dst_width * height * 4.
+};
+
+static void
+imageBoxRows(void *task, size_t first_row, size_t last_row)
+{
+  const ImageDownsampleTask *t = (const ImageDownsampleTask*)task;
+
+  for(size_t y = first_row; y < last_row; ++y)
+  {
+    const size_t y0 = y * 2 < t->height ? y * 2 : t->height - 1;
+    const size_t y1 = y0 + 1 < t->height ? y0 + 1 : y0;
+
+    const uint8_t *row0 = t->src + y0 * t->width * 4;
+    const uint8_t *row1 = t->src + y1 * t->width * 4;
+    uint8_t *out = t->dst + y * t->dst_width * 4;
+
+    size_t x = 0;
+
+    if(!t->srgb)
+    {
+      #if defined(THIN_IMAGE_SSE2)
+      const __m128i zero = _mm_setzero_si128();
+      const __m128i two = _mm_set1_epi16(2);
+
+      // 8 source pixels a row make 4 out.
+      for(; (x + 4) * 2 <= t->width; x += 4)
+      {
+        __m128i a0 = _mm_loadu_si128((const __m128i*)(row0 + x * 8));
+        __m128i a1 = _mm_loadu_si128((const __m128i*)(row0 + x * 8 + 16));
+        __m128i b0 = _mm_loadu_si128((const __m128i*)(row1 + x * 8));
+        __m128i b1 = _mm_loadu_si128((const __m128i*)(row1 + x * 8 + 16));
+
+        // Even pixels in the low half, odd in the high.
+        a0 = _mm_shuffle_epi32(a0, _MM_SHUFFLE(3, 1, 2, 0));
+        a1 = _mm_shuffle_epi32(a1, _MM_SHUFFLE(3, 1, 2, 0));
+        b0 = _mm_shuffle_epi32(b0, _MM_SHUFFLE(3, 1, 2, 0));
+        b1 = _mm_shuffle_epi32(b1, _MM_SHUFFLE(3, 1, 2, 0));
+
+        const __m128i a_even = _mm_unpacklo_epi64(a0, a1);
+        const __m128i a_odd = _mm_unpackhi_epi64(a0, a1);
+        const __m128i b_even = _mm_unpacklo_epi64(b0, b1);
+        const __m128i b_odd = _mm_unpackhi_epi64(b0, b1);
+
+        __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a_even, zero), _mm_unpacklo_epi8(a_odd, zero));
+        __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a_even, zero), _mm_unpackhi_epi8(a_odd, zero));
+        lo = _mm_add_epi16(lo, _mm_add_epi16(_mm_unpacklo_epi8(b_even, zero), _mm_unpacklo_epi8(b_odd, zero)));
+        hi = _mm_add_epi16(hi, _mm_add_epi16(_mm_unpackhi_epi8(b_even, zero), _mm_unpackhi_epi8(b_odd, zero)));
+
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, two), 2);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, two), 2);
+
+        _mm_storeu_si128((__m128i*)(out + x * 4), _mm_packus_epi16(lo, hi));
+      }
+      #elif defined(THIN_IMAGE_NEON)
+      // 16 source pixels a row make 8 out.
+      for(; (x + 8) * 2 <= t->width; x += 8)
+      {
+        const uint8x16x4_t a = vld4q_u8(row0 + x * 8);
+        const uint8x16x4_t b = vld4q_u8(row1 + x * 8);
+        uint8x8x4_t result;
+
+        for(int c = 0; c < 4; ++c)
+        {
+          const uint16x8_t sum = vaddq_u16(vpaddlq_u8(a.val[c]), vpaddlq_u8(b.val[c]));
+          result.val[c] = vrshrn_n_u16(sum, 2);
+        }
+
+        vst4_u8(out + x * 4, result);
+      }
+      #endif
+    }
+
+    for(; x < t->dst_width; ++x)
+    {
+      const size_t x0 = x * 2 < t->width ? x * 2 : t->width - 1;
+      const size_t x1 = x0 + 1 < t->width ? x0 + 1 : x0;
+
+      const uint8_t *p[4] = {
+        row0 + x0 * 4, row0 + x1 * 4, row1 + x0 * 4, row1 + x1 * 4,
+      };
+
+      for(int c = 0; c < 3; ++c)
+      {
+        if(t->srgb)
+        {
+          const uint32_t sum = image_srgb_to_linear[p[0][c]] + image_srgb_to_linear[p[1][c]] +
+                               image_srgb_to_linear[p[2][c]] + image_srgb_to_linear[p[3][c]];
+
+          // Average in 16 bits, table index from the top 12.
+          out[x * 4 + c] = image_linear_to_srgb[((sum + 2) >> 2) >> 4];
+        }
+        else
+        {
+          out[x * 4 + c] = (uint8_t)((p[0][c] + p[1][c] + p[2][c] + p[3][c] + 2) >> 2);
+        }
+      }
+
+      out[x * 4 + 3] = (uint8_t)((p[0][3] + p[1][3] + p[2][3] + p[3][3] + 2) >> 2);
+    }
+  }
+}
+
+
+// ----------------------------------------------------------------[ Kaiser ]--
+/*
+  Separable 2x decimation with a Kaiser windowed sinc, alpha 4 over 3 taps
+  either side at the source rate. Rows go into float scratch at half width,
+  then columns into the output.
+*/
+
+constexpr int image_kaiser_taps = 6;
+
+static float
+imageBesselI0(const float x)
+{
+  float sum = 1.f;
+  float term = 1.f;
+
+  for(int k = 1; k < 16; ++k)
+  {
+    term *= (x * 0.5f / k) * (x * 0.5f / k);
+    sum += term;
+  }
+
+  return sum;
+}
+
+static void
+imageKaiserWeights(float out_weights[image_kaiser_taps])
+{
+  // Taps sit at source centers -2.5 .. 2.5 from the output center, in
+  // output texels that is half that.
+  constexpr float alpha = 4.f;
+  constexpr float width = 3.f;
+  const float pi = 3.14159265f;
+  float total = 0.f;
+
+  for(int i = 0; i < image_kaiser_taps; ++i)
+  {
+    const float d = (i - 2.5f) * 0.5f;
+    const float sinc = d == 0.f ? 1.f : sinf(pi * d) / (pi * d);
+    const float r = (i - 2.5f) / width;
+    const float window = imageBesselI0(alpha * sqrtf(1.f - r * r)) / imageBesselI0(alpha);
+
+    out_weights[i] = sinc * window;
+    total += out_weights[i];
+  }
+
+  for(int i = 0; i < image_kaiser_taps; ++i)
+  {
+    out_weights[i] /= total;
+  }
+}
+
+static inline float
+imageToLinear(const uint8_t value, const bool srgb)
+{
+  return srgb ? image_srgb_to_linear_f[value] : value / 255.f;
+}
+
+static void
+imageKaiserRows(void *task, size_t first_row, size_t last_row)
+{
+  const ImageDownsampleTask *t = (const ImageDownsampleTask*)task;
+
+  float weights[image_kaiser_taps];
+  imageKaiserWeights(weights);
+
+  for(size_t y = first_row; y < last_row; ++y)
+  {
+    const uint8_t *row = t->src + y * t->width * 4;
+    float *out = t->scratch + y * t->dst_width * 4;
+
+    for(size_t x = 0; x < t->dst_width; ++x)
+    {
+      float sum[4] = {0.f, 0.f, 0.f, 0.f};
+
+      for(int i = 0; i < image_kaiser_taps; ++i)
+      {
+        // Clamp to edge.
+        const ptrdiff_t sx = (ptrdiff_t)(x * 2) + i - 2;
+        const size_t cx = sx < 0 ? 0 : (size_t)sx >= t->width ? t->width - 1 : (size_t)sx;
+        const uint8_t *p = row + cx * 4;
+
+        sum[0] += weights[i] * imageToLinear(p[0], t->srgb);
+        sum[1] += weights[i] * imageToLinear(p[1], t->srgb);
+        sum[2] += weights[i] * imageToLinear(p[2], t->srgb);
+        sum[3] += weights[i] * (p[3] / 255.f);
+      }
+
+      memcpy(out + x * 4, sum, sizeof(sum));
+    }
+  }
+}
+
+static void
+imageKaiserColumns(void *task, size_t first_row, size_t last_row)
+{
+  const ImageDownsampleTask *t = (const ImageDownsampleTask*)task;
+
+  float weights[image_kaiser_taps];
+  imageKaiserWeights(weights);
+
+  for(size_t y = first_row; y < last_row; ++y)
+  {
+    uint8_t *out = t->dst + y * t->dst_width * 4;
+
+    for(size_t x = 0; x < t->dst_width * 4; x += 4)
+    {
+      float sum[4] = {0.f, 0.f, 0.f, 0.f};
+
+      for(int i = 0; i < image_kaiser_taps; ++i)
+      {
+        const ptrdiff_t sy = (ptrdiff_t)(y * 2) + i - 2;
+        const size_t cy = sy < 0 ? 0 : (size_t)sy >= t->height ? t->height - 1 : (size_t)sy;
+        const float *p = t->scratch + cy * t->dst_width * 4 + x;
+
+        for(int c = 0; c < 4; ++c)
+        {
+          sum[c] += weights[i] * p[c];
+        }
+      }
+
+      for(int c = 0; c < 3; ++c)
+      {
+        const float v = sum[c] < 0.f ? 0.f : sum[c] > 1.f ? 1.f : sum[c];
+        out[x + c] = t->srgb ? imageLinearToSRGB(v) : (uint8_t)(v * 255.f + 0.5f);
+      }
+
+      const float a = sum[3] < 0.f ? 0.f : sum[3] > 1.f ? 1.f : sum[3];
+      out[x + 3] = (uint8_t)(a * 255.f + 0.5f);
+    }
+  }
+}
+
+
+// ------------------------------------------------------------------[ Mips ]--
+
+void
+imageDownsample(const uint8_t *src,
+                const size_t width,
+                const size_t height,
+                uint8_t *dst,
+                const ImageFilter filter,
+                const bool srgb,
+                const ImageJobs jobs)
+{
+  imageBuildTables();
+
+  ImageDownsampleTask task;
+  task.src = src;
+  task.dst = dst;
+  task.width = width;
+  task.height = height;
+  task.dst_width = width > 1 ? width / 2 : 1;
+  task.dst_height = height > 1 ? height / 2 : 1;
+  task.srgb = srgb;
+  task.scratch = nullptr;
+
+  if(filter == ImageFilter::box)
+  {
+    imageRun(jobs, task.dst_height, imageBoxRows, &task);
+    return;
+  }
+
+  task.scratch = (float*)malloc(task.dst_width * height * 4 * sizeof(float));
+
+  imageRun(jobs, height, imageKaiserRows, &task);
+  imageRun(jobs, task.dst_height, imageKaiserColumns, &task);
+
+  free(task.scratch);
+}
+
+size_t
+imageMipCount(const size_t width, const size_t height)
+{
+  size_t count = 1;
+
+  for(size_t size = width > height ? width : height; size > 1; size >>= 1)
+  {
+    ++count;
+  }
+
+  return count;
+}
+
+size_t
+imageMipChainSize(const size_t width, const size_t height)
+{
+  size_t bytes = 0;
+  size_t w = width;
+  size_t h = height;
+
+  for(size_t level = imageMipCount(width, height); level > 0; --level)
+  {
+    bytes += w * h * 4;
+    w = w > 1 ? w / 2 : 1;
+    h = h > 1 ? h / 2 : 1;
+  }
+
+  return bytes;
+}
+
+size_t
+imageMipChain(uint8_t *chain,
+              const size_t width,
+              const size_t height,
+              const ImageFilter filter,
+              const bool srgb,
+              const ImageJobs jobs)
+{
+  const size_t levels = imageMipCount(width, height);
+  uint8_t *src = chain;
+  size_t w = width;
+  size_t h = height;
+
+  for(size_t level = 1; level < levels; ++level)
+  {
+    uint8_t *dst = src + w * h * 4;
+    imageDownsample(src, w, h, dst, filter, srgb, jobs);
+
+    src = dst;
+    w = w > 1 ? w / 2 : 1;
+    h = h > 1 ? h / 2 : 1;
+  }
+
+  return levels;
+}
+
+
+#endif // impl guard
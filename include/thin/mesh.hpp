@@ -0,0 +1,922 @@
+#ifndef THIN_MESH_INCLUDED_
+#define THIN_MESH_INCLUDED_
+
+
+/*
+  Mesh building utilities, these run on the CPU before the data reaches
+  Device::bufferData.
+*/
+
+
+#include "ogl_device.hpp"
+
+
+// --------------------------------------------------------------[ Indexing ]--
+
+struct MeshIndexResult
+{
+  size_t  vertex_count;   // Unique vertices written to out_vertices.
+  size_t  index_count;
+  GLenum  index_type;     // GL_UNSIGNED_SHORT or GL_UNSIGNED_INT.
+  size_t  index_size;     // Bytes per index, 2 or 4.
+};
+
+/*
+  Removes bitwise duplicate vertices from an unindexed stream and emits the
+  matching index buffer, in the same triangle order as the input.
+  out_vertices can alias vertices, out_indices must hold vertex_count 32bit
+  indices, they are packed to 16bit in place when the unique count fits.
+*/
+MeshIndexResult
+indexMesh(const void *vertices,
+          const size_t vertex_count,
+          const size_t vertex_stride,
+          void *out_vertices,
+          void *out_indices);
+
+/*
+  Packs 32bit indices to 16bit in place if every index fits. Returns
+  GL_UNSIGNED_SHORT or GL_UNSIGNED_INT.
+*/
+GLenum
+packIndices(uint32_t *indices,
+            const size_t index_count,
+            const size_t vertex_count);
+
+// ----------------------------------------------------------[ Vertex Cache ]--
+
+struct MeshCacheStats
+{
+  float   acmr;           // Transformed vertices per triangle, lower is better.
+  float   atvr;           // Transformed vertices per used vertex, 1 is ideal.
+  size_t  transforms;
+};
+
+struct MeshOptimizeResult
+{
+  MeshCacheStats  before;
+  MeshCacheStats  after;
+  size_t          vertex_count;   // Vertices still referenced after fetch.
+};
+
+/*
+  Simulates a FIFO post-transform cache of cache_size entries over a
+  triangle list.
+*/
+MeshCacheStats
+analyzeVertexCache(const void *indices,
+                   const size_t index_count,
+                   const GLenum index_type,
+                   const size_t vertex_count,
+                   const size_t cache_size = 16);
+
+/*
+  Reorders the triangles of one draw in place, Forsyth's linear speed vertex
+  cache optimisation.
+*/
+void
+optimizeVertexCache(void *indices,
+                    const size_t index_count,
+                    const GLenum index_type,
+                    const size_t vertex_count);
+
+/*
+  Reorders clusters of an already cache optimised triangle list in place
+  so outward facing ones on the hull draw first and occlude the rest,
+  Sander et al.'s overdraw ordering. Positions are 3 floats at
+  position_offset in each vertex. A threshold above 1 trades that much
+  ACMR for smaller clusters to sort, 1.05 is a fair default.
+*/
+void
+optimizeOverdraw(void *indices,
+                 const size_t index_count,
+                 const GLenum index_type,
+                 const void *vertices,
+                 const size_t vertex_count,
+                 const size_t vertex_stride,
+                 const size_t position_offset,
+                 const float threshold = 1.05f);
+
+/*
+  Reorders vertices in place by first use so fetches walk the buffer
+  forward and remaps the indices to match. Unreferenced vertices are
+  dropped, returns the new vertex count.
+*/
+size_t
+optimizeVertexFetch(void *vertices,
+                    const size_t vertex_count,
+                    const size_t vertex_stride,
+                    void *indices,
+                    const size_t index_count,
+                    const GLenum index_type);
+
+// No positions to hand optimizeMesh, the overdraw pass is skipped.
+constexpr size_t mesh_no_position = ~(size_t)0;
+
+/*
+  Runs the optimisations over a mesh drawn with a single call and reports
+  the cache stats either side. Overdraw ordering runs between the cache
+  and fetch passes when position_offset is given.
+*/
+MeshOptimizeResult
+optimizeMesh(void *vertices,
+             const size_t vertex_count,
+             const size_t vertex_stride,
+             void *indices,
+             const size_t index_count,
+             const GLenum index_type,
+             const size_t position_offset = mesh_no_position);
+
+
+#endif // inc guard
+
+
+#if defined(THIN_MESH_IMPL) && !defined(THIN_MESH_IMPL_INCLUDED_)
+#define THIN_MESH_IMPL_INCLUDED_
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+// --------------------------------------------------------------[ Indexing ]--
+
+static inline uint32_t
+meshHashVertex(const uint8_t *vertex, const size_t stride)
+{
+  // Murmur3 style mix over 32bit words, vertices are mostly floats.
+  uint32_t hash = 0x9747b28cu;
+  size_t i = 0;
+
+  for(; i + 4 <= stride; i += 4)
+  {
+    uint32_t k;
+    memcpy(&k, vertex + i, sizeof(k));
+
+    k *= 0xcc9e2d51u;
+    k = (k << 15) | (k >> 17);
+    k *= 0x1b873593u;
+
+    hash ^= k;
+    hash = (hash << 13) | (hash >> 19);
+    hash = hash * 5 + 0xe6546b64u;
+  }
+
+  for(; i < stride; ++i)
+  {
+    hash = (hash ^ vertex[i]) * 0x01000193u;
+  }
+
+  hash ^= hash >> 16;
+  hash *= 0x85ebca6bu;
+  hash ^= hash >> 13;
+  hash *= 0xc2b2ae35u;
+  hash ^= hash >> 16;
+
+  return hash;
+}
+
+GLenum
+packIndices(uint32_t *indices,
+            const size_t index_count,
+            const size_t vertex_count)
+{
+  if(vertex_count > 0xffff)
+  {
+    return GL_UNSIGNED_INT;
+  }
+
+  // Writing forward is safe, the 16bit write never passes the 32bit read.
+  uint16_t *short_indices = (uint16_t*)indices;
+
+  for(size_t i = 0; i < index_count; ++i)
+  {
+    short_indices[i] = (uint16_t)indices[i];
+  }
+
+  return GL_UNSIGNED_SHORT;
+}
+
+MeshIndexResult
+indexMesh(const void *vertices,
+          const size_t vertex_count,
+          const size_t vertex_stride,
+          void *out_vertices,
+          void *out_indices)
+{
+  MeshIndexResult result;
+  memset(&result, 0, sizeof(result));
+
+  const uint8_t *src = (const uint8_t*)vertices;
+  uint8_t *dst = (uint8_t*)out_vertices;
+  uint32_t *indices = (uint32_t*)out_indices;
+
+  // Open addressed with linear probing, the hash sits next to the index so
+  // most misses never touch the vertex data.
+  struct Slot
+  {
+    uint32_t hash;
+    uint32_t index;
+  };
+
+  constexpr uint32_t empty = 0xffffffffu;
+
+  // Sized for the unique count not the input count, typical meshes share
+  // each vertex several times so a smaller table stays in cache longer.
+  size_t capacity = 64;
+  while(capacity < vertex_count / 2)
+  {
+    capacity *= 2;
+  }
+
+  size_t mask = capacity - 1;
+  Slot *table = (Slot*)malloc(capacity * sizeof(Slot));
+  memset(table, 0xff, capacity * sizeof(Slot));
+
+  size_t unique = 0;
+
+  for(size_t i = 0; i < vertex_count; ++i)
+  {
+    // Grow past a load factor of a half.
+    if(unique * 2 >= capacity)
+    {
+      const size_t new_capacity = capacity * 2;
+      const size_t new_mask = new_capacity - 1;
+
+      Slot *new_table = (Slot*)malloc(new_capacity * sizeof(Slot));
+      memset(new_table, 0xff, new_capacity * sizeof(Slot));
+
+      for(size_t j = 0; j < capacity; ++j)
+      {
+        if(table[j].index != empty)
+        {
+          size_t slot = table[j].hash & new_mask;
+
+          while(new_table[slot].index != empty)
+          {
+            slot = (slot + 1) & new_mask;
+          }
+
+          new_table[slot] = table[j];
+        }
+      }
+
+      free(table);
+      table = new_table;
+      capacity = new_capacity;
+      mask = new_mask;
+    }
+
+    const uint8_t *vertex = src + i * vertex_stride;
+    const uint32_t hash = meshHashVertex(vertex, vertex_stride);
+    size_t slot = hash & mask;
+
+    while(true)
+    {
+      Slot &entry = table[slot];
+
+      if(entry.index == empty)
+      {
+        // Moving for when out_vertices aliases vertices.
+        memmove(dst + unique * vertex_stride, vertex, vertex_stride);
+
+        entry.hash = hash;
+        entry.index = (uint32_t)unique;
+        indices[i] = (uint32_t)unique;
+        ++unique;
+        break;
+      }
+
+      if(entry.hash == hash &&
+         memcmp(dst + entry.index * vertex_stride, vertex, vertex_stride) == 0)
+      {
+        indices[i] = entry.index;
+        break;
+      }
+
+      slot = (slot + 1) & mask;
+    }
+  }
+
+  free(table);
+
+  result.vertex_count = unique;
+  result.index_count = vertex_count;
+  result.index_type = packIndices(indices, vertex_count, unique);
+  result.index_size = result.index_type == GL_UNSIGNED_SHORT ? 2 : 4;
+
+  return result;
+}
+
+
+// ----------------------------------------------------------[ Vertex Cache ]--
+
+static inline uint32_t
+meshGetIndex(const void *indices, const GLenum index_type, const size_t i)
+{
+  return index_type == GL_UNSIGNED_SHORT ?
+    ((const uint16_t*)indices)[i] :
+    ((const uint32_t*)indices)[i];
+}
+
+static inline void
+meshSetIndex(void *indices,
+             const GLenum index_type,
+             const size_t i,
+             const uint32_t value)
+{
+  if(index_type == GL_UNSIGNED_SHORT)
+  {
+    ((uint16_t*)indices)[i] = (uint16_t)value;
+  }
+  else
+  {
+    ((uint32_t*)indices)[i] = value;
+  }
+}
+
+MeshCacheStats
+analyzeVertexCache(const void *indices,
+                   const size_t index_count,
+                   const GLenum index_type,
+                   const size_t vertex_count,
+                   const size_t cache_size)
+{
+  MeshCacheStats stats;
+  memset(&stats, 0, sizeof(stats));
+
+  // Each vertex remembers when it entered the FIFO, it is still cached if
+  // fewer than cache_size misses happened since.
+  size_t *entered = (size_t*)malloc(vertex_count * sizeof(size_t));
+  memset(entered, 0xff, vertex_count * sizeof(size_t));
+
+  size_t used = 0;
+  size_t misses = 0;
+
+  for(size_t i = 0; i < index_count; ++i)
+  {
+    const uint32_t v = meshGetIndex(indices, index_type, i);
+
+    if(entered[v] == (size_t)-1)
+    {
+      ++used;
+    }
+    else if(misses - entered[v] < cache_size)
+    {
+      continue;
+    }
+
+    entered[v] = misses++;
+  }
+
+  free(entered);
+
+  stats.transforms = misses;
+  stats.acmr = index_count >= 3 ? (float)misses / (float)(index_count / 3) : 0.f;
+  stats.atvr = used ? (float)misses / (float)used : 0.f;
+
+  return stats;
+}
+
+namespace {
+
+// Forsyth's scoring constants, the cache here is a simulated LRU.
+constexpr size_t forsyth_cache_size = 32;
+constexpr size_t forsyth_max_valence = 32;
+constexpr float forsyth_cache_decay_power = 1.5f;
+constexpr float forsyth_last_tri_score = 0.75f;
+constexpr float forsyth_valence_boost_scale = 2.f;
+constexpr float forsyth_valence_boost_power = 0.5f;
+
+struct ForsythTables
+{
+  float cache[forsyth_cache_size];
+  float valence[forsyth_max_valence];
+};
+
+} // anon ns
+
+static void
+forsythInitTables(ForsythTables &tables)
+{
+  for(size_t i = 0; i < forsyth_cache_size; ++i)
+  {
+    if(i < 3)
+    {
+      // Used by the last triangle, scored flat so the next pick doesn't
+      // favour any one edge of it.
+      tables.cache[i] = forsyth_last_tri_score;
+    }
+    else
+    {
+      const float scaler = 1.f / (float)(forsyth_cache_size - 3);
+      const float score = 1.f - (float)(i - 3) * scaler;
+
+      tables.cache[i] = powf(score, forsyth_cache_decay_power);
+    }
+  }
+
+  for(size_t i = 0; i < forsyth_max_valence; ++i)
+  {
+    tables.valence[i] = i ?
+      forsyth_valence_boost_scale * powf((float)i, -forsyth_valence_boost_power) :
+      0.f;
+  }
+}
+
+static inline float
+forsythScore(const ForsythTables &tables,
+             const int32_t cache_position,
+             const uint32_t remaining)
+{
+  if(!remaining)
+  {
+    // No triangles left, the vertex is no longer interesting.
+    return -1.f;
+  }
+
+  float score = cache_position < 0 ? 0.f : tables.cache[cache_position];
+
+  score += tables.valence[remaining < forsyth_max_valence ? remaining : forsyth_max_valence - 1];
+
+  return score;
+}
+
+void
+optimizeVertexCache(void *indices,
+                    const size_t index_count,
+                    const GLenum index_type,
+                    const size_t vertex_count)
+{
+  const size_t tri_count = index_count / 3;
+
+  if(!tri_count)
+  {
+    return;
+  }
+
+  ForsythTables tables;
+  forsythInitTables(tables);
+
+  uint32_t *tri_verts = (uint32_t*)malloc(tri_count * 3 * sizeof(uint32_t));
+
+  for(size_t i = 0; i < tri_count * 3; ++i)
+  {
+    tri_verts[i] = meshGetIndex(indices, index_type, i);
+  }
+
+  // Vertex to triangle adjacency, offsets are a prefix sum of valences.
+  uint32_t *remaining = (uint32_t*)calloc(vertex_count, sizeof(uint32_t));
+  uint32_t *offsets = (uint32_t*)malloc((vertex_count + 1) * sizeof(uint32_t));
+  uint32_t *adjacency = (uint32_t*)malloc(tri_count * 3 * sizeof(uint32_t));
+
+  for(size_t i = 0; i < tri_count * 3; ++i)
+  {
+    ++remaining[tri_verts[i]];
+  }
+
+  offsets[0] = 0;
+
+  for(size_t v = 0; v < vertex_count; ++v)
+  {
+    offsets[v + 1] = offsets[v] + remaining[v];
+  }
+
+  {
+    uint32_t *fill = (uint32_t*)malloc(vertex_count * sizeof(uint32_t));
+    memcpy(fill, offsets, vertex_count * sizeof(uint32_t));
+
+    for(size_t t = 0; t < tri_count; ++t)
+    {
+      for(size_t k = 0; k < 3; ++k)
+      {
+        adjacency[fill[tri_verts[t * 3 + k]]++] = (uint32_t)t;
+      }
+    }
+
+    free(fill);
+  }
+
+  float *vert_score = (float*)malloc(vertex_count * sizeof(float));
+
+  for(size_t v = 0; v < vertex_count; ++v)
+  {
+    vert_score[v] = forsythScore(tables, -1, remaining[v]);
+  }
+
+  float *tri_score = (float*)malloc(tri_count * sizeof(float));
+  uint8_t *tri_added = (uint8_t*)calloc(tri_count, sizeof(uint8_t));
+
+  size_t best_tri = 0;
+
+  for(size_t t = 0; t < tri_count; ++t)
+  {
+    const uint32_t *tv = &tri_verts[t * 3];
+    tri_score[t] = vert_score[tv[0]] + vert_score[tv[1]] + vert_score[tv[2]];
+
+    if(tri_score[t] > tri_score[best_tri])
+    {
+      best_tri = t;
+    }
+  }
+
+  // Three extra slots hold the vertices pushed out by the newest triangle.
+  uint32_t cache[forsyth_cache_size + 3];
+  size_t cache_count = 0;
+
+  size_t scan_cursor = 0;
+
+  for(size_t out = 0; out < tri_count; ++out)
+  {
+    const uint32_t *tv = &tri_verts[best_tri * 3];
+
+    for(size_t k = 0; k < 3; ++k)
+    {
+      meshSetIndex(indices, index_type, out * 3 + k, tv[k]);
+    }
+
+    tri_added[best_tri] = 1;
+
+    // Remove the triangle from its vertices adjacency lists.
+    for(size_t k = 0; k < 3; ++k)
+    {
+      const uint32_t v = tv[k];
+      uint32_t *list = &adjacency[offsets[v]];
+      const uint32_t count = remaining[v];
+
+      for(uint32_t j = 0; j < count; ++j)
+      {
+        if(list[j] == best_tri)
+        {
+          list[j] = list[count - 1];
+          break;
+        }
+      }
+
+      --remaining[v];
+    }
+
+    // Move the triangle's vertices to the front of the LRU.
+    uint32_t new_cache[forsyth_cache_size + 3];
+    size_t new_count = 0;
+
+    for(size_t k = 0; k < 3; ++k)
+    {
+      new_cache[new_count++] = tv[k];
+    }
+
+    for(size_t c = 0; c < cache_count; ++c)
+    {
+      const uint32_t v = cache[c];
+
+      if(v != tv[0] && v != tv[1] && v != tv[2])
+      {
+        new_cache[new_count++] = v;
+      }
+    }
+
+    // Rescore what is in the cache, including the ones about to fall out.
+    for(size_t c = 0; c < new_count; ++c)
+    {
+      const uint32_t v = new_cache[c];
+      const int32_t pos = c < forsyth_cache_size ? (int32_t)c : -1;
+
+      vert_score[v] = forsythScore(tables, pos, remaining[v]);
+    }
+
+    cache_count = new_count < forsyth_cache_size ? new_count : forsyth_cache_size;
+    memcpy(cache, new_cache, cache_count * sizeof(uint32_t));
+
+    // Only triangles touching the cache changed, best pick comes from them.
+    float best_score = -1.f;
+    best_tri = tri_count;
+
+    for(size_t c = 0; c < new_count; ++c)
+    {
+      const uint32_t v = new_cache[c];
+      const uint32_t *list = &adjacency[offsets[v]];
+
+      for(uint32_t j = 0; j < remaining[v]; ++j)
+      {
+        const uint32_t t = list[j];
+        const uint32_t *adj = &tri_verts[t * 3];
+
+        tri_score[t] = vert_score[adj[0]] + vert_score[adj[1]] + vert_score[adj[2]];
+
+        if(tri_score[t] > best_score)
+        {
+          best_score = tri_score[t];
+          best_tri = t;
+        }
+      }
+    }
+
+    // Nothing connected to the cache, continue with the next unused triangle
+    // in input order, keeps the whole pass linear.
+    if(best_tri == tri_count)
+    {
+      while(scan_cursor < tri_count && tri_added[scan_cursor])
+      {
+        ++scan_cursor;
+      }
+
+      best_tri = scan_cursor;
+    }
+  }
+
+  free(tri_added);
+  free(tri_score);
+  free(vert_score);
+  free(adjacency);
+  free(offsets);
+  free(remaining);
+  free(tri_verts);
+}
+
+namespace {
+
+struct OverdrawCluster
+{
+  float     key;
+  uint32_t  first;          // Triangle.
+  uint32_t  count;
+};
+
+int
+overdrawClusterCompare(const void *a, const void *b)
+{
+  const OverdrawCluster &x = *(const OverdrawCluster*)a;
+  const OverdrawCluster &y = *(const OverdrawCluster*)b;
+
+  // Biggest key first, ties keep their order so the result is stable.
+  if(x.key != y.key)
+  {
+    return x.key > y.key ? -1 : 1;
+  }
+
+  return x.first < y.first ? -1 : 1;
+}
+
+} // namespace
+
+void
+optimizeOverdraw(void *indices,
+                 const size_t index_count,
+                 const GLenum index_type,
+                 const void *vertices,
+                 const size_t vertex_count,
+                 const size_t vertex_stride,
+                 const size_t position_offset,
+                 const float threshold)
+{
+  const size_t tri_count = index_count / 3;
+
+  if(tri_count < 2)
+  {
+    return;
+  }
+
+  const uint8_t *base = (const uint8_t*)vertices + position_offset;
+  auto position = [&](const uint32_t v, float out[3])
+  {
+    memcpy(out, base + v * vertex_stride, 3 * sizeof(float));
+  };
+
+  // Same FIFO as analyzeVertexCache. Clusters get reordered so each starts
+  // cold, a vertex only counts as cached if it entered since epoch.
+  const size_t cache_size = 16;
+  size_t *entered = (size_t*)malloc(vertex_count * sizeof(size_t));
+  memset(entered, 0xff, vertex_count * sizeof(size_t));
+
+  size_t misses = 0;
+
+  auto triangleMisses = [&](const size_t t, const size_t epoch)
+  {
+    size_t tri_misses = 0;
+
+    for(size_t k = 0; k < 3; ++k)
+    {
+      const uint32_t v = meshGetIndex(indices, index_type, t * 3 + k);
+
+      if(entered[v] == (size_t)-1 || entered[v] < epoch || misses - entered[v] >= cache_size)
+      {
+        entered[v] = misses++;
+        tri_misses += 1;
+      }
+    }
+
+    return tri_misses;
+  };
+
+  // Hard boundaries where the cache starts over, every vertex a miss, then
+  // soft ones inside those wherever a cluster's cold ACMR so far is within
+  // threshold of the whole run's.
+  OverdrawCluster *clusters = (OverdrawCluster*)malloc(tri_count * sizeof(OverdrawCluster));
+  size_t cluster_count = 0;
+
+  for(size_t start = 0; start < tri_count;)
+  {
+    size_t epoch = misses;
+    size_t end = start + 1;
+    size_t run_misses = triangleMisses(start, epoch);
+
+    while(end < tri_count)
+    {
+      const size_t tri_misses = triangleMisses(end, epoch);
+
+      if(tri_misses == 3)
+      {
+        break;
+      }
+
+      run_misses += tri_misses;
+      ++end;
+    }
+
+    const float run_acmr = (float)run_misses / (float)(end - start);
+    size_t first = start;
+    size_t cluster_misses = 0;
+
+    epoch = misses;
+
+    for(size_t t = start; t < end; ++t)
+    {
+      cluster_misses += triangleMisses(t, epoch);
+
+      const size_t size = t + 1 - first;
+
+      if(t + 1 == end || (size >= 8 && (float)cluster_misses / (float)size <= run_acmr * threshold))
+      {
+        clusters[cluster_count++] = {0.f, (uint32_t)first, (uint32_t)size};
+        first = t + 1;
+        cluster_misses = 0;
+        epoch = misses;
+      }
+    }
+
+    start = end;
+  }
+
+  free(entered);
+
+  // Area weighted centroid of the mesh and of each cluster, plus the
+  // cluster's summed normal.
+  float *cluster_data = (float*)calloc(cluster_count * 7, sizeof(float));
+  float mesh_centroid[3] = {0.f, 0.f, 0.f};
+  float mesh_area = 0.f;
+
+  for(size_t c = 0; c < cluster_count; ++c)
+  {
+    float *data = cluster_data + c * 7;
+
+    for(size_t t = clusters[c].first; t < clusters[c].first + clusters[c].count; ++t)
+    {
+      float p0[3], p1[3], p2[3];
+      position(meshGetIndex(indices, index_type, t * 3 + 0), p0);
+      position(meshGetIndex(indices, index_type, t * 3 + 1), p1);
+      position(meshGetIndex(indices, index_type, t * 3 + 2), p2);
+
+      const float e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+      const float e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+      const float n[3] = {e1[1] * e2[2] - e1[2] * e2[1],
+                          e1[2] * e2[0] - e1[0] * e2[2],
+                          e1[0] * e2[1] - e1[1] * e2[0]};
+      const float area = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+      for(size_t k = 0; k < 3; ++k)
+      {
+        const float centre = (p0[k] + p1[k] + p2[k]) / 3.f;
+
+        data[k] += centre * area;
+        data[3 + k] += n[k];
+      }
+
+      data[6] += area;
+    }
+
+    for(size_t k = 0; k < 3; ++k)
+    {
+      mesh_centroid[k] += data[k];
+    }
+
+    mesh_area += data[6];
+  }
+
+  for(size_t k = 0; mesh_area > 0.f && k < 3; ++k)
+  {
+    mesh_centroid[k] /= mesh_area;
+  }
+
+  // Clusters further out along their own normal draw first.
+  for(size_t c = 0; c < cluster_count; ++c)
+  {
+    const float *data = cluster_data + c * 7;
+    const float len = sqrtf(data[3] * data[3] + data[4] * data[4] + data[5] * data[5]);
+    float key = 0.f;
+
+    for(size_t k = 0; data[6] > 0.f && len > 0.f && k < 3; ++k)
+    {
+      key += (data[k] / data[6] - mesh_centroid[k]) * (data[3 + k] / len);
+    }
+
+    clusters[c].key = key;
+  }
+
+  free(cluster_data);
+
+  qsort(clusters, cluster_count, sizeof(OverdrawCluster), overdrawClusterCompare);
+
+  const size_t index_size = index_type == GL_UNSIGNED_SHORT ? 2 : 4;
+  uint8_t *copy = (uint8_t*)malloc(tri_count * 3 * index_size);
+  memcpy(copy, indices, tri_count * 3 * index_size);
+
+  uint8_t *dst = (uint8_t*)indices;
+
+  for(size_t c = 0; c < cluster_count; ++c)
+  {
+    const size_t bytes = clusters[c].count * 3 * index_size;
+
+    memcpy(dst, copy + clusters[c].first * 3 * index_size, bytes);
+    dst += bytes;
+  }
+
+  free(copy);
+  free(clusters);
+}
+
+size_t
+optimizeVertexFetch(void *vertices,
+                    const size_t vertex_count,
+                    const size_t vertex_stride,
+                    void *indices,
+                    const size_t index_count,
+                    const GLenum index_type)
+{
+  uint32_t *remap = (uint32_t*)malloc(vertex_count * sizeof(uint32_t));
+  memset(remap, 0xff, vertex_count * sizeof(uint32_t));
+
+  uint8_t *copy = (uint8_t*)malloc(vertex_count * vertex_stride);
+  memcpy(copy, vertices, vertex_count * vertex_stride);
+
+  uint8_t *dst = (uint8_t*)vertices;
+  uint32_t next = 0;
+
+  for(size_t i = 0; i < index_count; ++i)
+  {
+    const uint32_t v = meshGetIndex(indices, index_type, i);
+
+    if(remap[v] == 0xffffffffu)
+    {
+      memcpy(dst + next * vertex_stride, copy + v * vertex_stride, vertex_stride);
+      remap[v] = next++;
+    }
+
+    meshSetIndex(indices, index_type, i, remap[v]);
+  }
+
+  free(copy);
+  free(remap);
+
+  return next;
+}
+
+MeshOptimizeResult
+optimizeMesh(void *vertices,
+             const size_t vertex_count,
+             const size_t vertex_stride,
+             void *indices,
+             const size_t index_count,
+             const GLenum index_type,
+             const size_t position_offset)
+{
+  MeshOptimizeResult result;
+
+  result.before = analyzeVertexCache(indices, index_count, index_type, vertex_count);
+
+  optimizeVertexCache(indices, index_count, index_type, vertex_count);
+
+  if(position_offset != mesh_no_position)
+  {
+    optimizeOverdraw(indices,
+                     index_count,
+                     index_type,
+                     vertices,
+                     vertex_count,
+                     vertex_stride,
+                     position_offset);
+  }
+
+  result.vertex_count = optimizeVertexFetch(vertices,
+                                            vertex_count,
+                                            vertex_stride,
+                                            indices,
+                                            index_count,
+                                            index_type);
+
+  result.after = analyzeVertexCache(indices, index_count, index_type, result.vertex_count);
+
+  return result;
+}
+
+
+#endif // impl guard
@@ -0,0 +1,479 @@
+#ifndef THIN_OGL_ATLAS_INCLUDED_
+#define THIN_OGL_ATLAS_INCLUDED_
+
+
+/*
+  Packs many small images into the layers of one GL_TEXTURE_2D_ARRAY so
+  they draw from a single binding. Each image goes into its rect with a
+  skyline bottom left packer and a sub image upload, adding one never
+  touches the texels already in the atlas.
+
+  Layers are allocated up front, when they are full atlasAdd fails. Rects
+  can't be freed one at a time, atlasClear starts the packing over.
+*/
+
+
+#include "ogl_device.hpp"
+
+
+// -----------------------------------------------------------------[ Atlas ]--
+
+struct AtlasDesc
+{
+  GLenum    internal_format;  // Sized, zero is GL_RGBA8.
+  GLsizei   width;
+  GLsizei   height;
+  GLsizei   layers;           // Zero is one.
+  GLsizei   padding;          // Texels of edge copied around each rect.
+  GLenum    min_filter;       // Zero is GL_LINEAR, the atlas has no mips.
+  GLenum    mag_filter;
+  GLenum    data_format;      // Of the pixels given to atlasAdd, zero is
+  GLenum    data_type;        // GL_RGBA and GL_UNSIGNED_BYTE.
+};
+
+/*
+  Where an image landed. Sample with uv * uv_scale + uv_offset and layer as
+  the third coordinate.
+*/
+struct AtlasRect
+{
+  GLint     layer;
+  GLint     x;
+  GLint     y;
+  GLsizei   width;
+  GLsizei   height;
+  float     uv_offset[2];
+  float     uv_scale[2];
+};
+
+struct AtlasSkyline
+{
+  GLint     x;
+  GLint     y;
+  GLsizei   width;
+};
+
+struct AtlasLayer
+{
+  AtlasSkyline  *nodes;       // Left to right, covering the full width.
+  size_t        node_count;
+  size_t        node_capacity;
+  uint64_t      used_area;
+};
+
+struct Atlas
+{
+  Device        *device;
+  uintptr_t     texture;
+  AtlasDesc     desc;
+  size_t        pixel_bytes;
+  AtlasLayer    *layers;
+  uint8_t       *scratch;     // Padded copy of the image being added.
+  size_t        scratch_size;
+};
+
+bool
+createAtlas(Atlas *out_atlas, Device *device, const AtlasDesc &desc);
+
+void
+destroyAtlas(Atlas *atlas);
+
+/*
+  Packs and uploads one image, pixels rows aligned to 4. False when no
+  layer has room.
+*/
+bool
+atlasAdd(Atlas *atlas,
+         const GLsizei width,
+         const GLsizei height,
+         const GLvoid *pixels,
+         AtlasRect *out_rect);
+
+/*
+  Forgets every rect, their texels stay until something is packed over
+  them.
+*/
+void
+atlasClear(Atlas *atlas);
+
+/*
+  Fraction of the atlas' texels in use, padding included.
+*/
+float
+atlasOccupancy(const Atlas *atlas);
+
+
+#endif // inc guard
+
+
+#if defined(THIN_ATLAS_IMPL) && !defined(THIN_ATLAS_IMPL_INCLUDED_)
+#define THIN_ATLAS_IMPL_INCLUDED_
+
+#include <stdlib.h>
+#include <string.h>
+
+
+// ---------------------------------------------------------------[ Skyline ]--
+
+static void
+atlasResetLayer(AtlasLayer *layer, const GLsizei width)
+{
+  layer->nodes[0].x = 0;
+  layer->nodes[0].y = 0;
+  layer->nodes[0].width = width;
+  layer->node_count = 1;
+  layer->used_area = 0;
+}
+
+/*
+  Lowest y a width x height rect can sit at with its left edge on node
+  index, false if it pokes out of the layer.
+*/
+static bool
+atlasSkylineFit(const Atlas *atlas,
+                const AtlasLayer *layer,
+                const size_t index,
+                const GLsizei width,
+                const GLsizei height,
+                GLint *out_y)
+{
+  const AtlasSkyline *nodes = layer->nodes;
+
+  if(nodes[index].x + width > atlas->desc.width)
+  {
+    return false;
+  }
+
+  GLint y = 0;
+  GLsizei remaining = width;
+
+  for(size_t i = index; remaining > 0; ++i)
+  {
+    y = nodes[i].y > y ? nodes[i].y : y;
+
+    if(y + height > atlas->desc.height)
+    {
+      return false;
+    }
+
+    remaining -= nodes[i].width < remaining ? nodes[i].width : remaining;
+  }
+
+  *out_y = y;
+  return true;
+}
+
+static void
+atlasSkylineInsert(AtlasLayer *layer,
+                   const size_t index,
+                   const GLint x,
+                   const GLint y,
+                   const GLsizei width)
+{
+  if(layer->node_count == layer->node_capacity)
+  {
+    layer->node_capacity *= 2;
+    layer->nodes = (AtlasSkyline*)realloc(layer->nodes, layer->node_capacity * sizeof(AtlasSkyline));
+  }
+
+  AtlasSkyline *nodes = layer->nodes;
+
+  memmove(nodes + index + 1, nodes + index, (layer->node_count - index) * sizeof(AtlasSkyline));
+  nodes[index].x = x;
+  nodes[index].y = y;
+  nodes[index].width = width;
+  layer->node_count += 1;
+
+  // Trim the nodes the new one now covers.
+  for(size_t i = index + 1; i < layer->node_count;)
+  {
+    const GLint prev_end = nodes[i - 1].x + nodes[i - 1].width;
+
+    if(nodes[i].x >= prev_end)
+    {
+      break;
+    }
+
+    const GLsizei shrink = prev_end - nodes[i].x;
+
+    if(nodes[i].width > shrink)
+    {
+      nodes[i].x += shrink;
+      nodes[i].width -= shrink;
+      break;
+    }
+
+    memmove(nodes + i, nodes + i + 1, (layer->node_count - i - 1) * sizeof(AtlasSkyline));
+    layer->node_count -= 1;
+  }
+
+  // Neighbours at the same height become one.
+  for(size_t i = 0; i + 1 < layer->node_count;)
+  {
+    if(nodes[i].y == nodes[i + 1].y)
+    {
+      nodes[i].width += nodes[i + 1].width;
+      memmove(nodes + i + 1, nodes + i + 2, (layer->node_count - i - 2) * sizeof(AtlasSkyline));
+      layer->node_count -= 1;
+    }
+    else
+    {
+      ++i;
+    }
+  }
+}
+
+
+// ----------------------------------------------------------------[ Upload ]--
+
+/*
+  Copies the image into scratch with its edge texels repeated padding
+  times on every side, so filtering at the rect's border doesn't pull in
+  the neighbours.
+*/
+static const GLvoid *
+atlasPadImage(Atlas *atlas,
+              const GLsizei width,
+              const GLsizei height,
+              const GLvoid *pixels)
+{
+  const GLsizei padding = atlas->desc.padding;
+  const GLsizei padded_width = width + padding * 2;
+  const GLsizei padded_height = height + padding * 2;
+  const size_t pixel_bytes = atlas->pixel_bytes;
+
+  const size_t src_stride = pixelDataSize(width, 1, atlas->desc.data_format, atlas->desc.data_type);
+  const size_t dst_stride = pixelDataSize(padded_width, 1, atlas->desc.data_format, atlas->desc.data_type);
+  const size_t size = dst_stride * padded_height;
+
+  if(size > atlas->scratch_size)
+  {
+    atlas->scratch = (uint8_t*)realloc(atlas->scratch, size);
+    atlas->scratch_size = size;
+  }
+
+  for(GLsizei y = 0; y < padded_height; ++y)
+  {
+    const GLsizei sy = y < padding ? 0 : y - padding >= height ? height - 1 : y - padding;
+    const uint8_t *src = (const uint8_t*)pixels + sy * src_stride;
+    uint8_t *dst = atlas->scratch + y * dst_stride;
+
+    for(GLsizei x = 0; x < padding; ++x)
+    {
+      memcpy(dst + x * pixel_bytes, src, pixel_bytes);
+      memcpy(dst + (padding + width + x) * pixel_bytes, src + (width - 1) * pixel_bytes, pixel_bytes);
+    }
+
+    memcpy(dst + padding * pixel_bytes, src, width * pixel_bytes);
+  }
+
+  return atlas->scratch;
+}
+
+
+// -----------------------------------------------------------------[ Atlas ]--
+
+bool
+createAtlas(Atlas *out_atlas, Device *device, const AtlasDesc &desc)
+{
+  memset(out_atlas, 0, sizeof(Atlas));
+
+  Atlas *atlas = out_atlas;
+  atlas->device = device;
+  atlas->desc = desc;
+
+  AtlasDesc &d = atlas->desc;
+  d.internal_format = d.internal_format ? d.internal_format : GL_RGBA8;
+  d.layers = d.layers > 0 ? d.layers : 1;
+  d.padding = d.padding > 0 ? d.padding : 0;
+  d.data_format = d.data_format ? d.data_format : GL_RGBA;
+  d.data_type = d.data_type ? d.data_type : GL_UNSIGNED_BYTE;
+
+  // Rows of 4 texels have no alignment padding.
+  atlas->pixel_bytes = pixelDataSize(4, 1, d.data_format, d.data_type) / 4;
+
+  if(d.width <= 0 || d.height <= 0 || atlas->pixel_bytes == 0)
+  {
+    if(device->curr_error_callback)
+    {
+      device->curr_error_callback("Atlas desc has no size or an unknown data format");
+    }
+
+    return false;
+  }
+
+  TextureDesc texture_desc = {};
+  texture_desc.internal_format = d.internal_format;
+  texture_desc.width = d.width;
+  texture_desc.height = d.height;
+  texture_desc.layers = d.layers;
+  texture_desc.array = true;
+  texture_desc.mip_count = 1;
+  texture_desc.min_filter = d.min_filter;
+  texture_desc.mag_filter = d.mag_filter;
+  texture_desc.wrap_s = GL_CLAMP_TO_EDGE;
+  texture_desc.wrap_t = GL_CLAMP_TO_EDGE;
+  texture_desc.data_format = d.data_format;
+  texture_desc.data_type = d.data_type;
+
+  atlas->texture = device->createTexture2D(texture_desc);
+
+  if(!atlas->texture)
+  {
+    return false;
+  }
+
+  atlas->layers = (AtlasLayer*)calloc(d.layers, sizeof(AtlasLayer));
+
+  for(GLsizei i = 0; i < d.layers; ++i)
+  {
+    atlas->layers[i].node_capacity = 16;
+    atlas->layers[i].nodes = (AtlasSkyline*)malloc(16 * sizeof(AtlasSkyline));
+    atlasResetLayer(&atlas->layers[i], d.width);
+  }
+
+  return true;
+}
+
+void
+destroyAtlas(Atlas *atlas)
+{
+  if(atlas->texture)
+  {
+    atlas->device->deleteTexture(atlas->texture);
+  }
+
+  for(GLsizei i = 0; atlas->layers && i < atlas->desc.layers; ++i)
+  {
+    free(atlas->layers[i].nodes);
+  }
+
+  free(atlas->layers);
+  free(atlas->scratch);
+
+  memset(atlas, 0, sizeof(Atlas));
+}
+
+bool
+atlasAdd(Atlas *atlas,
+         const GLsizei width,
+         const GLsizei height,
+         const GLvoid *pixels,
+         AtlasRect *out_rect)
+{
+  if(width <= 0 || height <= 0)
+  {
+    return false;
+  }
+
+  const GLsizei padding = atlas->desc.padding;
+  const GLsizei padded_width = width + padding * 2;
+  const GLsizei padded_height = height + padding * 2;
+
+  // Bottom left, the earliest layer where the rect's top is lowest,
+  // narrower nodes break ties.
+  GLsizei best_layer = -1;
+  size_t best_index = 0;
+  GLint best_y = 0;
+  GLint best_top = 0;
+  GLsizei best_node_width = 0;
+
+  for(GLsizei l = 0; l < atlas->desc.layers && best_layer < 0; ++l)
+  {
+    const AtlasLayer *layer = &atlas->layers[l];
+
+    for(size_t i = 0; i < layer->node_count; ++i)
+    {
+      GLint y = 0;
+
+      if(!atlasSkylineFit(atlas, layer, i, padded_width, padded_height, &y))
+      {
+        continue;
+      }
+
+      const GLint top = y + padded_height;
+
+      if(best_layer < 0 || top < best_top ||
+         (top == best_top && layer->nodes[i].width < best_node_width))
+      {
+        best_layer = l;
+        best_index = i;
+        best_y = y;
+        best_top = top;
+        best_node_width = layer->nodes[i].width;
+      }
+    }
+  }
+
+  if(best_layer < 0)
+  {
+    return false;
+  }
+
+  AtlasLayer *layer = &atlas->layers[best_layer];
+  const GLint x = layer->nodes[best_index].x;
+
+  atlasSkylineInsert(layer, best_index, x, best_top, padded_width);
+  layer->used_area += (uint64_t)padded_width * padded_height;
+
+  if(pixels)
+  {
+    const GLvoid *upload = padding ? atlasPadImage(atlas, width, height, pixels) : pixels;
+    Device *device = atlas->device;
+
+    device->bindTexture(GL_TEXTURE_2D_ARRAY, atlas->texture);
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, x, best_y, best_layer,
+                    padded_width, padded_height, 1,
+                    atlas->desc.data_format, atlas->desc.data_type, upload);
+
+    device->stats.bytes_uploaded += pixelDataSize(padded_width, padded_height,
+                                                  atlas->desc.data_format,
+                                                  atlas->desc.data_type);
+
+    #ifdef THIN_EXTRA_ERROR_CHECKS
+    device->getError("Atlas Add");
+    #endif
+  }
+
+  if(out_rect)
+  {
+    out_rect->layer = best_layer;
+    out_rect->x = x + padding;
+    out_rect->y = best_y + padding;
+    out_rect->width = width;
+    out_rect->height = height;
+    out_rect->uv_offset[0] = (float)out_rect->x / atlas->desc.width;
+    out_rect->uv_offset[1] = (float)out_rect->y / atlas->desc.height;
+    out_rect->uv_scale[0] = (float)width / atlas->desc.width;
+    out_rect->uv_scale[1] = (float)height / atlas->desc.height;
+  }
+
+  return true;
+}
+
+void
+atlasClear(Atlas *atlas)
+{
+  for(GLsizei i = 0; i < atlas->desc.layers; ++i)
+  {
+    atlasResetLayer(&atlas->layers[i], atlas->desc.width);
+  }
+}
+
+float
+atlasOccupancy(const Atlas *atlas)
+{
+  uint64_t used = 0;
+
+  for(GLsizei i = 0; i < atlas->desc.layers; ++i)
+  {
+    used += atlas->layers[i].used_area;
+  }
+
+  const uint64_t total = (uint64_t)atlas->desc.width * atlas->desc.height * atlas->desc.layers;
+
+  return total ? (float)used / total : 0.f;
+}
+
+
+#endif // impl guard
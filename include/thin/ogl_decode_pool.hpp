@@ -0,0 +1,635 @@
+#ifndef THIN_OGL_DECODE_POOL_INCLUDED_
+#define THIN_OGL_DECODE_POOL_INCLUDED_
+
+
+/*
+  Worker threads that read image files, decode them, widen them to RGBA and
+  build their mips, then hand them back to the render thread through a
+  lock free queue. decodePoolUpload creates the textures and streams rows
+  through Device::uploadTexture2D up to a byte budget a frame, so a burst
+  of loads costs the render thread a fixed slice each frame instead of one
+  long stall.
+
+  Decoding itself is the caller's, stb_image or anything else, and must be
+  safe to call from several threads at once. Needs image.hpp's impl in the
+  build and -pthread.
+*/
+
+
+#include "ogl_device.hpp"
+#include "image.hpp"
+
+
+// -----------------------------------------------------------[ Decode Pool ]--
+
+struct DecodedImage
+{
+  uint8_t   *pixels;
+  GLsizei   width;
+  GLsizei   height;
+  int       channels;         // 3 or 4, 8 bits each.
+};
+
+using image_decode_fn = bool(*)(void *user, const uint8_t *bytes, const size_t size, DecodedImage *out_image);
+using image_free_fn = void(*)(void *user, uint8_t *pixels);
+
+/*
+  Called on the render thread from decodePoolUpload once every level is
+  in, texture is zero when the file couldn't be read or decoded.
+*/
+using texture_ready_fn = void(*)(void *user, const uintptr_t texture);
+
+struct DecodePoolDesc
+{
+  image_decode_fn decode;
+  image_free_fn   free_pixels;    // For DecodedImage::pixels.
+  void            *user;
+  unsigned        thread_count;   // Zero is one less than the hardware has.
+  size_t          ready_capacity; // Decoded images waiting on upload, zero
+                                  // is 16. Workers wait when it's full.
+};
+
+struct DecodeRequest
+{
+  const char        *path;        // Copied.
+  bool              srgb;         // GL_SRGB8_ALPHA8, mips in linear space.
+  bool              mips;
+  bool              premultiply;
+  texture_ready_fn  ready;
+  void              *ready_user;
+};
+
+struct DecodePool;
+
+DecodePool*
+createDecodePool(Device *device, const DecodePoolDesc &desc);
+
+/*
+  Render thread. Stops the workers, drops whatever hasn't been uploaded and
+  deletes the texture of a half done upload, ready isn't called for those.
+*/
+void
+destroyDecodePool(DecodePool *pool);
+
+/*
+  Queues a file, any thread.
+*/
+void
+decodePoolLoad(DecodePool *pool, const DecodeRequest &request);
+
+/*
+  Render thread, once a frame. Uploads up to budget_bytes of decoded pixels,
+  at least one row so a tiny budget still makes progress, and calls ready
+  for the textures it finishes. Returns the bytes uploaded.
+*/
+size_t
+decodePoolUpload(DecodePool *pool, const size_t budget_bytes);
+
+/*
+  Requests not yet handed to ready.
+*/
+size_t
+decodePoolPending(const DecodePool *pool);
+
+
+#endif // inc guard
+
+
+#if defined(THIN_DECODE_POOL_IMPL) && !defined(THIN_DECODE_POOL_IMPL_INCLUDED_)
+#define THIN_DECODE_POOL_IMPL_INCLUDED_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+
+// ---------------------------------------------------------[ Decode Queues ]--
+
+struct DecodeJob
+{
+  char              *path;
+  bool              srgb;
+  bool              mips;
+  bool              premultiply;
+  texture_ready_fn  ready;
+  void              *ready_user;
+
+  // Filled by the worker, level 0 then the rest of the chain.
+  uint8_t           *pixels;
+  GLsizei           width;
+  GLsizei           height;
+  GLsizei           mip_count;
+
+  // Upload progress on the render thread.
+  uintptr_t         texture;
+  GLsizei           level;
+  GLsizei           row;
+  size_t            level_offset;
+};
+
+/*
+  Bounded many producer many consumer ring, each cell's sequence says whose
+  turn it is. Workers push, the render thread pops, neither takes a lock.
+*/
+struct DecodeCell
+{
+  std::atomic<size_t> sequence;
+  DecodeJob           *job;
+};
+
+struct DecodeReadyQueue
+{
+  DecodeCell          *cells;
+  size_t              mask;
+  std::atomic<size_t> head;
+  std::atomic<size_t> tail;
+};
+
+static bool
+decodeQueuePush(DecodeReadyQueue *queue, DecodeJob *job)
+{
+  size_t pos = queue->tail.load(std::memory_order_relaxed);
+  DecodeCell *cell = nullptr;
+
+  for(;;)
+  {
+    cell = &queue->cells[pos & queue->mask];
+
+    const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+    const intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+
+    if(diff == 0)
+    {
+      if(queue->tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+      {
+        break;
+      }
+    }
+    else if(diff < 0)
+    {
+      return false;
+    }
+    else
+    {
+      pos = queue->tail.load(std::memory_order_relaxed);
+    }
+  }
+
+  cell->job = job;
+  cell->sequence.store(pos + 1, std::memory_order_release);
+
+  return true;
+}
+
+static DecodeJob*
+decodeQueuePop(DecodeReadyQueue *queue)
+{
+  size_t pos = queue->head.load(std::memory_order_relaxed);
+  DecodeCell *cell = nullptr;
+
+  for(;;)
+  {
+    cell = &queue->cells[pos & queue->mask];
+
+    const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+    const intptr_t diff = (intptr_t)sequence - (intptr_t)(pos + 1);
+
+    if(diff == 0)
+    {
+      if(queue->head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+      {
+        break;
+      }
+    }
+    else if(diff < 0)
+    {
+      return nullptr;
+    }
+    else
+    {
+      pos = queue->head.load(std::memory_order_relaxed);
+    }
+  }
+
+  DecodeJob *job = cell->job;
+  cell->sequence.store(pos + queue->mask + 1, std::memory_order_release);
+
+  return job;
+}
+
+
+// -----------------------------------------------------------[ Decode Pool ]--
+
+struct DecodePool
+{
+  Device                  *device;
+  DecodePoolDesc          desc;
+
+  std::thread             *threads;
+  unsigned                thread_count;
+
+  // Requests for the workers, a growing ring under the mutex.
+  std::mutex              mutex;
+  std::condition_variable wake;
+  DecodeJob               **requests;
+  size_t                  request_head;
+  size_t                  request_count;
+  size_t                  request_capacity;
+  std::atomic<bool>       quit;
+
+  DecodeReadyQueue        ready;
+  DecodeJob               *uploading;
+  std::atomic<size_t>     pending;
+};
+
+static void
+decodeFreeJob(DecodeJob *job)
+{
+  free(job->pixels);
+  free(job->path);
+  free(job);
+}
+
+static uint8_t*
+decodeReadFile(const char *path, size_t *out_size)
+{
+  FILE *file = fopen(path, "rb");
+
+  if(!file)
+  {
+    return nullptr;
+  }
+
+  uint8_t *bytes = nullptr;
+  long size = 0;
+
+  if(fseek(file, 0, SEEK_END) == 0 && (size = ftell(file)) > 0 && fseek(file, 0, SEEK_SET) == 0)
+  {
+    bytes = (uint8_t*)malloc((size_t)size);
+
+    if(fread(bytes, 1, (size_t)size, file) != (size_t)size)
+    {
+      free(bytes);
+      bytes = nullptr;
+    }
+  }
+
+  fclose(file);
+  *out_size = (size_t)size;
+
+  return bytes;
+}
+
+/*
+  Everything between the request and the upload, on a worker. Leaves
+  pixels null on failure.
+*/
+static void
+decodeProcess(DecodePool *pool, DecodeJob *job)
+{
+  size_t size = 0;
+  uint8_t *bytes = decodeReadFile(job->path, &size);
+
+  if(!bytes)
+  {
+    return;
+  }
+
+  DecodedImage image = {};
+  const bool decoded = pool->desc.decode(pool->desc.user, bytes, size, &image);
+
+  free(bytes);
+
+  if(!decoded || !image.pixels)
+  {
+    return;
+  }
+
+  if(image.width > 0 && image.height > 0 && (image.channels == 3 || image.channels == 4))
+  {
+    const size_t width = (size_t)image.width;
+    const size_t height = (size_t)image.height;
+    const size_t chain_size = job->mips ? imageMipChainSize(width, height) : width * height * 4;
+
+    job->pixels = (uint8_t*)malloc(chain_size);
+    job->width = image.width;
+    job->height = image.height;
+    job->mip_count = 1;
+
+    if(image.channels == 3)
+    {
+      imageRGBToRGBA(image.pixels, job->pixels, width, height);
+    }
+    else
+    {
+      memcpy(job->pixels, image.pixels, width * height * 4);
+    }
+  }
+
+  pool->desc.free_pixels(pool->desc.user, image.pixels);
+
+  if(!job->pixels)
+  {
+    return;
+  }
+
+  if(job->premultiply)
+  {
+    imagePremultiplyAlpha(job->pixels, job->width, job->height);
+  }
+
+  if(job->mips)
+  {
+    job->mip_count = (GLsizei)imageMipChain(job->pixels, job->width, job->height,
+                                            ImageFilter::box, job->srgb);
+  }
+}
+
+static void
+decodeWorker(DecodePool *pool)
+{
+  for(;;)
+  {
+    DecodeJob *job = nullptr;
+
+    {
+      std::unique_lock<std::mutex> lock(pool->mutex);
+      pool->wake.wait(lock, [pool] { return pool->quit || pool->request_count > 0; });
+
+      if(pool->quit)
+      {
+        return;
+      }
+
+      job = pool->requests[pool->request_head];
+      pool->request_head = (pool->request_head + 1) % pool->request_capacity;
+      pool->request_count -= 1;
+    }
+
+    decodeProcess(pool, job);
+
+    // Full means the render thread is behind on uploads, back off until it
+    // catches up rather than decode further ahead.
+    while(!decodeQueuePush(&pool->ready, job))
+    {
+      if(pool->quit)
+      {
+        decodeFreeJob(job);
+        return;
+      }
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+}
+
+DecodePool*
+createDecodePool(Device *device, const DecodePoolDesc &desc)
+{
+  DecodePool *pool = new DecodePool();
+  pool->device = device;
+  pool->desc = desc;
+
+  size_t capacity = 1;
+
+  while(capacity < (desc.ready_capacity ? desc.ready_capacity : 16))
+  {
+    capacity <<= 1;
+  }
+
+  pool->ready.cells = new DecodeCell[capacity];
+  pool->ready.mask = capacity - 1;
+  pool->ready.head = 0;
+  pool->ready.tail = 0;
+
+  for(size_t i = 0; i < capacity; ++i)
+  {
+    pool->ready.cells[i].sequence.store(i, std::memory_order_relaxed);
+    pool->ready.cells[i].job = nullptr;
+  }
+
+  pool->request_capacity = 64;
+  pool->requests = (DecodeJob**)malloc(pool->request_capacity * sizeof(DecodeJob*));
+
+  const unsigned hardware = std::thread::hardware_concurrency();
+  unsigned thread_count = desc.thread_count ? desc.thread_count :
+                          hardware > 1 ? hardware - 1 : 1;
+
+  pool->thread_count = thread_count;
+  pool->threads = new std::thread[thread_count];
+
+  for(unsigned i = 0; i < thread_count; ++i)
+  {
+    pool->threads[i] = std::thread(decodeWorker, pool);
+  }
+
+  return pool;
+}
+
+void
+destroyDecodePool(DecodePool *pool)
+{
+  {
+    std::lock_guard<std::mutex> lock(pool->mutex);
+    pool->quit = true;
+  }
+
+  pool->wake.notify_all();
+
+  for(unsigned i = 0; i < pool->thread_count; ++i)
+  {
+    pool->threads[i].join();
+  }
+
+  for(size_t i = 0; i < pool->request_count; ++i)
+  {
+    decodeFreeJob(pool->requests[(pool->request_head + i) % pool->request_capacity]);
+  }
+
+  while(DecodeJob *job = decodeQueuePop(&pool->ready))
+  {
+    decodeFreeJob(job);
+  }
+
+  if(pool->uploading)
+  {
+    if(pool->uploading->texture)
+    {
+      pool->device->deleteTexture(pool->uploading->texture);
+    }
+
+    decodeFreeJob(pool->uploading);
+  }
+
+  delete[] pool->threads;
+  delete[] pool->ready.cells;
+  free(pool->requests);
+
+  delete pool;
+}
+
+void
+decodePoolLoad(DecodePool *pool, const DecodeRequest &request)
+{
+  DecodeJob *job = (DecodeJob*)calloc(1, sizeof(DecodeJob));
+
+  const size_t path_size = strlen(request.path) + 1;
+  job->path = (char*)malloc(path_size);
+  memcpy(job->path, request.path, path_size);
+
+  job->srgb = request.srgb;
+  job->mips = request.mips;
+  job->premultiply = request.premultiply;
+  job->ready = request.ready;
+  job->ready_user = request.ready_user;
+
+  pool->pending.fetch_add(1, std::memory_order_relaxed);
+
+  {
+    std::lock_guard<std::mutex> lock(pool->mutex);
+
+    if(pool->request_count == pool->request_capacity)
+    {
+      // Unwrap into the bigger ring.
+      const size_t capacity = pool->request_capacity * 2;
+      DecodeJob **requests = (DecodeJob**)malloc(capacity * sizeof(DecodeJob*));
+
+      for(size_t i = 0; i < pool->request_count; ++i)
+      {
+        requests[i] = pool->requests[(pool->request_head + i) % pool->request_capacity];
+      }
+
+      free(pool->requests);
+      pool->requests = requests;
+      pool->request_head = 0;
+      pool->request_capacity = capacity;
+    }
+
+    const size_t tail = (pool->request_head + pool->request_count) % pool->request_capacity;
+    pool->requests[tail] = job;
+    pool->request_count += 1;
+  }
+
+  pool->wake.notify_one();
+}
+
+size_t
+decodePoolUpload(DecodePool *pool, const size_t budget_bytes)
+{
+  Device *device = pool->device;
+  size_t uploaded = 0;
+
+  while(uploaded < budget_bytes || uploaded == 0)
+  {
+    DecodeJob *job = pool->uploading;
+
+    if(!job)
+    {
+      job = decodeQueuePop(&pool->ready);
+
+      if(!job)
+      {
+        break;
+      }
+
+      pool->uploading = job;
+    }
+
+    if(!job->pixels)
+    {
+      if(job->ready)
+      {
+        job->ready(job->ready_user, 0);
+      }
+
+      decodeFreeJob(job);
+      pool->uploading = nullptr;
+      pool->pending.fetch_sub(1, std::memory_order_relaxed);
+
+      continue;
+    }
+
+    if(!job->texture)
+    {
+      TextureDesc texture_desc = {};
+      texture_desc.internal_format = job->srgb ? GL_SRGB8_ALPHA8 : GL_RGBA8;
+      texture_desc.width = job->width;
+      texture_desc.height = job->height;
+      texture_desc.mip_count = job->mip_count;
+      texture_desc.min_filter = job->mip_count > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR;
+
+      job->texture = device->createTexture2D(texture_desc);
+
+      // Goes round again as a failed load.
+      if(!job->texture)
+      {
+        free(job->pixels);
+        job->pixels = nullptr;
+
+        continue;
+      }
+    }
+
+    // Bands of whole rows, the last level may need only part of the budget.
+    const GLsizei width = job->width >> job->level ? job->width >> job->level : 1;
+    const GLsizei height = job->height >> job->level ? job->height >> job->level : 1;
+    const size_t row_bytes = (size_t)width * 4;
+
+    const size_t left = budget_bytes > uploaded ? budget_bytes - uploaded : 0;
+    GLsizei rows = (GLsizei)(left / row_bytes);
+    rows = rows < 1 ? 1 : rows > height - job->row ? height - job->row : rows;
+
+    if(uploaded > 0 && left < row_bytes)
+    {
+      break;
+    }
+
+    const uint8_t *pixels = job->pixels + job->level_offset + job->row * row_bytes;
+
+    device->uploadTexture2D(job->texture, job->level, 0, job->row, width, rows,
+                            GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+
+    uploaded += rows * row_bytes;
+    job->row += rows;
+
+    if(job->row < height)
+    {
+      continue;
+    }
+
+    job->level_offset += row_bytes * height;
+    job->level += 1;
+    job->row = 0;
+
+    if(job->level < job->mip_count)
+    {
+      continue;
+    }
+
+    if(job->ready)
+    {
+      job->ready(job->ready_user, job->texture);
+    }
+
+    decodeFreeJob(job);
+    pool->uploading = nullptr;
+    pool->pending.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  return uploaded;
+}
+
+size_t
+decodePoolPending(const DecodePool *pool)
+{
+  return pool->pending.load(std::memory_order_relaxed);
+}
+
+
+#endif // impl guard
@@ -2,9 +2,13 @@
 #define THIN_OGL_DEVICE_INCLUDED_
 
 
+// Debug checks, the error ones cost a glGetError per call. Define
+// THIN_NO_EXTRA_CHECKS to leave them out, e.g. when timing.
+#ifndef THIN_NO_EXTRA_CHECKS
 #define THIN_EXTRA_PARAM_CHECKS
 #define THIN_EXTRA_ERROR_CHECKS
 #define THIN_EXTRA_PEDANTIC_ERROR_CHECKS
+#endif
 
 
 #include <stdint.h>
@@ -13,6 +17,489 @@
 #include <glad/glad.h>
 
 
+#ifndef THIN_MAX_VERTEX_ATTRIBS
+#define THIN_MAX_VERTEX_ATTRIBS 16
+#endif
+
+#ifndef THIN_MAX_VERTEX_BUFFERS
+#define THIN_MAX_VERTEX_BUFFERS 4
+#endif
+
+#ifndef THIN_MAX_TEXTURE_UNITS
+#define THIN_MAX_TEXTURE_UNITS 16
+#endif
+
+#ifndef THIN_MAX_COLOR_ATTACHMENTS
+#define THIN_MAX_COLOR_ATTACHMENTS 4
+#endif
+
+#ifndef THIN_STATS_HISTORY
+#define THIN_STATS_HISTORY 120
+#endif
+
+#ifndef THIN_UPLOAD_POOL_BYTES
+#define THIN_UPLOAD_POOL_BYTES (64 << 20)
+#endif
+
+#ifndef THIN_UPLOAD_MIN_STAGE
+#define THIN_UPLOAD_MIN_STAGE (256 << 10)
+#endif
+
+#ifndef THIN_MAX_MEMORY_TAGS
+#define THIN_MAX_MEMORY_TAGS 32
+#endif
+
+// Block compressed formats glad's core profile leaves out.
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#define GL_COMPRESSED_RGBA_S3TC_DXT3_EXT 0x83F2
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+#ifndef GL_COMPRESSED_SRGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_SRGB_S3TC_DXT1_EXT 0x8C4C
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT 0x8C4D
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT 0x8C4E
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT 0x8C4F
+#endif
+
+#ifndef GL_COMPRESSED_RGBA_BPTC_UNORM
+#define GL_COMPRESSED_RGBA_BPTC_UNORM 0x8E8C
+#define GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM 0x8E8D
+#define GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT 0x8E8E
+#define GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT 0x8E8F
+#endif
+
+
+// ---------------------------------------------------------------[ Hashing ]--
+
+constexpr uint64_t thin_hash_seed = 0xcbf29ce484222325ull;
+
+constexpr uint64_t
+thinHashCombine(const uint64_t hash, const uint64_t value)
+{
+  return (hash ^ value) * 0x100000001b3ull;
+}
+
+constexpr uint64_t
+thinHashString(const char *str)
+{
+  uint64_t hash = thin_hash_seed;
+
+  while(*str)
+  {
+    hash = thinHashCombine(hash, (uint8_t)*str++);
+  }
+
+  return hash;
+}
+
+// ---------------------------------------------------------[ Vertex Layout ]--
+/*
+  POD description of how vertex data is fed to the attributes of a shader.
+  Attributes point into a buffer slot, the actual buffers are supplied when
+  the layout is bound so one layout can be shared by many meshes.
+*/
+
+struct VertexAttrib
+{
+  GLuint    index;        // Attribute location in the shader.
+  GLint     size;         // Component count 1-4.
+  GLenum    type;         // GL_FLOAT, GL_HALF_FLOAT, GL_UNSIGNED_BYTE, etc.
+  GLboolean normalized;
+  GLboolean integer;      // Uses glVertexAttribIPointer when true.
+  GLuint    buffer;       // Slot into the buffers the layout is bound with.
+  GLuint    offset;       // Byte offset into a vertex.
+  GLuint    divisor;      // Zero is per vertex, N is per N instances.
+};
+
+struct VertexLayout
+{
+  VertexAttrib  attribs[THIN_MAX_VERTEX_ATTRIBS];
+  GLuint        attrib_count;
+  GLsizei       strides[THIN_MAX_VERTEX_BUFFERS];
+};
+
+constexpr uint64_t
+vertexLayoutHash(const VertexLayout &layout)
+{
+  uint64_t hash = thinHashCombine(thin_hash_seed, layout.attrib_count);
+
+  for(GLuint i = 0; i < layout.attrib_count; ++i)
+  {
+    const VertexAttrib &attr = layout.attribs[i];
+
+    hash = thinHashCombine(hash, attr.index);
+    hash = thinHashCombine(hash, (uint64_t)attr.size);
+    hash = thinHashCombine(hash, attr.type);
+    hash = thinHashCombine(hash, attr.normalized);
+    hash = thinHashCombine(hash, attr.integer);
+    hash = thinHashCombine(hash, attr.buffer);
+    hash = thinHashCombine(hash, attr.offset);
+    hash = thinHashCombine(hash, attr.divisor);
+  }
+
+  for(GLuint i = 0; i < THIN_MAX_VERTEX_BUFFERS; ++i)
+  {
+    hash = thinHashCombine(hash, (uint64_t)layout.strides[i]);
+  }
+
+  return hash;
+}
+
+// ----------------------------------------------------------[ GL Functions ]--
+/*
+  Ids for every entry point glad knows about, used by the lazy loader, plus
+  the few newer than the GL 4.0 glad was generated for. Device looks those
+  up itself when the version or an extension has them, null otherwise, and
+  lists them so the null backend, trace and replay treat them like glad's.
+*/
+
+typedef void (APIENTRYP thin_tex_storage_2d_fn)(GLenum, GLsizei, GLenum, GLsizei, GLsizei);
+typedef void (APIENTRYP thin_tex_storage_3d_fn)(GLenum, GLsizei, GLenum, GLsizei, GLsizei, GLsizei);
+typedef void (APIENTRYP thin_bind_textures_fn)(GLuint, GLsizei, const GLuint*);
+
+extern thin_tex_storage_2d_fn gl_tex_storage_2d;
+extern thin_tex_storage_3d_fn gl_tex_storage_3d;
+extern thin_bind_textures_fn gl_bind_textures;
+
+#define THIN_GL_EXTRA_FUNCTIONS(X)          \
+  X(glTexStorage2D, gl_tex_storage_2d)      \
+  X(glTexStorage3D, gl_tex_storage_3d)      \
+  X(glBindTextures, gl_bind_textures)
+
+enum GLFunctionID : uint16_t
+{
+  #define THIN_GL_FUNCTION(name) gl_id_##name,
+  #include "glad_functions.inl"
+  #undef THIN_GL_FUNCTION
+
+  // After glad's so theirs keep the same ids.
+  #define THIN_GL_EXTRA(name, ptr) gl_id_##name,
+  THIN_GL_EXTRA_FUNCTIONS(THIN_GL_EXTRA)
+  #undef THIN_GL_EXTRA
+
+  gl_id_count
+};
+
+const char *
+glFunctionName(const GLFunctionID id);
+
+enum class GLLoading : uint8_t
+{
+  all,      // gladLoadGL, resolves every entry point up front.
+  lazy,     // Resolves what Device uses up front, the rest on first call.
+            // What the version and extensions don't cover is null, like
+            // gladLoadGL leaves it.
+};
+
+// ----------------------------------------------------------[ Null Backend ]--
+/*
+  Build with THIN_NULL_BACKEND to run Device with no driver at all. Every glad
+  pointer is swapped for a stub that counts the call and returns something
+  plausible, gen and create hand out increasing names, queries report a 4.5
+  context with no extensions. Used to measure what thin itself costs.
+*/
+
+#ifdef THIN_NULL_BACKEND
+
+struct GLNullCall
+{
+  GLFunctionID  id;
+  uint16_t      arg_count;  // Only the first four are kept.
+  uint64_t      args[4];    // Integers widened, pointers as addresses.
+};
+
+void
+glNullRecord(const bool record);
+
+const GLNullCall *
+glNullCalls(size_t *out_count);
+
+uint64_t
+glNullCallCount();
+
+uint64_t
+glNullCallCount(const GLFunctionID id);
+
+void
+glNullReset();
+
+#endif
+
+// -----------------------------------------------------------------[ Trace ]--
+/*
+  Build with THIN_TRACE for a capture layer over the glad pointers. Between
+  glTraceBegin and glTraceEnd every GL call is written with its arguments and
+  a CPU timestamp into a ring owned by the calling thread, a background thread
+  drains the rings to a file. Buffers, pixels, names, strings and uniform
+  and sampler arrays are copied into the record so the file can be replayed,
+  writes through a buffer mapping are recorded as a glBufferSubData of the
+  mapped range just before its glUnmapBuffer. A record bigger than the ring,
+  a large upload, is written to the file by the calling thread once its
+  ring is drained.
+
+  File layout is a GLTraceFileHeader then records back to back, each a
+  GLTraceRecord, arg_count uint64 args, a uint64 return if flagged, then
+  payload_size bytes. Records from different threads are in chunks, not
+  strictly time ordered.
+*/
+
+constexpr uint32_t gl_trace_magic = 0x52544854; // "THTR"
+constexpr uint32_t gl_trace_version = 1;
+
+enum GLTraceEvent : uint16_t
+{
+  gl_trace_frame = 0xffff,  // glTraceFrame, no args.
+};
+
+enum GLTraceFlags : uint8_t
+{
+  gl_trace_has_return = 1 << 0,
+};
+
+struct GLTraceFileHeader
+{
+  uint32_t  magic;
+  uint32_t  version;
+  uint32_t  function_count; // gl_id_count when written, ids must line up.
+  uint32_t  reserved;
+};
+
+struct GLTraceRecord
+{
+  uint64_t  time_ns;        // Since glTraceBegin, taken as the call starts.
+  uint16_t  id;             // GLFunctionID or GLTraceEvent.
+  uint8_t   arg_count;
+  uint8_t   flags;          // GLTraceFlags, thread index in the top nibble.
+  uint32_t  payload_size;   // Stored padded to 8 bytes.
+};
+
+#ifdef THIN_TRACE
+
+bool
+glTraceBegin(const char *path, const size_t ring_bytes = 4 << 20);
+
+void
+glTraceFrame();
+
+void
+glTraceEnd();
+
+#endif
+
+// ------------------------------------------------------------[ Capability ]--
+/*
+  Extensions Device cares about, tested with a bit lookup. Anything else can
+  go through Device::hasExtension with a name hashed by thinHashString.
+*/
+
+#define THIN_GL_CAPABILITIES(X)       \
+  X(AMD_debug_output)                 \
+  X(ARB_buffer_storage)               \
+  X(ARB_debug_output)                 \
+  X(ARB_direct_state_access)          \
+  X(ARB_framebuffer_object)           \
+  X(ARB_map_buffer_range)             \
+  X(ARB_multi_bind)                   \
+  X(ARB_pixel_buffer_object)          \
+  X(ARB_sampler_objects)              \
+  X(ARB_sync)                         \
+  X(ARB_texture_compression_bptc)     \
+  X(ARB_texture_storage)              \
+  X(ARB_timer_query)                  \
+  X(EXT_debug_label)                  \
+  X(EXT_debug_marker)                 \
+  X(EXT_texture_compression_s3tc)     \
+  X(EXT_texture_filter_anisotropic)   \
+  X(KHR_debug)                        \
+  X(NV_bindless_texture)              \
+  X(NV_command_list)
+
+enum class GLCap : uint8_t
+{
+  #define THIN_GL_CAP_ID(name) name,
+  THIN_GL_CAPABILITIES(THIN_GL_CAP_ID)
+  #undef THIN_GL_CAP_ID
+
+  count
+};
+
+// ----------------------------------------------------------[ Device Stats ]--
+/*
+  Plain counters Device bumps as it goes, read them or diff two copies to
+  get a frame's worth. Binds count calls that reached the driver, ones the
+  bind cache dropped only count as redundant_binds.
+*/
+
+#define THIN_DEVICE_STATS(X)          \
+  X(draw_calls)                       \
+  X(vertices)                         \
+  X(indices)                          \
+  X(bind_vertex_arrays)               \
+  X(bind_textures)                    \
+  X(bind_samplers)                    \
+  X(bind_buffers)                     \
+  X(bind_programs)                    \
+  X(bind_framebuffers)                \
+  X(redundant_binds)                  \
+  X(uniform_uploads)                  \
+  X(bytes_uploaded)                   \
+  X(objects_created)                  \
+  X(objects_deleted)
+
+struct DeviceStats
+{
+  #define THIN_DEVICE_STAT_FIELD(name) uint64_t name;
+  THIN_DEVICE_STATS(THIN_DEVICE_STAT_FIELD)
+  #undef THIN_DEVICE_STAT_FIELD
+};
+
+inline DeviceStats
+deviceStatsDelta(const DeviceStats &later, const DeviceStats &earlier)
+{
+  DeviceStats delta;
+
+  #define THIN_DEVICE_STAT_DELTA(name) delta.name = later.name - earlier.name;
+  THIN_DEVICE_STATS(THIN_DEVICE_STAT_DELTA)
+  #undef THIN_DEVICE_STAT_DELTA
+
+  return delta;
+}
+
+// ---------------------------------------------------------[ Debug Markers ]--
+
+enum class MarkerEvent : uint8_t
+{
+  insert,
+  push,
+  pop,
+};
+
+// ----------------------------------------------------------[ Texture Desc ]--
+/*
+  Everything createTexture2D needs in one POD. Zeroed fields take the GL
+  defaults, except the min filter which drops the mip part when there is a
+  single level so the texture is complete.
+*/
+
+struct TextureDesc
+{
+  GLenum        internal_format;  // Sized, GL_RGBA8, GL_SRGB8_ALPHA8, GL_R16F...
+  GLsizei       width;
+  GLsizei       height;
+  GLsizei       layers;           // Above 1 makes a GL_TEXTURE_2D_ARRAY.
+  bool          array;            // GL_TEXTURE_2D_ARRAY even with one layer.
+  GLsizei       mip_count;        // Zero is the full chain.
+  GLenum        wrap_s;
+  GLenum        wrap_t;
+  GLenum        min_filter;
+  GLenum        mag_filter;
+  const GLvoid  *data;            // Level 0 of every layer, rows aligned to 4.
+  GLenum        data_format;      // Zero picks the one matching internal_format.
+  GLenum        data_type;
+  bool          generate_mips;    // Fill the other levels from data.
+};
+
+/*
+  One ready made level of a block compressed texture.
+*/
+struct CompressedLevel
+{
+  const GLvoid  *data;
+  GLsizei       size;             // Bytes, whole 4x4 blocks.
+};
+
+// ----------------------------------------------------------[ Sampler Desc ]--
+/*
+  Filtering and addressing, apart from any texture. Zeroed fields take the
+  GL defaults. Equal descriptions share one sampler object through
+  Device::getSampler.
+*/
+
+struct SamplerDesc
+{
+  GLenum    min_filter;
+  GLenum    mag_filter;
+  GLenum    wrap_s;
+  GLenum    wrap_t;
+  GLenum    wrap_r;
+  GLenum    compare_func;     // Non zero turns on depth comparison.
+  GLuint    max_anisotropy;   // 0 or 1 is off, needs the EXT extension.
+};
+
+// ------------------------------------------------------[ Framebuffer Desc ]--
+/*
+  What a framebuffer draws into, by the textures and renderbuffers behind
+  it, which carry the formats and sample counts. Zeroed attachments are
+  unused. Equal descriptions share one FBO through Device::getFramebuffer.
+*/
+
+enum class AttachmentType : uint8_t
+{
+  texture,                    // Every layer of an array texture, layered.
+  texture_layer,              // One layer of an array texture.
+  renderbuffer,
+};
+
+struct FramebufferAttachment
+{
+  uintptr_t       object;     // Zero for none.
+  AttachmentType  type;
+  GLint           level;
+  GLint           layer;      // Only for texture_layer.
+};
+
+struct FramebufferDesc
+{
+  FramebufferAttachment color[THIN_MAX_COLOR_ATTACHMENTS];
+  FramebufferAttachment depth;
+  bool                  depth_stencil;  // Depth has stencil, GL_DEPTH24_STENCIL8...
+};
+
+// ----------------------------------------------------------------[ Memory ]--
+/*
+  Estimated bytes behind what Device allocated, worked out from the formats
+  and sizes it was handed. Drivers pad and compress on top of this.
+*/
+
+enum class MemoryType : uint8_t
+{
+  texture,
+  buffer,
+  renderbuffer,
+
+  count,
+};
+
+struct MemoryUsage
+{
+  size_t    bytes;
+  size_t    peak_bytes;       // Since creation or Device::resetMemoryPeaks.
+  size_t    count;            // Live objects.
+};
+
+struct MemoryAllocation
+{
+  MemoryType  type;
+  uintptr_t   name;
+  size_t      bytes;
+  const char  *tag;           // Null when untagged.
+};
+
+// ----------------------------------------------------------------[ Pixels ]--
+/*
+  Bytes glTexImage2D reads for an image with the default unpack state, rows
+  aligned to 4. Zero for formats or types it doesn't know.
+*/
+size_t
+pixelDataSize(const GLsizei width,
+              const GLsizei height,
+              const GLenum format,
+              const GLenum type);
+
+
 struct Device
 {
 
@@ -20,10 +507,134 @@ using error_callback_fn = void(*)(const char *);
 
 error_callback_fn curr_error_callback = nullptr;
 
+// Told about every debug marker, the profiler hangs scopes off this.
+using marker_callback_fn = void(*)(void *user, const MarkerEvent event, const char *name);
+
+marker_callback_fn curr_marker_callback = nullptr;
+void *curr_marker_user = nullptr;
+
+DeviceStats stats = {};
+
+// Finished frames, see endFrame.
+DeviceStats stats_history[THIN_STATS_HISTORY];
+DeviceStats frame_start_stats = {};
+uint64_t frame_count = 0;
+
+// What Device last bound, repeat binds are dropped before reaching the
+// driver. thin_unknown_binding is anything Device can't vouch for.
+static constexpr GLuint thin_unknown_binding = ~(GLuint)0;
+static constexpr size_t thin_bind_buffer_targets = 8;
+static constexpr size_t thin_bind_texture_targets = 4;
+static constexpr size_t thin_bind_index_buffer = 1;
+
+GLuint bound_program = thin_unknown_binding;
+GLuint bound_vertex_array = thin_unknown_binding;
+GLuint bound_buffers[thin_bind_buffer_targets];
+GLuint active_texture = thin_unknown_binding;
+GLuint bound_textures[THIN_MAX_TEXTURE_UNITS][thin_bind_texture_targets];
+GLuint bound_samplers[THIN_MAX_TEXTURE_UNITS];
+GLuint bound_draw_framebuffer = thin_unknown_binding;
+GLuint bound_read_framebuffer = thin_unknown_binding;
+
+// What binding zero means, see setDefaultFramebuffer.
+GLuint default_framebuffer = 0;
+
+// Samplers by packed SamplerDesc, open addressed.
+struct SamplerCacheEntry
+{
+  uint32_t  key;
+  uintptr_t sampler;        // Zero marks an empty slot.
+};
+
+SamplerCacheEntry *sampler_cache = nullptr;
+size_t sampler_cache_capacity = 0;
+size_t sampler_cache_count = 0;
+
+// Pixel unpack buffers uploadTexture2D stages through, free once the fence
+// from their last upload has signalled.
+struct UploadStage
+{
+  uintptr_t buffer;
+  size_t    size;
+  GLsync    fence;          // Null when free.
+};
+
+UploadStage *upload_stages = nullptr;
+size_t upload_stage_count = 0;
+size_t upload_stage_capacity = 0;
+size_t upload_pool_bytes = 0;
+
+// Bytes behind objects Device sized itself, open addressed on type + name.
+struct MemoryEntry
+{
+  uint64_t  key;            // Zero marks an empty slot.
+  size_t    bytes;
+  uint32_t  tag;
+};
+
+MemoryEntry *memory_table = nullptr;
+size_t memory_table_capacity = 0;
+size_t memory_table_count = 0;
+
+MemoryUsage memory_total = {};
+MemoryUsage memory_by_type[(size_t)MemoryType::count] = {};
+
+// Tag 0 is untagged, the rest point at strings from setMemoryTag.
+const char *memory_tags[THIN_MAX_MEMORY_TAGS] = {};
+MemoryUsage memory_by_tag[THIN_MAX_MEMORY_TAGS] = {};
+uint32_t memory_tag_count = 1;
+uint32_t memory_tag = 0;
+
+// VAOs created by bindVertexLayout, open addressed on layout + buffers.
+struct VertexArrayCacheEntry
+{
+  uint64_t      key;
+  uint64_t      layout_hash;
+  VertexLayout  layout;         // Compared on hits, hashes can collide.
+  size_t        buffer_count;
+  uintptr_t     buffers[THIN_MAX_VERTEX_BUFFERS];
+  uintptr_t     index_buffer;
+  uintptr_t     vao;            // Zero marks an empty slot.
+};
+
+VertexArrayCacheEntry *vao_cache = nullptr;
+size_t vao_cache_capacity = 0;
+size_t vao_cache_count = 0;
+
+// How many cached VAOs use each buffer, deleting one none use skips the
+// scan of the cache. Open addressed on the buffer.
+struct VertexArrayBufferRef
+{
+  uintptr_t buffer;         // Zero marks an empty slot.
+  size_t    count;
+};
+
+VertexArrayBufferRef *vao_buffer_refs = nullptr;
+size_t vao_buffer_refs_capacity = 0;
+size_t vao_buffer_refs_count = 0;
+
+// FBOs made by getFramebuffer, open addressed on the attachments.
+struct FramebufferCacheEntry
+{
+  uint64_t        key;
+  FramebufferDesc desc;
+  uintptr_t       framebuffer;  // Zero marks an empty slot.
+};
+
+FramebufferCacheEntry *fbo_cache = nullptr;
+size_t fbo_cache_capacity = 0;
+size_t fbo_cache_count = 0;
+
+// Hashes of every extension the driver reports, see hasExtension.
+uint64_t *extension_set = nullptr;
+size_t extension_set_capacity = 0;
+uint64_t capabilities = 0;
+
 // ---------------------------------------------------------------[ General ]--
 
 void
-initialize();
+initialize(const GLLoading loading = GLLoading::all,
+           GLADloadproc get_proc = nullptr);
 
 void
 errorCallback(const error_callback_fn err_cb);
@@ -31,6 +642,81 @@ errorCallback(const error_callback_fn err_cb);
 void
 getError(const char *msg);
 
+// ------------------------------------------------------------[ Capability ]--
+
+void
+buildCapabilities();
+
+bool
+hasCapability(const GLCap cap) const;
+
+bool
+hasExtension(const uint64_t name_hash) const;
+
+bool
+hasExtension(const char *name) const;
+
+// -----------------------------------------------------------------[ Stats ]--
+
+/*
+  Brackets a frame, endFrame pushes the frame's counters into the history.
+*/
+void
+beginFrame();
+
+void
+endFrame();
+
+/*
+  Counters of a finished frame, 0 is the last one. False once it has fallen
+  out of the THIN_STATS_HISTORY frames kept.
+*/
+bool
+getFrameStats(const size_t frames_ago, DeviceStats *out_stats) const;
+
+/*
+  Forget what the bind cache thinks is bound, call after binding with raw GL
+  or handing the context to other code.
+*/
+void
+invalidateBindings();
+
+// ----------------------------------------------------------------[ Memory ]--
+
+/*
+  Allocations from here on are counted under tag, null for none. Kept by
+  pointer so it has to outlive the Device, a string literal is best. Tags
+  past THIN_MAX_MEMORY_TAGS count as untagged.
+*/
+void
+setMemoryTag(const char *tag);
+
+MemoryUsage
+getMemoryUsage() const;
+
+MemoryUsage
+getMemoryUsage(const MemoryType type) const;
+
+/*
+  Zeroed for a tag that was never set.
+*/
+MemoryUsage
+getMemoryUsage(const char *tag) const;
+
+/*
+  Largest live allocations, biggest first. Returns how many were written,
+  at most max_count.
+*/
+size_t
+getTopAllocations(MemoryAllocation out_allocations[], const size_t max_count) const;
+
+/*
+  Peaks restart from what's live now, for a high-water mark per level or
+  per session.
+*/
+void
+resetMemoryPeaks();
+
 // ------------------------------------------------------------------[ Misc ]--
 
 void
@@ -116,10 +802,18 @@ bindActiveTexture(const GLuint texture_slot,
                   const GLenum target,
                   const uintptr_t texture);
 
+/*
+  Binds textures to units first_unit onwards, an index not GL_TEXTURE0.
+  Units already holding their texture are skipped, the rest go in one
+  glBindTextures with GL 4.4 or ARB_multi_bind, else one bind each. Targets
+  are only used by the fallback and the bind cache, null means all
+  GL_TEXTURE_2D.
+*/
 void
-bindTextures(const GLuint first_target,
+bindTextures(const GLuint first_unit,
              const size_t count,
-             const uintptr_t textures[]);
+             const uintptr_t textures[],
+             const GLenum targets[] = nullptr);
 
 void
 deleteTexture(const uintptr_t texture);
@@ -127,6 +821,138 @@ deleteTexture(const uintptr_t texture);
 void
 deleteTextures(const size_t count, const uintptr_t textures[]);
 
+/*
+  Creates, sizes and sets up a texture in as few calls as the driver allows,
+  immutable storage with GL 4.2 or ARB_texture_storage. The texture is left
+  bound to the active unit. Zero if the description is unusable.
+*/
+uintptr_t
+createTexture2D(const TextureDesc &desc);
+
+/*
+  BC1 to BC7 texture from levels already in their GPU layout, level i is
+  width >> i by height >> i. The data goes to the driver as given, so it
+  can point straight into a mapped file. Zero if the driver lacks the
+  format, S3TC for BC1-3 and BPTC for BC6H-7.
+*/
+uintptr_t
+createCompressedTexture2D(const GLenum internal_format,
+                          const GLsizei width,
+                          const GLsizei height,
+                          const GLsizei mip_count,
+                          const CompressedLevel levels[]);
+
+/*
+  Bytes of a texture made by createTexture2D or createCompressedTexture2D,
+  zero for any other.
+*/
+size_t
+getTextureMemory(const uintptr_t texture) const;
+
+/*
+  For storage that changes after creation, levels streamed in or dropped.
+  Replaces what's tracked for the texture, zero stops tracking it.
+*/
+void
+setTextureMemory(const uintptr_t texture, const size_t bytes);
+
+// --------------------------------------------------------------[ Samplers ]--
+
+/*
+  Sampler object for a description, made on first use and shared after.
+  Zero without GL 3.3 or ARB_sampler_objects, or for enums it doesn't know.
+*/
+uintptr_t
+getSampler(const SamplerDesc &desc);
+
+/*
+  Unit is an index, 0 not GL_TEXTURE0, as glBindSampler takes it. Does
+  nothing without sampler objects.
+*/
+void
+bindSampler(const GLuint unit, const uintptr_t sampler);
+
+void
+clearSamplerCache();
+
+// --------------------------------------------------------[ Texture Upload ]--
+
+/*
+  Copies pixels into a pooled pixel unpack buffer and updates the texture
+  from that, the GPU side of the transfer then overlaps with rendering.
+  Pixels are read with the current unpack state (alignment, row length,
+  skips) like glTexSubImage2D. The texture is left bound to the active unit.
+
+  Goes straight to glTexSubImage2D when pixels is null, the pool is out of
+  free space or the driver lacks PBOs and fences.
+*/
+void
+uploadTexture2D(const uintptr_t texture,
+                const GLint level,
+                const GLint x,
+                const GLint y,
+                const GLsizei width,
+                const GLsizei height,
+                const GLenum format,
+                const GLenum type,
+                const GLvoid *pixels);
+
+/*
+  Waits on uploads still in flight and deletes the staging buffers.
+*/
+void
+clearUploadPool();
+
+// ---------------------------------------------------------[ Renderbuffers ]--
+
+/*
+  Attachment storage that's never sampled, samples of zero for none.
+  Zero for formats Device can't size.
+*/
+uintptr_t
+createRenderbuffer(const GLenum internal_format,
+                   const GLsizei width,
+                   const GLsizei height,
+                   const GLsizei samples = 0);
+
+void
+deleteRenderbuffers(const size_t count, const uintptr_t renderbuffers[]);
+
+// ----------------------------------------------------------[ Framebuffers ]--
+
+/*
+  FBO for a description, made on first use and shared after. Completeness
+  is checked once when it's made, zero if it isn't complete. Deleting an
+  attached texture or renderbuffer drops the FBOs using it. Bindings are
+  left as they were either way.
+*/
+uintptr_t
+getFramebuffer(const FramebufferDesc &desc);
+
+/*
+  For contexts whose window framebuffer is an FBO, like the surfaceless
+  headless one. Binding zero binds it instead, and so does deleting a
+  bound cached FBO, where GL would fall back to zero.
+*/
+void
+setDefaultFramebuffer(const uintptr_t framebuffer);
+
+/*
+  GL_FRAMEBUFFER binds draw and read together, zero is the default
+  framebuffer.
+*/
+void
+bindFramebuffer(const GLenum target, const uintptr_t framebuffer);
+
+/*
+  getFramebuffer bound as draw and read, false if it couldn't be made.
+*/
+bool
+bindFramebuffer(const FramebufferDesc &desc);
+
+void
+clearFramebufferCache();
+
 // ---------------------------------------------------------------[ Shaders ]--
 
 uintptr_t
@@ -204,6 +1030,37 @@ enableVertexAttribArrayPointer(const intptr_t attr_index,
                                const GLsizei stride,
                                const GLvoid *pointer);
 
+// -------------------------------------------------------------[ VAO Cache ]--
+
+uintptr_t
+getVertexArray(const VertexLayout &layout,
+               const size_t buffer_count,
+               const uintptr_t buffers[],
+               const uintptr_t index_buffer = 0);
+
+uintptr_t
+getVertexArray(const uint64_t layout_hash,
+               const VertexLayout &layout,
+               const size_t buffer_count,
+               const uintptr_t buffers[],
+               const uintptr_t index_buffer = 0);
+
+void
+bindVertexLayout(const VertexLayout &layout,
+                 const size_t buffer_count,
+                 const uintptr_t buffers[],
+                 const uintptr_t index_buffer = 0);
+
+void
+bindVertexLayout(const uint64_t layout_hash,
+                 const VertexLayout &layout,
+                 const size_t buffer_count,
+                 const uintptr_t buffers[],
+                 const uintptr_t index_buffer = 0);
+
+void
+clearVertexArrayCache();
+
 // ---------------------------------------------------------------[ Drawing ]--
 
 void
@@ -220,6 +1077,9 @@ drawElements(const GLenum mode,
 bool
 getHasDebugMarkers();
 
+void
+markerCallback(const marker_callback_fn marker_cb, void *user = nullptr);
+
 void
 insertEventMarker(const char *msg);
 
@@ -235,332 +1095,4315 @@ popGroupMarker();
 #endif // inc guard
 
 
-#ifdef THIN_DEVICE_IMPL
+#if defined(THIN_DEVICE_IMPL) && !defined(THIN_DEVICE_IMPL_INCLUDED_)
+#define THIN_DEVICE_IMPL_INCLUDED_
 
-// ---------------------------------------------------------------[ General ]--
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
-void
-Device::initialize()
-{
-  gladLoadGL();
-  printf("OpenGL Version %d.%d loaded\n", GLVersion.major, GLVersion.minor);
-}
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
 
-void
-Device::errorCallback(const error_callback_fn err_cb)
-{
-  curr_error_callback = err_cb;
-}
+#ifdef THIN_TRACE
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#endif
 
-void
-Device::getError(const char *msg)
-{
-  const GLenum err = glGetError();
 
-  if(err && curr_error_callback)
-  {
-    // TODO: Prefix with error code.
-    curr_error_callback(msg);
-  }
-}
+// ------------------------------------------------------[ GL Loading Utils ]--
 
-// ------------------------------------------------------------------[ Misc ]--
+thin_tex_storage_2d_fn gl_tex_storage_2d = nullptr;
+thin_tex_storage_3d_fn gl_tex_storage_3d = nullptr;
+thin_bind_textures_fn gl_bind_textures = nullptr;
 
-void
-Device::enable(const GLenum cap)
+static void ** const gl_function_slots[] = {
+  #define THIN_GL_FUNCTION(name) (void**)&glad_##name,
+  #include "glad_functions.inl"
+  #undef THIN_GL_FUNCTION
+
+  #define THIN_GL_EXTRA(name, ptr) (void**)&ptr,
+  THIN_GL_EXTRA_FUNCTIONS(THIN_GL_EXTRA)
+  #undef THIN_GL_EXTRA
+};
+
+static const char * const gl_function_names[] = {
+  #define THIN_GL_FUNCTION(name) #name,
+  #include "glad_functions.inl"
+  #undef THIN_GL_FUNCTION
+
+  #define THIN_GL_EXTRA(name, ptr) #name,
+  THIN_GL_EXTRA_FUNCTIONS(THIN_GL_EXTRA)
+  #undef THIN_GL_EXTRA
+};
+
+// Resolved at initialize even when loading lazily, keep this in step with
+// what Device calls so the hot paths never go through a stub.
+static const GLFunctionID gl_device_functions[] = {
+  gl_id_glGetString, gl_id_glGetStringi, gl_id_glGetIntegerv, gl_id_glGetError,
+  gl_id_glEnable, gl_id_glDisable,
+  gl_id_glGenVertexArrays, gl_id_glBindVertexArray, gl_id_glDeleteVertexArrays,
+  gl_id_glClearColor, gl_id_glClear,
+  gl_id_glGenTextures, gl_id_glBindTexture, gl_id_glActiveTexture,
+  gl_id_glDeleteTextures,
+  gl_id_glCreateShader, gl_id_glShaderSource, gl_id_glCompileShader,
+  gl_id_glCreateProgram, gl_id_glAttachShader, gl_id_glLinkProgram,
+  gl_id_glUseProgram, gl_id_glGetAttachedShaders, gl_id_glDeleteShader,
+  gl_id_glDeleteProgram, gl_id_glBindFragDataLocation,
+  gl_id_glGetUniformLocation, gl_id_glUniform1i,
+  gl_id_glGenBuffers, gl_id_glBindBuffer, gl_id_glBufferData,
+  gl_id_glDeleteBuffers,
+  gl_id_glGetAttribLocation, gl_id_glEnableVertexAttribArray,
+  gl_id_glVertexAttribPointer, gl_id_glVertexAttribIPointer,
+  gl_id_glVertexAttribDivisor,
+  gl_id_glDrawArrays, gl_id_glDrawElements,
+  gl_id_glBindFramebuffer,
+  gl_id_glInsertEventMarkerEXT, gl_id_glPushGroupMarkerEXT,
+  gl_id_glPopGroupMarkerEXT,
+};
+
+const char *
+glFunctionName(const GLFunctionID id)
 {
-  glEnable(cap);
+  return id < gl_id_count ? gl_function_names[id] : "unknown";
+}
 
-  #ifdef THIN_EXTRA_ERROR_CHECKS
-  getError("glEnable");
+// The null backend never talks to a driver, so none of the loaders below.
+#ifndef THIN_NULL_BACKEND
+
+static GLADloadproc gl_lazy_get_proc = nullptr;
+
+// Told when a lazy stub finds nothing behind it.
+static Device *gl_lazy_device = nullptr;
+
+static void*
+glDefaultGetProc(const char *name)
+{
+  // Like glad's own loader but keeps the library open for lazy lookups.
+  #if defined(_WIN32)
+  static HMODULE lib = LoadLibraryW(L"opengl32.dll");
+  using wgl_get_proc_fn = PROC(WINAPI*)(LPCSTR);
+  static wgl_get_proc_fn wgl_get_proc = lib ?
+    (wgl_get_proc_fn)GetProcAddress(lib, "wglGetProcAddress") :
+    nullptr;
+
+  void *proc = wgl_get_proc ? (void*)wgl_get_proc(name) : nullptr;
+  return proc || !lib ? proc : (void*)GetProcAddress(lib, name);
+  #elif defined(__APPLE__)
+  static void *lib = dlopen("/System/Library/Frameworks/OpenGL.framework/OpenGL",
+                            RTLD_LAZY | RTLD_GLOBAL);
+
+  return lib ? dlsym(lib, name) : nullptr;
+  #else
+  static void *lib = dlopen("libGL.so.1", RTLD_LAZY | RTLD_GLOBAL);
+  using glx_get_proc_fn = void*(*)(const char*);
+  static glx_get_proc_fn glx_get_proc = lib ?
+    (glx_get_proc_fn)dlsym(lib, "glXGetProcAddressARB") :
+    nullptr;
+
+  void *proc = glx_get_proc ? glx_get_proc(name) : nullptr;
+  return proc || !lib ? proc : dlsym(lib, name);
   #endif
 }
 
-void
-Device::enable(const size_t count, const GLenum to_enable[])
+static void*
+glResolveFunction(const size_t id)
 {
-  for(size_t i = 0; i < count; ++i)
+  void *proc = gl_lazy_get_proc(gl_function_names[id]);
+
+  // A miss keeps the stub in place so the next call reports again rather
+  // than jumping to null.
+  if(proc)
   {
-    enable(to_enable[i]);
+    *gl_function_slots[id] = proc;
   }
+
+  return proc;
 }
 
-void
-Device::disable(const GLenum cap)
+static void
+glLazyMissing(const size_t id)
 {
-  glDisable(cap);
+  if(gl_lazy_device && gl_lazy_device->curr_error_callback)
+  {
+    char msg[128];
+    snprintf(msg, sizeof(msg), "GL function unavailable: %s", gl_function_names[id]);
+    gl_lazy_device->curr_error_callback(msg);
+  }
+}
 
-  #ifdef THIN_EXTRA_ERROR_CHECKS
-  getError("glDisable");
-  #endif
+template<typename fn_type>
+struct GLStub;
+
+template<typename R, typename ...Args>
+struct GLStub<R(APIENTRYP)(Args...)>
+{
+  // Installed in place of a glad pointer, swaps itself for the real
+  // function on the first call.
+  template<size_t id>
+  static R APIENTRY
+  lazy(Args... args)
+  {
+    using fn_type = R(APIENTRYP)(Args...);
+    const fn_type fn = (fn_type)glResolveFunction(id);
+
+    if(!fn)
+    {
+      glLazyMissing(id);
+      return R();
+    }
+
+    return fn(args...);
+  }
+};
+
+#endif // THIN_NULL_BACKEND
+
+static void
+glLoadVersion()
+{
+  // glad fills these in from find_coreGL.
+  const char *version = (const char*)glGetString(GL_VERSION);
+  int major = 0;
+  int minor = 0;
+
+  while(version && *version && (*version < '0' || *version > '9'))
+  {
+    ++version;
+  }
+
+  if(version)
+  {
+    sscanf(version, "%d.%d", &major, &minor);
+  }
+
+  GLVersion.major = major;
+  GLVersion.minor = minor;
+
+  #define THIN_GL_VERSION(maj, min) \
+    GLAD_GL_VERSION_##maj##_##min = major > maj || (major == maj && minor >= min);
+
+  THIN_GL_VERSION(1, 0) THIN_GL_VERSION(1, 1) THIN_GL_VERSION(1, 2)
+  THIN_GL_VERSION(1, 3) THIN_GL_VERSION(1, 4) THIN_GL_VERSION(1, 5)
+  THIN_GL_VERSION(2, 0) THIN_GL_VERSION(2, 1) THIN_GL_VERSION(3, 0)
+  THIN_GL_VERSION(3, 1) THIN_GL_VERSION(3, 2) THIN_GL_VERSION(3, 3)
+  THIN_GL_VERSION(4, 0)
+
+  #undef THIN_GL_VERSION
 }
 
-void
-Device::disable(const size_t count, const GLenum to_disable[])
+#ifndef THIN_NULL_BACKEND
+
+static void
+glLoadLazy(GLADloadproc get_proc)
 {
+  gl_lazy_get_proc = get_proc;
+
+  #define THIN_GL_FUNCTION(name) \
+    glad_##name = &GLStub<decltype(glad_##name)>::template lazy<gl_id_##name>;
+  #include "glad_functions.inl"
+  #undef THIN_GL_FUNCTION
+
+  const size_t count = sizeof(gl_device_functions) / sizeof(gl_device_functions[0]);
+
   for(size_t i = 0; i < count; ++i)
   {
-    disable(to_disable[i]);
+    glResolveFunction(gl_device_functions[i]);
   }
+
+  glLoadVersion();
 }
 
+/*
+  Once the version and extension flags are in, does what glad's load_GL_*
+  gates would have. Entry points outside them go null so availability
+  checks hold, extension ones are resolved and null checked now, core ones
+  in the version keep their stubs. Extra functions are glLoadExtra's.
+*/
+static void
+glLoadLazyGates()
+{
+  // Bit 0 a core version has it, bit 1 an extension does.
+  uint8_t gates[gl_id_count];
+  memset(gates, 0, sizeof(gates));
 
-// -------------------------------------------------------------------[ VAO ]--
+  #define THIN_GL_GATE(name, flag, extension) \
+    gates[gl_id_##name] |= flag ? (extension ? 2 : 1) : 0;
+  #include "glad_gates.inl"
+  #undef THIN_GL_GATE
 
-uintptr_t
-Device::genVertexArray()
+  #define THIN_GL_EXTRA(name, ptr) gates[gl_id_##name] = 1;
+  THIN_GL_EXTRA_FUNCTIONS(THIN_GL_EXTRA)
+  #undef THIN_GL_EXTRA
+
+  for(size_t i = 0; i < gl_id_count; ++i)
+  {
+    if(!gates[i])
+    {
+      *gl_function_slots[i] = nullptr;
+    }
+    else if(gates[i] == 2)
+    {
+      *gl_function_slots[i] = gl_lazy_get_proc(gl_function_names[i]);
+    }
+  }
+}
+
+#endif // THIN_NULL_BACKEND
+
+
+// -----------------------------------------------------------[ Pixel Utils ]--
+
+static size_t
+pixelBytes(const GLenum format, const GLenum type)
 {
-  uintptr_t vao = 0;
-  genVertexArrays(1, &vao);
+  size_t channels = 0;
 
-  return vao;
+  switch(format)
+  {
+    case GL_RED: case GL_RED_INTEGER: case GL_DEPTH_COMPONENT:  channels = 1; break;
+    case GL_RG: case GL_RG_INTEGER: case GL_DEPTH_STENCIL:      channels = 2; break;
+    case GL_RGB: case GL_BGR: case GL_RGB_INTEGER:              channels = 3; break;
+    case GL_RGBA: case GL_BGRA: case GL_RGBA_INTEGER:           channels = 4; break;
+  }
+
+  size_t bytes = 0;
+
+  switch(type)
+  {
+    case GL_UNSIGNED_BYTE: case GL_BYTE:                        bytes = channels; break;
+    case GL_UNSIGNED_SHORT: case GL_SHORT: case GL_HALF_FLOAT:  bytes = channels * 2; break;
+    case GL_UNSIGNED_INT: case GL_INT: case GL_FLOAT:           bytes = channels * 4; break;
+    case GL_UNSIGNED_INT_8_8_8_8: case GL_UNSIGNED_INT_8_8_8_8_REV:
+    case GL_UNSIGNED_INT_2_10_10_10_REV: case GL_UNSIGNED_INT_24_8:
+      bytes = 4;
+      break;
+    case GL_UNSIGNED_SHORT_5_6_5: case GL_UNSIGNED_SHORT_4_4_4_4:
+    case GL_UNSIGNED_SHORT_5_5_5_1:
+      bytes = 2;
+      break;
+  }
+
+  return bytes;
 }
 
-void
-Device::genVertexArrays(const size_t count, uintptr_t out_vaos[])
+size_t
+pixelDataSize(const GLsizei width,
+              const GLsizei height,
+              const GLenum format,
+              const GLenum type)
 {
-  GLuint *vaos = (GLuint*)malloc(count * sizeof(GLuint));
+  const size_t row = (width * pixelBytes(format, type) + 3) & ~(size_t)3;
 
-  glGenVertexArrays(count, vaos);
+  return row * height;
+}
 
-  // Convert back to uintptrs
-  for(size_t i = 0; i < count; ++i)
+
+// ---------------------------------------------------------[ Texture Utils ]--
+
+struct TextureFormatInfo
+{
+  GLenum  format;
+  GLenum  type;
+  GLuint  bytes;            // Per texel.
+};
+
+static bool
+textureFormatInfo(const GLenum internal_format, TextureFormatInfo *out_info)
+{
+  switch(internal_format)
   {
-    out_vaos[i] = (uintptr_t)vaos[i];
+    case GL_R8:                 *out_info = {GL_RED, GL_UNSIGNED_BYTE, 1}; return true;
+    case GL_RG8:                *out_info = {GL_RG, GL_UNSIGNED_BYTE, 2}; return true;
+    case GL_RGB8:
+    case GL_SRGB8:              *out_info = {GL_RGB, GL_UNSIGNED_BYTE, 3}; return true;
+    case GL_RGBA8:
+    case GL_SRGB8_ALPHA8:       *out_info = {GL_RGBA, GL_UNSIGNED_BYTE, 4}; return true;
+    case GL_R16:                *out_info = {GL_RED, GL_UNSIGNED_SHORT, 2}; return true;
+    case GL_RGBA16:             *out_info = {GL_RGBA, GL_UNSIGNED_SHORT, 8}; return true;
+    case GL_R16F:               *out_info = {GL_RED, GL_HALF_FLOAT, 2}; return true;
+    case GL_RG16F:              *out_info = {GL_RG, GL_HALF_FLOAT, 4}; return true;
+    case GL_RGBA16F:            *out_info = {GL_RGBA, GL_HALF_FLOAT, 8}; return true;
+    case GL_R32F:               *out_info = {GL_RED, GL_FLOAT, 4}; return true;
+    case GL_RG32F:              *out_info = {GL_RG, GL_FLOAT, 8}; return true;
+    case GL_RGBA32F:            *out_info = {GL_RGBA, GL_FLOAT, 16}; return true;
+    case GL_R11F_G11F_B10F:     *out_info = {GL_RGB, GL_UNSIGNED_INT_10F_11F_11F_REV, 4}; return true;
+    case GL_RGB10_A2:           *out_info = {GL_RGBA, GL_UNSIGNED_INT_2_10_10_10_REV, 4}; return true;
+    case GL_R8UI:               *out_info = {GL_RED_INTEGER, GL_UNSIGNED_BYTE, 1}; return true;
+    case GL_R32UI:              *out_info = {GL_RED_INTEGER, GL_UNSIGNED_INT, 4}; return true;
+    case GL_RGBA8UI:            *out_info = {GL_RGBA_INTEGER, GL_UNSIGNED_BYTE, 4}; return true;
+    case GL_DEPTH_COMPONENT16:  *out_info = {GL_DEPTH_COMPONENT, GL_UNSIGNED_SHORT, 2}; return true;
+    case GL_DEPTH_COMPONENT24:  *out_info = {GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, 4}; return true;
+    case GL_DEPTH_COMPONENT32F: *out_info = {GL_DEPTH_COMPONENT, GL_FLOAT, 4}; return true;
+    case GL_DEPTH24_STENCIL8:   *out_info = {GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, 4}; return true;
   }
 
-  #ifdef THIN_EXTRA_ERROR_CHECKS
-  getError("glGenVertexArrays");
-  #endif
+  return false;
+}
 
-  free(vaos);
+/*
+  Bytes per 4x4 block, zero when the format isn't BC1 to BC7.
+*/
+static GLsizei
+compressedBlockBytes(const GLenum internal_format)
+{
+  switch(internal_format)
+  {
+    case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+    case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+    case GL_COMPRESSED_SRGB_S3TC_DXT1_EXT:
+    case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT:
+    case GL_COMPRESSED_RED_RGTC1:
+    case GL_COMPRESSED_SIGNED_RED_RGTC1:
+      return 8;
+
+    case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+    case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+    case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT:
+    case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT:
+    case GL_COMPRESSED_RG_RGTC2:
+    case GL_COMPRESSED_SIGNED_RG_RGTC2:
+    case GL_COMPRESSED_RGBA_BPTC_UNORM:
+    case GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM:
+    case GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT:
+    case GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT:
+      return 16;
+  }
+
+  return 0;
 }
 
-uintptr_t
-Device::createVertexArray()
+static GLsizei
+textureFullMipCount(const GLsizei width, const GLsizei height)
 {
-  // TODO: Need to check to see if glCreateVertexArrays exists.
-  return genVertexArray();
+  GLsizei count = 1;
+
+  for(GLsizei size = width > height ? width : height; size > 1; size >>= 1)
+  {
+    ++count;
+  }
+
+  return count;
 }
 
-void
-Device::createVertexArrays(const size_t count, uintptr_t vaos[])
+
+// ---------------------------------------------------------[ Sampler Utils ]--
+
+static inline bool
+samplerObjectsSupported(const Device &dev)
 {
-  // TODO: Need to check to see if glCreateVertexArrays exists.
-  genVertexArrays(count, vaos);
+  // glad only loads the entry points for 3.3, the extension alone can
+  // leave them null.
+  return GLAD_GL_VERSION_3_3 ||
+         (dev.hasCapability(GLCap::ARB_sampler_objects) && glad_glGenSamplers && glad_glBindSampler);
 }
 
-void
-Device::bindVertexArray(const uintptr_t vao)
+static int
+samplerEnumIndex(const GLenum value, const GLenum *values, const int count)
 {
-  glBindVertexArray(vao);
+  // Zero is the GL default, which is always first.
+  if(!value)
+  {
+    return 0;
+  }
 
-  #ifdef THIN_EXTRA_ERROR_CHECKS
-  getError("glBindVertexArray");
-  #endif
+  for(int i = 0; i < count; ++i)
+  {
+    if(values[i] == value)
+    {
+      return i;
+    }
+  }
+
+  return -1;
 }
 
-void
-Device::deleteVertexArray(const uintptr_t vao)
+static const GLenum sampler_min_filters[] = {
+  GL_NEAREST_MIPMAP_LINEAR, GL_NEAREST, GL_LINEAR, GL_NEAREST_MIPMAP_NEAREST,
+  GL_LINEAR_MIPMAP_NEAREST, GL_LINEAR_MIPMAP_LINEAR,
+};
+
+static const GLenum sampler_mag_filters[] = {GL_LINEAR, GL_NEAREST};
+
+static const GLenum sampler_wraps[] = {
+  GL_REPEAT, GL_CLAMP_TO_EDGE, GL_MIRRORED_REPEAT, GL_CLAMP_TO_BORDER,
+};
+
+static const GLenum sampler_compare_funcs[] = {
+  0, GL_LEQUAL, GL_GEQUAL, GL_LESS, GL_GREATER, GL_EQUAL, GL_NOTEQUAL,
+  GL_ALWAYS, GL_NEVER,
+};
+
+/*
+  Packs a SamplerDesc into 19 bits, an index into the tables above per
+  field. False for an enum the tables don't have.
+*/
+static bool
+samplerKey(const SamplerDesc &desc, uint32_t *out_key)
 {
-  deleteVertexArrays(1, &vao);
+  const int fields[] = {
+    samplerEnumIndex(desc.min_filter, sampler_min_filters, 6),
+    samplerEnumIndex(desc.mag_filter, sampler_mag_filters, 2),
+    samplerEnumIndex(desc.wrap_s, sampler_wraps, 4),
+    samplerEnumIndex(desc.wrap_t, sampler_wraps, 4),
+    samplerEnumIndex(desc.wrap_r, sampler_wraps, 4),
+    samplerEnumIndex(desc.compare_func, sampler_compare_funcs, 9),
+  };
+
+  const int bits[] = {3, 1, 2, 2, 2, 4};
+  uint32_t key = 0;
+
+  for(int i = 0; i < 6; ++i)
+  {
+    if(fields[i] < 0)
+    {
+      return false;
+    }
+
+    key = (key << bits[i]) | (uint32_t)fields[i];
+  }
+
+  const GLuint anisotropy = desc.max_anisotropy > 16 ? 16 : desc.max_anisotropy;
+  *out_key = (key << 5) | (anisotropy > 1 ? anisotropy : 0);
+
+  return true;
 }
 
-void
-Device::deleteVertexArrays(const size_t count,
-                           const uintptr_t vaos_to_destroy[])
+static size_t
+samplerCacheSlot(const Device &dev, const uint32_t key)
 {
-  GLuint *vaos = (GLuint*)malloc(count * sizeof(GLuint));
+  const size_t mask = dev.sampler_cache_capacity - 1;
+  size_t slot = thinHashCombine(thin_hash_seed, key) & mask;
 
-  // Convert to GLuint
-  for(size_t i = 0; i < count; ++i)
+  while(dev.sampler_cache[slot].sampler && dev.sampler_cache[slot].key != key)
   {
-    vaos[i] = (GLuint)vaos_to_destroy[i];
+    slot = (slot + 1) & mask;
   }
 
-  glDeleteVertexArrays(count, vaos);
+  return slot;
+}
 
-  #ifdef THIN_EXTRA_ERROR_CHECKS
-  getError("glDeleteVertexArrays");
-  #endif
 
-  free(vaos);
+// -------------------------------------------------------[ Extra Functions ]--
+/*
+  Entry points newer than the GL 4.0 glad was generated for, looked up by
+  hand when the driver reports them. Null otherwise.
+*/
+
+static bool
+glVersionAtLeast(const int major, const int minor)
+{
+  return GLVersion.major > major ||
+         (GLVersion.major == major && GLVersion.minor >= minor);
 }
 
+#ifndef THIN_NULL_BACKEND
 
-// -----------------------------------------------------------------[ Clear ]--
+static void
+glLoadExtra(const Device &dev, GLADloadproc get_proc)
+{
+  gl_tex_storage_2d = nullptr;
+  gl_tex_storage_3d = nullptr;
+  gl_bind_textures = nullptr;
 
-void
-Device::clearColor(const float r, const float g, const float b, const float a)
+  if(glVersionAtLeast(4, 2) || dev.hasCapability(GLCap::ARB_texture_storage))
+  {
+    gl_tex_storage_2d = (thin_tex_storage_2d_fn)get_proc("glTexStorage2D");
+    gl_tex_storage_3d = (thin_tex_storage_3d_fn)get_proc("glTexStorage3D");
+  }
+
+  if(glVersionAtLeast(4, 4) || dev.hasCapability(GLCap::ARB_multi_bind))
+  {
+    gl_bind_textures = (thin_bind_textures_fn)get_proc("glBindTextures");
+  }
+}
+
+#endif
+
+
+// ----------------------------------------------------------[ Null Backend ]--
+
+#ifdef THIN_NULL_BACKEND
+
+static uint64_t gl_null_counts[gl_id_count];
+static uint64_t gl_null_total = 0;
+static bool gl_null_recording = false;
+static GLNullCall *gl_null_calls = nullptr;
+static size_t gl_null_call_count = 0;
+static size_t gl_null_call_capacity = 0;
+static GLuint gl_null_next_name = 0;
+static void *gl_null_mapped = nullptr;
+static size_t gl_null_mapped_size = 0;
+
+template<typename T>
+static inline uint64_t
+glNullArg(T *ptr)
 {
-  glClearColor(r,g,b,a);
+  return (uint64_t)(uintptr_t)ptr;
+}
 
-  #ifdef THIN_EXTRA_PEDANTIC_ERROR_CHECKS
-  getError("glClearColor");
-  #endif
+template<typename T>
+static inline uint64_t
+glNullArg(const T value)
+{
+  return (uint64_t)value;
 }
 
-void
-Device::clearColor(const float color[4])
+static inline uint64_t
+glNullArg(const double value)
 {
-  enum {r = 0,g,b,a};
+  // Floats keep their bits, a cast would truncate.
+  uint64_t bits = 0;
+  memcpy(&bits, &value, sizeof(value));
 
-  clearColor(color[r], color[g], color[b], color[a]);
+  return bits;
 }
 
-void
-Device::clear(const GLbitfield mask)
+static inline uint64_t
+glNullArg(const float value)
 {
-  glClear(mask);
+  return glNullArg((double)value);
+}
 
-  #ifdef THIN_EXTRA_PEDANTIC_ERROR_CHECKS
-  getError("glClear");
-  #endif
+template<typename ...Args>
+static inline void
+glNullCall(const GLFunctionID id, Args... args)
+{
+  ++gl_null_counts[id];
+  ++gl_null_total;
+
+  if(!gl_null_recording)
+  {
+    return;
+  }
+
+  if(gl_null_call_count == gl_null_call_capacity)
+  {
+    gl_null_call_capacity = gl_null_call_capacity ? gl_null_call_capacity * 2 : 1024;
+    gl_null_calls = (GLNullCall*)realloc(gl_null_calls,
+                                         gl_null_call_capacity * sizeof(GLNullCall));
+  }
+
+  const uint64_t values[] = {glNullArg(args)..., 0};
+  const size_t arg_count = sizeof...(Args);
+
+  GLNullCall &call = gl_null_calls[gl_null_call_count++];
+  call.id = id;
+  call.arg_count = (uint16_t)arg_count;
+
+  for(size_t i = 0; i < 4; ++i)
+  {
+    call.args[i] = i < arg_count ? values[i] : 0;
+  }
 }
 
-void
-Device::clear(const bool color, const bool depth, const bool stencil)
+template<typename fn_type>
+struct GLNullStub;
+
+template<typename R, typename ...Args>
+struct GLNullStub<R(APIENTRYP)(Args...)>
 {
-  GLbitfield mask = 0;
-  if(color)   { mask |= GL_COLOR_BUFFER_BIT;   }
-  if(depth)   { mask |= GL_DEPTH_BUFFER_BIT;   }
-  if(stencil) { mask |= GL_STENCIL_BUFFER_BIT; }
+  // Default for anything not special cased below, zero or nothing.
+  template<size_t id>
+  static R APIENTRY
+  call(Args... args)
+  {
+    glNullCall((GLFunctionID)id, args...);
+    return R();
+  }
+};
 
-  clear(mask);
+template<size_t id>
+static void APIENTRY
+glNullGenNames(GLsizei n, GLuint *names)
+{
+  glNullCall((GLFunctionID)id, n, names);
+
+  for(GLsizei i = 0; i < n; ++i)
+  {
+    names[i] = ++gl_null_next_name;
+  }
 }
 
-void
-Device::clearColorBuffer()
+template<size_t id>
+static GLuint APIENTRY
+glNullCreateName(GLenum type)
 {
-  clear(GL_COLOR_BUFFER_BIT);
+  glNullCall((GLFunctionID)id, type);
+  return ++gl_null_next_name;
 }
 
-void
-Device::clearDepthBuffer()
+static GLuint APIENTRY
+glNullCreateProgram()
 {
-  clear(GL_DEPTH_BUFFER_BIT);
+  glNullCall(gl_id_glCreateProgram);
+  return ++gl_null_next_name;
+}
+
+static const GLubyte * APIENTRY
+glNullGetString(GLenum name)
+{
+  glNullCall(gl_id_glGetString, name);
+
+  switch(name)
+  {
+    case GL_VENDOR:                   return (const GLubyte*)"thin";
+    case GL_RENDERER:                 return (const GLubyte*)"thin null backend";
+    case GL_VERSION:                  return (const GLubyte*)"4.5 (Core Profile) thin null";
+    case GL_SHADING_LANGUAGE_VERSION: return (const GLubyte*)"4.50";
+  }
+
+  return (const GLubyte*)"";
+}
+
+static const GLubyte * APIENTRY
+glNullGetStringi(GLenum name, GLuint index)
+{
+  glNullCall(gl_id_glGetStringi, name, index);
+  return (const GLubyte*)"";
+}
+
+static void APIENTRY
+glNullGetIntegerv(GLenum pname, GLint *data)
+{
+  glNullCall(gl_id_glGetIntegerv, pname, data);
+
+  switch(pname)
+  {
+    case GL_MAJOR_VERSION:                      *data = 4; return;
+    case GL_MINOR_VERSION:                      *data = 5; return;
+    case GL_MAX_TEXTURE_SIZE:                   *data = 16384; return;
+    case GL_MAX_TEXTURE_IMAGE_UNITS:            *data = 32; return;
+    case GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS:   *data = 192; return;
+    case GL_MAX_VERTEX_ATTRIBS:                 *data = 16; return;
+    case GL_MAX_DRAW_BUFFERS:                   *data = 8; return;
+    case GL_MAX_COLOR_ATTACHMENTS:              *data = 8; return;
+    case GL_MAX_SAMPLES:                        *data = 8; return;
+    case GL_MAX_UNIFORM_BLOCK_SIZE:             *data = 65536; return;
+    case GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT:    *data = 256; return;
+    case GL_UNPACK_ALIGNMENT:                   *data = 4; return;
+
+    case GL_VIEWPORT:
+    case GL_SCISSOR_BOX:
+      memset(data, 0, 4 * sizeof(GLint));
+      return;
+  }
+
+  *data = 0;
+}
+
+static void APIENTRY
+glNullGetFloatv(GLenum pname, GLfloat *data)
+{
+  glNullCall(gl_id_glGetFloatv, pname, data);
+
+  const bool vec4 = pname == GL_COLOR_CLEAR_VALUE;
+  memset(data, 0, (vec4 ? 4 : 1) * sizeof(GLfloat));
+}
+
+static void APIENTRY
+glNullGetShaderiv(GLuint shader, GLenum pname, GLint *params)
+{
+  glNullCall(gl_id_glGetShaderiv, shader, pname, params);
+  *params = pname == GL_COMPILE_STATUS ? GL_TRUE : 0;
+}
+
+static void APIENTRY
+glNullGetProgramiv(GLuint program, GLenum pname, GLint *params)
+{
+  glNullCall(gl_id_glGetProgramiv, program, pname, params);
+  *params = pname == GL_LINK_STATUS || pname == GL_VALIDATE_STATUS ? GL_TRUE : 0;
 }
 
-void
-Device::clearStencilBuffer()
-{
-  clear(GL_STENCIL_BUFFER_BIT);
+template<size_t id>
+static void APIENTRY
+glNullGetInfoLog(GLuint object, GLsizei buf_size, GLsizei *length, GLchar *log)
+{
+  glNullCall((GLFunctionID)id, object, buf_size, length, log);
+
+  if(length)
+  {
+    *length = 0;
+  }
+
+  if(buf_size > 0)
+  {
+    log[0] = '\0';
+  }
+}
+
+static void APIENTRY
+glNullGetAttachedShaders(GLuint program, GLsizei max_count, GLsizei *count, GLuint *shaders)
+{
+  glNullCall(gl_id_glGetAttachedShaders, program, max_count, count, shaders);
+
+  if(count)
+  {
+    *count = 0;
+  }
+}
+
+static GLenum APIENTRY
+glNullCheckFramebufferStatus(GLenum target)
+{
+  glNullCall(gl_id_glCheckFramebufferStatus, target);
+  return GL_FRAMEBUFFER_COMPLETE;
+}
+
+static GLsync APIENTRY
+glNullFenceSync(GLenum condition, GLbitfield flags)
+{
+  glNullCall(gl_id_glFenceSync, condition, flags);
+  return (GLsync)(uintptr_t)++gl_null_next_name;
+}
+
+static GLenum APIENTRY
+glNullClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout)
+{
+  glNullCall(gl_id_glClientWaitSync, sync, flags, timeout);
+  return GL_ALREADY_SIGNALED;
+}
+
+static void APIENTRY
+glNullGetSynciv(GLsync sync, GLenum pname, GLsizei buf_size, GLsizei *length, GLint *values)
+{
+  glNullCall(gl_id_glGetSynciv, sync, pname, buf_size, length, values);
+
+  if(length)
+  {
+    *length = buf_size > 0;
+  }
+
+  if(buf_size > 0)
+  {
+    values[0] = pname == GL_SYNC_STATUS ? GL_SIGNALED : 0;
+  }
+}
+
+template<size_t id, typename T>
+static void APIENTRY
+glNullGetQueryObject(GLuint query, GLenum pname, T *params)
+{
+  glNullCall((GLFunctionID)id, query, pname, params);
+  *params = pname == GL_QUERY_RESULT_AVAILABLE ? 1 : 0;
+}
+
+static void * APIENTRY
+glNullMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+{
+  glNullCall(gl_id_glMapBufferRange, target, offset, length, access);
+
+  // One scratch block stands in for every mapping, contents go nowhere.
+  if((size_t)length > gl_null_mapped_size)
+  {
+    free(gl_null_mapped);
+    gl_null_mapped = malloc(length);
+    gl_null_mapped_size = length;
+  }
+
+  return gl_null_mapped;
+}
+
+static GLboolean APIENTRY
+glNullUnmapBuffer(GLenum target)
+{
+  glNullCall(gl_id_glUnmapBuffer, target);
+  return GL_TRUE;
+}
+
+static void
+glLoadNull()
+{
+  #define THIN_GL_FUNCTION(name) \
+    glad_##name = &GLNullStub<decltype(glad_##name)>::template call<gl_id_##name>;
+  #include "glad_functions.inl"
+  #undef THIN_GL_FUNCTION
+
+  glad_glGenBuffers = &glNullGenNames<gl_id_glGenBuffers>;
+  glad_glGenFramebuffers = &glNullGenNames<gl_id_glGenFramebuffers>;
+  glad_glGenQueries = &glNullGenNames<gl_id_glGenQueries>;
+  glad_glGenRenderbuffers = &glNullGenNames<gl_id_glGenRenderbuffers>;
+  glad_glGenSamplers = &glNullGenNames<gl_id_glGenSamplers>;
+  glad_glGenTextures = &glNullGenNames<gl_id_glGenTextures>;
+  glad_glGenTransformFeedbacks = &glNullGenNames<gl_id_glGenTransformFeedbacks>;
+  glad_glGenVertexArrays = &glNullGenNames<gl_id_glGenVertexArrays>;
+  glad_glCreateShader = &glNullCreateName<gl_id_glCreateShader>;
+  glad_glCreateProgram = &glNullCreateProgram;
+
+  glad_glGetString = &glNullGetString;
+  glad_glGetStringi = &glNullGetStringi;
+  glad_glGetIntegerv = &glNullGetIntegerv;
+  glad_glGetFloatv = &glNullGetFloatv;
+  glad_glGetShaderiv = &glNullGetShaderiv;
+  glad_glGetProgramiv = &glNullGetProgramiv;
+  glad_glGetShaderInfoLog = &glNullGetInfoLog<gl_id_glGetShaderInfoLog>;
+  glad_glGetProgramInfoLog = &glNullGetInfoLog<gl_id_glGetProgramInfoLog>;
+  glad_glGetAttachedShaders = &glNullGetAttachedShaders;
+  glad_glGetQueryObjectiv = &glNullGetQueryObject<gl_id_glGetQueryObjectiv, GLint>;
+  glad_glGetQueryObjectuiv = &glNullGetQueryObject<gl_id_glGetQueryObjectuiv, GLuint>;
+  glad_glGetQueryObjecti64v = &glNullGetQueryObject<gl_id_glGetQueryObjecti64v, GLint64>;
+  glad_glGetQueryObjectui64v = &glNullGetQueryObject<gl_id_glGetQueryObjectui64v, GLuint64>;
+
+  glad_glCheckFramebufferStatus = &glNullCheckFramebufferStatus;
+  glad_glFenceSync = &glNullFenceSync;
+  glad_glClientWaitSync = &glNullClientWaitSync;
+  glad_glGetSynciv = &glNullGetSynciv;
+  glad_glMapBufferRange = &glNullMapBufferRange;
+  glad_glUnmapBuffer = &glNullUnmapBuffer;
+
+  // Reports 4.5, so these are there too.
+  #define THIN_GL_EXTRA(name, ptr) \
+    ptr = &GLNullStub<decltype(ptr)>::template call<gl_id_##name>;
+  THIN_GL_EXTRA_FUNCTIONS(THIN_GL_EXTRA)
+  #undef THIN_GL_EXTRA
+
+  glLoadVersion();
+}
+
+void
+glNullRecord(const bool record)
+{
+  gl_null_recording = record;
+}
+
+const GLNullCall *
+glNullCalls(size_t *out_count)
+{
+  *out_count = gl_null_call_count;
+  return gl_null_calls;
+}
+
+uint64_t
+glNullCallCount()
+{
+  return gl_null_total;
+}
+
+uint64_t
+glNullCallCount(const GLFunctionID id)
+{
+  return id < gl_id_count ? gl_null_counts[id] : 0;
+}
+
+void
+glNullReset()
+{
+  // Names keep counting up so nothing handed out earlier is reused.
+  memset(gl_null_counts, 0, sizeof(gl_null_counts));
+  gl_null_total = 0;
+  gl_null_call_count = 0;
+}
+
+#endif
+
+
+// -----------------------------------------------------------------[ Trace ]--
+
+#ifdef THIN_TRACE
+
+constexpr size_t gl_trace_max_threads = 16;
+
+// Single producer (the owning thread), single consumer (the writer).
+struct GLTraceRing
+{
+  uint8_t             *data;
+  size_t              mask;
+  std::atomic<size_t> head;
+  std::atomic<size_t> tail;
+  uint8_t             thread;
+};
+
+static GLTraceRing gl_trace_rings[gl_trace_max_threads];
+static std::atomic<uint32_t> gl_trace_ring_count(0);
+static std::atomic<uint32_t> gl_trace_generation(0);
+static std::atomic<bool> gl_trace_running(false);
+static std::atomic<uint32_t> gl_trace_writing(0);
+static size_t gl_trace_ring_bytes = 0;
+static FILE *gl_trace_file = nullptr;
+static std::mutex gl_trace_file_lock;   // Held for each drain or direct write.
+static std::thread gl_trace_writer;
+static std::chrono::steady_clock::time_point gl_trace_start;
+
+// What the trace stubs call through to, and what glTraceEnd puts back.
+static void *gl_trace_real[gl_id_count];
+
+template<typename T>
+struct GLTraceArg
+{
+  static uint64_t to(const T value) { return (uint64_t)value; }
+};
+
+template<typename T>
+struct GLTraceArg<T*>
+{
+  static uint64_t to(T *ptr) { return (uint64_t)(uintptr_t)ptr; }
+};
+
+template<>
+struct GLTraceArg<float>
+{
+  static uint64_t to(const float value)
+  {
+    uint32_t bits = 0;
+    memcpy(&bits, &value, sizeof(value));
+    return bits;
+  }
+};
+
+template<>
+struct GLTraceArg<double>
+{
+  static uint64_t to(const double value)
+  {
+    uint64_t bits = 0;
+    memcpy(&bits, &value, sizeof(value));
+    return bits;
+  }
+};
+
+static inline uint64_t
+glTraceNow()
+{
+  const auto now = std::chrono::steady_clock::now() - gl_trace_start;
+  return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+static GLTraceRing *
+glTraceThreadRing()
+{
+  // Rings are handed out once per thread per session.
+  thread_local GLTraceRing *ring = nullptr;
+  thread_local uint32_t generation = 0;
+
+  const uint32_t curr_generation = gl_trace_generation.load(std::memory_order_acquire);
+
+  if(ring && generation == curr_generation)
+  {
+    return ring;
+  }
+
+  const uint32_t index = gl_trace_ring_count.fetch_add(1);
+
+  if(index >= gl_trace_max_threads)
+  {
+    return nullptr;
+  }
+
+  ring = &gl_trace_rings[index];
+  generation = curr_generation;
+
+  return ring;
+}
+
+static void
+glTraceRingWrite(GLTraceRing *ring, size_t at, const void *src, const size_t bytes)
+{
+  const size_t size = ring->mask + 1;
+  const size_t start = at & ring->mask;
+  const size_t first = bytes < size - start ? bytes : size - start;
+
+  memcpy(ring->data + start, src, first);
+  memcpy(ring->data, (const uint8_t*)src + first, bytes - first);
+}
+
+static void glTraceDrain(GLTraceRing &ring);
+
+static void
+glTraceWriteFile(GLTraceRing *ring,
+                 const GLTraceRecord &record,
+                 const uint64_t *args,
+                 const size_t arg_count,
+                 const uint64_t *ret,
+                 const void *payload,
+                 const size_t padded)
+{
+  const uint64_t zero = 0;
+
+  std::lock_guard<std::mutex> lock(gl_trace_file_lock);
+
+  // What this thread wrote before goes first.
+  glTraceDrain(*ring);
+
+  fwrite(&record, sizeof(record), 1, gl_trace_file);
+  fwrite(args, sizeof(uint64_t), arg_count, gl_trace_file);
+
+  if(ret)
+  {
+    fwrite(ret, sizeof(uint64_t), 1, gl_trace_file);
+  }
+
+  fwrite(payload, 1, record.payload_size, gl_trace_file);
+  fwrite(&zero, 1, padded - record.payload_size, gl_trace_file);
+}
+
+static void
+glTraceWriteRing(GLTraceRing *ring,
+                 const uint16_t id,
+                 const uint64_t time_ns,
+                 const uint64_t *args,
+                 const size_t arg_count,
+                 const uint64_t *ret,
+                 const void *payload,
+                 const size_t payload_size)
+{
+
+  const size_t padded = (payload_size + 7) & ~(size_t)7;
+  const size_t bytes = sizeof(GLTraceRecord) +
+                       (arg_count + (ret ? 1 : 0)) * sizeof(uint64_t) +
+                       padded;
+
+  GLTraceRecord record;
+  record.time_ns = time_ns;
+  record.id = id;
+  record.arg_count = (uint8_t)arg_count;
+  record.flags = (uint8_t)((ret ? gl_trace_has_return : 0) | (ring->thread << 4));
+  record.payload_size = (uint32_t)payload_size;
+
+  // Can never fit, skip the ring rather than drop it.
+  if(bytes > ring->mask + 1)
+  {
+    glTraceWriteFile(ring, record, args, arg_count, ret, payload, padded);
+    return;
+  }
+
+  const size_t head = ring->head.load(std::memory_order_relaxed);
+
+  // Full, wait on the writer rather than drop, a gap breaks replay.
+  while(head + bytes - ring->tail.load(std::memory_order_acquire) > ring->mask + 1)
+  {
+    if(!gl_trace_running.load(std::memory_order_relaxed))
+    {
+      return;
+    }
+
+    std::this_thread::yield();
+  }
+
+  const size_t start = head & ring->mask;
+
+  if(start + bytes <= ring->mask + 1)
+  {
+    // Common case, the record doesn't straddle the end of the ring.
+    uint8_t *dst = ring->data + start;
+    memcpy(dst, &record, sizeof(record));
+
+    uint64_t *dst_args = (uint64_t*)(dst + sizeof(record));
+
+    for(size_t i = 0; i < arg_count; ++i)
+    {
+      dst_args[i] = args[i];
+    }
+
+    if(ret)
+    {
+      dst_args[arg_count] = *ret;
+    }
+
+    if(payload_size)
+    {
+      uint8_t *dst_payload = (uint8_t*)(dst_args + arg_count + (ret ? 1 : 0));
+
+      memcpy(dst_payload, payload, payload_size);
+      memset(dst_payload + payload_size, 0, padded - payload_size);
+    }
+  }
+  else
+  {
+    size_t at = head;
+
+    glTraceRingWrite(ring, at, &record, sizeof(record));
+    at += sizeof(record);
+
+    glTraceRingWrite(ring, at, args, arg_count * sizeof(uint64_t));
+    at += arg_count * sizeof(uint64_t);
+
+    if(ret)
+    {
+      glTraceRingWrite(ring, at, ret, sizeof(uint64_t));
+      at += sizeof(uint64_t);
+    }
+
+    if(payload_size)
+    {
+      const uint64_t zero = 0;
+
+      glTraceRingWrite(ring, at, payload, payload_size);
+      glTraceRingWrite(ring, at + payload_size, &zero, padded - payload_size);
+    }
+  }
+
+  ring->head.store(head + bytes, std::memory_order_release);
+}
+
+static void
+glTraceWrite(const uint16_t id,
+             const uint64_t time_ns,
+             const uint64_t *args,
+             const size_t arg_count,
+             const uint64_t *ret,
+             const void *payload = nullptr,
+             const size_t payload_size = 0)
+{
+  // Counted so glTraceEnd can wait for stubs still writing before it frees
+  // the rings, checked after counting so no write starts once it's waiting.
+  gl_trace_writing.fetch_add(1);
+
+  GLTraceRing *ring = glTraceThreadRing();
+
+  if(ring && gl_trace_running.load())
+  {
+    glTraceWriteRing(ring, id, time_ns, args, arg_count, ret, payload, payload_size);
+  }
+
+  gl_trace_writing.fetch_sub(1, std::memory_order_release);
+}
+
+template<typename ...Args>
+static inline void
+glTraceCall(const GLFunctionID id,
+            const uint64_t time_ns,
+            const uint64_t *ret,
+            const void *payload,
+            const size_t payload_size,
+            Args... args)
+{
+  const uint64_t values[] = {GLTraceArg<Args>::to(args)..., 0};
+  glTraceWrite(id, time_ns, values, sizeof...(Args), ret, payload, payload_size);
+}
+
+template<typename fn_type>
+struct GLTraceStub;
+
+template<typename R, typename ...Args>
+struct GLTraceStub<R(APIENTRYP)(Args...)>
+{
+  template<size_t id>
+  static R APIENTRY
+  call(Args... args)
+  {
+    using fn_type = R(APIENTRYP)(Args...);
+
+    const uint64_t time_ns = glTraceNow();
+    const R result = ((fn_type)gl_trace_real[id])(args...);
+    const uint64_t ret = GLTraceArg<R>::to(result);
+
+    glTraceCall((GLFunctionID)id, time_ns, &ret, nullptr, 0, args...);
+
+    return result;
+  }
+};
+
+template<typename ...Args>
+struct GLTraceStub<void(APIENTRYP)(Args...)>
+{
+  template<size_t id>
+  static void APIENTRY
+  call(Args... args)
+  {
+    using fn_type = void(APIENTRYP)(Args...);
+
+    const uint64_t time_ns = glTraceNow();
+    ((fn_type)gl_trace_real[id])(args...);
+
+    glTraceCall((GLFunctionID)id, time_ns, nullptr, nullptr, 0, args...);
+  }
+};
+
+// Calls whose pointers are read by GL get their data copied into the record.
+
+template<size_t id>
+static void APIENTRY
+glTraceGenNames(GLsizei n, GLuint *names)
+{
+  const uint64_t time_ns = glTraceNow();
+  ((PFNGLGENBUFFERSPROC)gl_trace_real[id])(n, names);
+
+  glTraceCall((GLFunctionID)id, time_ns, nullptr, names, n * sizeof(GLuint), n, names);
+}
+
+template<size_t id>
+static void APIENTRY
+glTraceDeleteNames(GLsizei n, const GLuint *names)
+{
+  const uint64_t time_ns = glTraceNow();
+  ((PFNGLDELETEBUFFERSPROC)gl_trace_real[id])(n, names);
+
+  glTraceCall((GLFunctionID)id, time_ns, nullptr, names, n * sizeof(GLuint), n, names);
+}
+
+template<size_t id, typename T, size_t components>
+static void APIENTRY
+glTraceUniformv(GLint location, GLsizei count, const T *value)
+{
+  using fn_type = void(APIENTRYP)(GLint, GLsizei, const T*);
+
+  const uint64_t time_ns = glTraceNow();
+  ((fn_type)gl_trace_real[id])(location, count, value);
+
+  glTraceCall((GLFunctionID)id, time_ns, nullptr,
+              value, count * components * sizeof(T),
+              location, count, value);
+}
+
+template<size_t id, typename T, size_t components>
+static void APIENTRY
+glTraceUniformMatrixv(GLint location, GLsizei count, GLboolean transpose, const T *value)
+{
+  using fn_type = void(APIENTRYP)(GLint, GLsizei, GLboolean, const T*);
+
+  const uint64_t time_ns = glTraceNow();
+  ((fn_type)gl_trace_real[id])(location, count, transpose, value);
+
+  glTraceCall((GLFunctionID)id, time_ns, nullptr,
+              value, count * components * sizeof(T),
+              location, count, transpose, value);
+}
+
+template<size_t id>
+static GLint APIENTRY
+glTraceGetLocation(GLuint program, const GLchar *name)
+{
+  const uint64_t time_ns = glTraceNow();
+  const GLint loc = ((PFNGLGETUNIFORMLOCATIONPROC)gl_trace_real[id])(program, name);
+  const uint64_t ret = (uint64_t)loc;
+
+  glTraceCall((GLFunctionID)id, time_ns, &ret, name, strlen(name) + 1, program, name);
+
+  return loc;
+}
+
+static void APIENTRY
+glTraceBindFragDataLocation(GLuint program, GLuint color, const GLchar *name)
+{
+  const uint64_t time_ns = glTraceNow();
+  ((PFNGLBINDFRAGDATALOCATIONPROC)gl_trace_real[gl_id_glBindFragDataLocation])(program, color, name);
+
+  glTraceCall(gl_id_glBindFragDataLocation, time_ns, nullptr,
+              name, strlen(name) + 1,
+              program, color, name);
+}
+
+static void APIENTRY
+glTraceShaderSource(GLuint shader, GLsizei count, const GLchar *const *strings, const GLint *lengths)
+{
+  const uint64_t time_ns = glTraceNow();
+  ((PFNGLSHADERSOURCEPROC)gl_trace_real[gl_id_glShaderSource])(shader, count, strings, lengths);
+
+  // Strings are stored joined, each with a terminator, lengths are dropped.
+  size_t bytes = 0;
+
+  for(GLsizei i = 0; i < count; ++i)
+  {
+    bytes += (lengths && lengths[i] >= 0 ? (size_t)lengths[i] : strlen(strings[i])) + 1;
+  }
+
+  char *joined = (char*)malloc(bytes ? bytes : 1);
+  char *at = joined;
+
+  for(GLsizei i = 0; i < count; ++i)
+  {
+    const size_t len = lengths && lengths[i] >= 0 ? (size_t)lengths[i] : strlen(strings[i]);
+
+    memcpy(at, strings[i], len);
+    at[len] = '\0';
+    at += len + 1;
+  }
+
+  glTraceCall(gl_id_glShaderSource, time_ns, nullptr,
+              joined, bytes,
+              shader, count, strings, (const GLint*)nullptr);
+
+  free(joined);
+}
+
+static void APIENTRY
+glTraceBufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usage)
+{
+  const uint64_t time_ns = glTraceNow();
+  ((PFNGLBUFFERDATAPROC)gl_trace_real[gl_id_glBufferData])(target, size, data, usage);
+
+  glTraceCall(gl_id_glBufferData, time_ns, nullptr,
+              data, data ? size : 0,
+              target, size, data, usage);
+}
+
+static void APIENTRY
+glTraceBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void *data)
+{
+  const uint64_t time_ns = glTraceNow();
+  ((PFNGLBUFFERSUBDATAPROC)gl_trace_real[gl_id_glBufferSubData])(target, offset, size, data);
+
+  glTraceCall(gl_id_glBufferSubData, time_ns, nullptr,
+              data, data ? size : 0,
+              target, offset, size, data);
+}
+
+static bool
+glTraceUnpackBufferBound()
+{
+  // With a PBO bound the pixel pointer is an offset, nothing to copy.
+  GLint pbo = 0;
+  ((PFNGLGETINTEGERVPROC)gl_trace_real[gl_id_glGetIntegerv])(GL_PIXEL_UNPACK_BUFFER_BINDING, &pbo);
+
+  return pbo != 0;
+}
+
+static void APIENTRY
+glTraceTexImage2D(GLenum target, GLint level, GLint internal_format,
+                  GLsizei width, GLsizei height, GLint border,
+                  GLenum format, GLenum type, const void *pixels)
+{
+  const uint64_t time_ns = glTraceNow();
+  ((PFNGLTEXIMAGE2DPROC)gl_trace_real[gl_id_glTexImage2D])(target, level, internal_format,
+                                                           width, height, border,
+                                                           format, type, pixels);
+
+  const bool copy = pixels && !glTraceUnpackBufferBound();
+
+  glTraceCall(gl_id_glTexImage2D, time_ns, nullptr,
+              pixels, copy ? pixelDataSize(width, height, format, type) : 0,
+              target, level, internal_format, width, height, border, format, type, pixels);
+}
+
+static void APIENTRY
+glTraceTexSubImage2D(GLenum target, GLint level, GLint x, GLint y,
+                     GLsizei width, GLsizei height,
+                     GLenum format, GLenum type, const void *pixels)
+{
+  const uint64_t time_ns = glTraceNow();
+  ((PFNGLTEXSUBIMAGE2DPROC)gl_trace_real[gl_id_glTexSubImage2D])(target, level, x, y,
+                                                                 width, height,
+                                                                 format, type, pixels);
+
+  const bool copy = pixels && !glTraceUnpackBufferBound();
+
+  glTraceCall(gl_id_glTexSubImage2D, time_ns, nullptr,
+              pixels, copy ? pixelDataSize(width, height, format, type) : 0,
+              target, level, x, y, width, height, format, type, pixels);
+}
+
+static void APIENTRY
+glTraceCompressedTexImage2D(GLenum target, GLint level, GLenum internal_format,
+                            GLsizei width, GLsizei height, GLint border,
+                            GLsizei image_size, const void *data)
+{
+  const uint64_t time_ns = glTraceNow();
+  ((PFNGLCOMPRESSEDTEXIMAGE2DPROC)gl_trace_real[gl_id_glCompressedTexImage2D])(target, level,
+                                                                               internal_format,
+                                                                               width, height,
+                                                                               border,
+                                                                               image_size, data);
+
+  const bool copy = data && !glTraceUnpackBufferBound();
+
+  glTraceCall(gl_id_glCompressedTexImage2D, time_ns, nullptr,
+              data, copy ? image_size : 0,
+              target, level, internal_format, width, height, border, image_size, data);
+}
+
+static void APIENTRY
+glTraceTexImage3D(GLenum target, GLint level, GLint internal_format,
+                  GLsizei width, GLsizei height, GLsizei depth, GLint border,
+                  GLenum format, GLenum type, const void *pixels)
+{
+  const uint64_t time_ns = glTraceNow();
+  ((PFNGLTEXIMAGE3DPROC)gl_trace_real[gl_id_glTexImage3D])(target, level, internal_format,
+                                                           width, height, depth, border,
+                                                           format, type, pixels);
+
+  const bool copy = pixels && !glTraceUnpackBufferBound();
+
+  glTraceCall(gl_id_glTexImage3D, time_ns, nullptr,
+              pixels, copy ? pixelDataSize(width, height * depth, format, type) : 0,
+              target, level, internal_format, width, height, depth, border, format, type, pixels);
+}
+
+static void APIENTRY
+glTraceTexSubImage3D(GLenum target, GLint level, GLint x, GLint y, GLint z,
+                     GLsizei width, GLsizei height, GLsizei depth,
+                     GLenum format, GLenum type, const void *pixels)
+{
+  const uint64_t time_ns = glTraceNow();
+  ((PFNGLTEXSUBIMAGE3DPROC)gl_trace_real[gl_id_glTexSubImage3D])(target, level, x, y, z,
+                                                                 width, height, depth,
+                                                                 format, type, pixels);
+
+  const bool copy = pixels && !glTraceUnpackBufferBound();
+
+  glTraceCall(gl_id_glTexSubImage3D, time_ns, nullptr,
+              pixels, copy ? pixelDataSize(width, height * depth, format, type) : 0,
+              target, level, x, y, z, width, height, depth, format, type, pixels);
+}
+
+static void APIENTRY
+glTraceCompressedTexSubImage2D(GLenum target, GLint level, GLint x, GLint y,
+                               GLsizei width, GLsizei height, GLenum format,
+                               GLsizei image_size, const void *data)
+{
+  const uint64_t time_ns = glTraceNow();
+  ((PFNGLCOMPRESSEDTEXSUBIMAGE2DPROC)gl_trace_real[gl_id_glCompressedTexSubImage2D])(target, level,
+                                                                                     x, y,
+                                                                                     width, height,
+                                                                                     format,
+                                                                                     image_size, data);
+
+  const bool copy = data && !glTraceUnpackBufferBound();
+
+  glTraceCall(gl_id_glCompressedTexSubImage2D, time_ns, nullptr,
+              data, copy ? image_size : 0,
+              target, level, x, y, width, height, format, image_size, data);
+}
+
+template<size_t id, typename T>
+static void APIENTRY
+glTraceSamplerParameterv(GLuint sampler, GLenum pname, const T *params)
+{
+  using fn_type = void(APIENTRYP)(GLuint, GLenum, const T*);
+
+  const uint64_t time_ns = glTraceNow();
+  ((fn_type)gl_trace_real[id])(sampler, pname, params);
+
+  // The border color is the only one with more than one value.
+  const size_t count = pname == GL_TEXTURE_BORDER_COLOR ? 4 : 1;
+
+  glTraceCall((GLFunctionID)id, time_ns, nullptr,
+              params, count * sizeof(T),
+              sampler, pname, params);
+}
+
+static inline size_t
+glTraceStringSize(const GLsizei length, const GLchar *str)
+{
+  // Negative length is zero terminated, copied with the terminator.
+  return length >= 0 ? (size_t)length : strlen(str) + 1;
+}
+
+static void APIENTRY
+glTracePushDebugGroup(GLenum source, GLuint id, GLsizei length, const GLchar *message)
+{
+  const uint64_t time_ns = glTraceNow();
+  ((PFNGLPUSHDEBUGGROUPPROC)gl_trace_real[gl_id_glPushDebugGroup])(source, id, length, message);
+
+  glTraceCall(gl_id_glPushDebugGroup, time_ns, nullptr,
+              message, glTraceStringSize(length, message),
+              source, id, length, message);
+}
+
+static void APIENTRY
+glTraceDebugMessageInsert(GLenum source, GLenum type, GLuint id, GLenum severity,
+                          GLsizei length, const GLchar *buf)
+{
+  const uint64_t time_ns = glTraceNow();
+  ((PFNGLDEBUGMESSAGEINSERTPROC)gl_trace_real[gl_id_glDebugMessageInsert])(source, type, id,
+                                                                           severity,
+                                                                           length, buf);
+
+  glTraceCall(gl_id_glDebugMessageInsert, time_ns, nullptr,
+              buf, glTraceStringSize(length, buf),
+              source, type, id, severity, length, buf);
+}
+
+template<size_t id>
+static void APIENTRY
+glTraceMarker(GLsizei length, const GLchar *marker)
+{
+  const uint64_t time_ns = glTraceNow();
+  ((PFNGLINSERTEVENTMARKEREXTPROC)gl_trace_real[id])(length, marker);
+
+  // EXT_debug_marker takes zero, not a negative length, for terminated.
+  glTraceCall((GLFunctionID)id, time_ns, nullptr,
+              marker, glTraceStringSize(length ? length : -1, marker),
+              length, marker);
+}
+
+// Writes through a mapping never pass through GL, the mapped range is
+// recorded as a glBufferSubData when it is unmapped.
+struct GLTraceMapping
+{
+  GLenum      target;
+  GLintptr    offset;
+  GLsizeiptr  length;
+  void        *data;
+};
+
+constexpr size_t gl_trace_max_mappings = 8;
+
+// Per thread, a mapping belongs to the context current on it.
+static thread_local GLTraceMapping gl_trace_mappings[gl_trace_max_mappings];
+
+static void
+glTraceMapped(const GLenum target, const GLintptr offset, const GLsizeiptr length, void *data)
+{
+  for(GLTraceMapping &mapping : gl_trace_mappings)
+  {
+    if(!mapping.data || mapping.target == target)
+    {
+      mapping.target = target;
+      mapping.offset = offset;
+      mapping.length = length;
+      mapping.data = data;
+      return;
+    }
+  }
+}
+
+static void * APIENTRY
+glTraceMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+{
+  const uint64_t time_ns = glTraceNow();
+  void *data = ((PFNGLMAPBUFFERRANGEPROC)gl_trace_real[gl_id_glMapBufferRange])(target, offset,
+                                                                                length, access);
+  const uint64_t ret = GLTraceArg<void*>::to(data);
+
+  glTraceCall(gl_id_glMapBufferRange, time_ns, &ret, nullptr, 0, target, offset, length, access);
+
+  if(data && (access & GL_MAP_WRITE_BIT))
+  {
+    glTraceMapped(target, offset, length, data);
+  }
+
+  return data;
+}
+
+static void * APIENTRY
+glTraceMapBuffer(GLenum target, GLenum access)
+{
+  const uint64_t time_ns = glTraceNow();
+  void *data = ((PFNGLMAPBUFFERPROC)gl_trace_real[gl_id_glMapBuffer])(target, access);
+  const uint64_t ret = GLTraceArg<void*>::to(data);
+
+  glTraceCall(gl_id_glMapBuffer, time_ns, &ret, nullptr, 0, target, access);
+
+  if(data && access != GL_READ_ONLY)
+  {
+    GLint size = 0;
+    ((PFNGLGETBUFFERPARAMETERIVPROC)gl_trace_real[gl_id_glGetBufferParameteriv])(target,
+                                                                                 GL_BUFFER_SIZE,
+                                                                                 &size);
+    glTraceMapped(target, 0, size, data);
+  }
+
+  return data;
+}
+
+static GLboolean APIENTRY
+glTraceUnmapBuffer(GLenum target)
+{
+  const uint64_t time_ns = glTraceNow();
+
+  for(GLTraceMapping &mapping : gl_trace_mappings)
+  {
+    if(mapping.data && mapping.target == target)
+    {
+      // Before the unmap, the pointer is dead after it.
+      glTraceCall(gl_id_glBufferSubData, time_ns, nullptr,
+                  mapping.data, (size_t)mapping.length,
+                  target, mapping.offset, mapping.length, (const void*)mapping.data);
+
+      mapping.data = nullptr;
+    }
+  }
+
+  const GLboolean result = ((PFNGLUNMAPBUFFERPROC)gl_trace_real[gl_id_glUnmapBuffer])(target);
+  const uint64_t ret = result;
+
+  glTraceCall(gl_id_glUnmapBuffer, time_ns, &ret, nullptr, 0, target);
+
+  return result;
+}
+
+static void APIENTRY
+glTraceDrawBuffers(GLsizei n, const GLenum *bufs)
+{
+  const uint64_t time_ns = glTraceNow();
+  ((PFNGLDRAWBUFFERSPROC)gl_trace_real[gl_id_glDrawBuffers])(n, bufs);
+
+  glTraceCall(gl_id_glDrawBuffers, time_ns, nullptr, bufs, n * sizeof(GLenum), n, bufs);
+}
+
+static void APIENTRY
+glTraceBindTextures(GLuint first, GLsizei count, const GLuint *textures)
+{
+  const uint64_t time_ns = glTraceNow();
+  ((thin_bind_textures_fn)gl_trace_real[gl_id_glBindTextures])(first, count, textures);
+
+  // Null textures unbinds the range, nothing to copy.
+  glTraceCall(gl_id_glBindTextures, time_ns, nullptr,
+              textures, textures ? count * sizeof(GLuint) : 0,
+              first, count, textures);
+}
+
+static void
+glTraceDrain(GLTraceRing &ring)
+{
+  // Callers hold gl_trace_file_lock.
+  const size_t head = ring.head.load(std::memory_order_acquire);
+  const size_t tail = ring.tail.load(std::memory_order_relaxed);
+
+  if(head == tail)
+  {
+    return;
+  }
+
+  const size_t size = ring.mask + 1;
+  const size_t start = tail & ring.mask;
+  const size_t bytes = head - tail;
+  const size_t first = bytes < size - start ? bytes : size - start;
+
+  fwrite(ring.data + start, 1, first, gl_trace_file);
+  fwrite(ring.data, 1, bytes - first, gl_trace_file);
+
+  ring.tail.store(head, std::memory_order_release);
+}
+
+static void
+glTraceDrainAll()
+{
+  const uint32_t count = gl_trace_ring_count.load(std::memory_order_acquire);
+
+  std::lock_guard<std::mutex> lock(gl_trace_file_lock);
+
+  for(uint32_t i = 0; i < count && i < gl_trace_max_threads; ++i)
+  {
+    glTraceDrain(gl_trace_rings[i]);
+  }
+}
+
+bool
+glTraceBegin(const char *path, const size_t ring_bytes)
+{
+  if(gl_trace_running.load())
+  {
+    return false;
+  }
+
+  gl_trace_file = fopen(path, "wb");
+
+  if(!gl_trace_file)
+  {
+    return false;
+  }
+
+  const GLTraceFileHeader header = {gl_trace_magic, gl_trace_version, gl_id_count, 0};
+  fwrite(&header, sizeof(header), 1, gl_trace_file);
+
+  size_t size = 4096;
+  while(size < ring_bytes)
+  {
+    size *= 2;
+  }
+
+  gl_trace_ring_bytes = size;
+
+  for(size_t i = 0; i < gl_trace_max_threads; ++i)
+  {
+    GLTraceRing &ring = gl_trace_rings[i];
+
+    ring.data = (uint8_t*)malloc(size);
+    ring.mask = size - 1;
+    ring.head.store(0);
+    ring.tail.store(0);
+    ring.thread = (uint8_t)i;
+  }
+
+  gl_trace_ring_count.store(0);
+  gl_trace_generation.fetch_add(1);
+  gl_trace_start = std::chrono::steady_clock::now();
+
+  // Lazy stubs would write the real function over the trace stub on their
+  // first call, resolve everything now. What is null stays null, glTraceEnd
+  // puts these back.
+  for(size_t i = 0; i < gl_id_count; ++i)
+  {
+    #ifdef THIN_NULL_BACKEND
+    gl_trace_real[i] = *gl_function_slots[i];
+    #else
+    gl_trace_real[i] = gl_lazy_get_proc && *gl_function_slots[i] ?
+      gl_lazy_get_proc(gl_function_names[i]) :
+      *gl_function_slots[i];
+    #endif
+  }
+
+  #define THIN_GL_FUNCTION(name) \
+    if(glad_##name) { glad_##name = &GLTraceStub<decltype(glad_##name)>::template call<gl_id_##name>; }
+  #include "glad_functions.inl"
+  #undef THIN_GL_FUNCTION
+
+  #define THIN_GL_EXTRA(name, ptr) \
+    if(ptr) { ptr = &GLTraceStub<decltype(ptr)>::template call<gl_id_##name>; }
+  THIN_GL_EXTRA_FUNCTIONS(THIN_GL_EXTRA)
+  #undef THIN_GL_EXTRA
+
+  #define THIN_GL_TRACE(name, stub) \
+    if(glad_##name) { glad_##name = stub; }
+
+  THIN_GL_TRACE(glGenBuffers, &glTraceGenNames<gl_id_glGenBuffers>)
+  THIN_GL_TRACE(glGenFramebuffers, &glTraceGenNames<gl_id_glGenFramebuffers>)
+  THIN_GL_TRACE(glGenQueries, &glTraceGenNames<gl_id_glGenQueries>)
+  THIN_GL_TRACE(glGenRenderbuffers, &glTraceGenNames<gl_id_glGenRenderbuffers>)
+  THIN_GL_TRACE(glGenSamplers, &glTraceGenNames<gl_id_glGenSamplers>)
+  THIN_GL_TRACE(glGenTextures, &glTraceGenNames<gl_id_glGenTextures>)
+  THIN_GL_TRACE(glGenTransformFeedbacks, &glTraceGenNames<gl_id_glGenTransformFeedbacks>)
+  THIN_GL_TRACE(glGenVertexArrays, &glTraceGenNames<gl_id_glGenVertexArrays>)
+
+  THIN_GL_TRACE(glDeleteBuffers, &glTraceDeleteNames<gl_id_glDeleteBuffers>)
+  THIN_GL_TRACE(glDeleteFramebuffers, &glTraceDeleteNames<gl_id_glDeleteFramebuffers>)
+  THIN_GL_TRACE(glDeleteQueries, &glTraceDeleteNames<gl_id_glDeleteQueries>)
+  THIN_GL_TRACE(glDeleteRenderbuffers, &glTraceDeleteNames<gl_id_glDeleteRenderbuffers>)
+  THIN_GL_TRACE(glDeleteSamplers, &glTraceDeleteNames<gl_id_glDeleteSamplers>)
+  THIN_GL_TRACE(glDeleteTextures, &glTraceDeleteNames<gl_id_glDeleteTextures>)
+  THIN_GL_TRACE(glDeleteTransformFeedbacks, &glTraceDeleteNames<gl_id_glDeleteTransformFeedbacks>)
+  THIN_GL_TRACE(glDeleteVertexArrays, &glTraceDeleteNames<gl_id_glDeleteVertexArrays>)
+
+  THIN_GL_TRACE(glUniform1fv, (&glTraceUniformv<gl_id_glUniform1fv, GLfloat, 1>))
+  THIN_GL_TRACE(glUniform2fv, (&glTraceUniformv<gl_id_glUniform2fv, GLfloat, 2>))
+  THIN_GL_TRACE(glUniform3fv, (&glTraceUniformv<gl_id_glUniform3fv, GLfloat, 3>))
+  THIN_GL_TRACE(glUniform4fv, (&glTraceUniformv<gl_id_glUniform4fv, GLfloat, 4>))
+  THIN_GL_TRACE(glUniform1iv, (&glTraceUniformv<gl_id_glUniform1iv, GLint, 1>))
+  THIN_GL_TRACE(glUniform2iv, (&glTraceUniformv<gl_id_glUniform2iv, GLint, 2>))
+  THIN_GL_TRACE(glUniform3iv, (&glTraceUniformv<gl_id_glUniform3iv, GLint, 3>))
+  THIN_GL_TRACE(glUniform4iv, (&glTraceUniformv<gl_id_glUniform4iv, GLint, 4>))
+  THIN_GL_TRACE(glUniform1uiv, (&glTraceUniformv<gl_id_glUniform1uiv, GLuint, 1>))
+  THIN_GL_TRACE(glUniform2uiv, (&glTraceUniformv<gl_id_glUniform2uiv, GLuint, 2>))
+  THIN_GL_TRACE(glUniform3uiv, (&glTraceUniformv<gl_id_glUniform3uiv, GLuint, 3>))
+  THIN_GL_TRACE(glUniform4uiv, (&glTraceUniformv<gl_id_glUniform4uiv, GLuint, 4>))
+  THIN_GL_TRACE(glUniformMatrix2fv, (&glTraceUniformMatrixv<gl_id_glUniformMatrix2fv, GLfloat, 4>))
+  THIN_GL_TRACE(glUniformMatrix3fv, (&glTraceUniformMatrixv<gl_id_glUniformMatrix3fv, GLfloat, 9>))
+  THIN_GL_TRACE(glUniformMatrix4fv, (&glTraceUniformMatrixv<gl_id_glUniformMatrix4fv, GLfloat, 16>))
+
+  THIN_GL_TRACE(glGetUniformLocation, &glTraceGetLocation<gl_id_glGetUniformLocation>)
+  THIN_GL_TRACE(glGetAttribLocation, &glTraceGetLocation<gl_id_glGetAttribLocation>)
+  THIN_GL_TRACE(glBindFragDataLocation, &glTraceBindFragDataLocation)
+  THIN_GL_TRACE(glShaderSource, &glTraceShaderSource)
+  THIN_GL_TRACE(glBufferData, &glTraceBufferData)
+  THIN_GL_TRACE(glBufferSubData, &glTraceBufferSubData)
+  THIN_GL_TRACE(glTexImage2D, &glTraceTexImage2D)
+  THIN_GL_TRACE(glTexSubImage2D, &glTraceTexSubImage2D)
+  THIN_GL_TRACE(glCompressedTexImage2D, &glTraceCompressedTexImage2D)
+  THIN_GL_TRACE(glTexImage3D, &glTraceTexImage3D)
+  THIN_GL_TRACE(glTexSubImage3D, &glTraceTexSubImage3D)
+  THIN_GL_TRACE(glCompressedTexSubImage2D, &glTraceCompressedTexSubImage2D)
+  THIN_GL_TRACE(glSamplerParameterfv, (&glTraceSamplerParameterv<gl_id_glSamplerParameterfv, GLfloat>))
+  THIN_GL_TRACE(glSamplerParameteriv, (&glTraceSamplerParameterv<gl_id_glSamplerParameteriv, GLint>))
+  THIN_GL_TRACE(glSamplerParameterIiv, (&glTraceSamplerParameterv<gl_id_glSamplerParameterIiv, GLint>))
+  THIN_GL_TRACE(glSamplerParameterIuiv, (&glTraceSamplerParameterv<gl_id_glSamplerParameterIuiv, GLuint>))
+  THIN_GL_TRACE(glPushDebugGroup, &glTracePushDebugGroup)
+  THIN_GL_TRACE(glDebugMessageInsert, &glTraceDebugMessageInsert)
+  THIN_GL_TRACE(glInsertEventMarkerEXT, &glTraceMarker<gl_id_glInsertEventMarkerEXT>)
+  THIN_GL_TRACE(glPushGroupMarkerEXT, &glTraceMarker<gl_id_glPushGroupMarkerEXT>)
+  THIN_GL_TRACE(glMapBufferRange, &glTraceMapBufferRange)
+  THIN_GL_TRACE(glMapBuffer, &glTraceMapBuffer)
+  THIN_GL_TRACE(glUnmapBuffer, &glTraceUnmapBuffer)
+  THIN_GL_TRACE(glDrawBuffers, &glTraceDrawBuffers)
+
+  #undef THIN_GL_TRACE
+
+  if(gl_bind_textures) { gl_bind_textures = &glTraceBindTextures; }
+
+  gl_trace_running.store(true);
+
+  gl_trace_writer = std::thread([]()
+  {
+    while(gl_trace_running.load(std::memory_order_acquire))
+    {
+      glTraceDrainAll();
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  });
+
+  return true;
+}
+
+void
+glTraceFrame()
+{
+  glTraceWrite(gl_trace_frame, glTraceNow(), nullptr, 0, nullptr);
+}
+
+void
+glTraceEnd()
+{
+  if(!gl_trace_running.load())
+  {
+    return;
+  }
+
+  // Real functions back first, nothing new gets into the rings after this
+  // other than calls already inside a stub.
+  for(size_t i = 0; i < gl_id_count; ++i)
+  {
+    *gl_function_slots[i] = gl_trace_real[i];
+  }
+
+  gl_trace_running.store(false);
+  gl_trace_writer.join();
+
+  while(gl_trace_writing.load())
+  {
+    std::this_thread::yield();
+  }
+
+  glTraceDrainAll();
+
+  fclose(gl_trace_file);
+  gl_trace_file = nullptr;
+
+  for(size_t i = 0; i < gl_trace_max_threads; ++i)
+  {
+    free(gl_trace_rings[i].data);
+    gl_trace_rings[i].data = nullptr;
+  }
+}
+
+#endif
+
+
+// -------------------------------------------------------[ VAO Cache Utils ]--
+
+static uint64_t
+vaoCacheKey(const uint64_t layout_hash,
+            const size_t buffer_count,
+            const uintptr_t buffers[],
+            const uintptr_t index_buffer)
+{
+  uint64_t key = thinHashCombine(layout_hash, buffer_count);
+
+  for(size_t i = 0; i < buffer_count; ++i)
+  {
+    key = thinHashCombine(key, buffers[i]);
+  }
+
+  return thinHashCombine(key, index_buffer);
+}
+
+static bool
+vertexLayoutEqual(const VertexLayout &a, const VertexLayout &b)
+{
+  if(a.attrib_count != b.attrib_count ||
+     memcmp(a.strides, b.strides, sizeof(a.strides)) != 0)
+  {
+    return false;
+  }
+
+  // Field by field, padding in VertexAttrib is never written.
+  for(GLuint i = 0; i < a.attrib_count; ++i)
+  {
+    const VertexAttrib &x = a.attribs[i];
+    const VertexAttrib &y = b.attribs[i];
+
+    if(x.index != y.index || x.size != y.size || x.type != y.type ||
+       x.normalized != y.normalized || x.integer != y.integer ||
+       x.buffer != y.buffer || x.offset != y.offset || x.divisor != y.divisor)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static void
+vaoCacheErase(Device::VertexArrayCacheEntry *table,
+              const size_t capacity,
+              size_t slot)
+{
+  // Backward shift deletion, keeps the linear probe chains intact.
+  const size_t mask = capacity - 1;
+  size_t next = (slot + 1) & mask;
+
+  while(table[next].vao)
+  {
+    const size_t home = table[next].key & mask;
+
+    if(((next - home) & mask) >= ((next - slot) & mask))
+    {
+      table[slot] = table[next];
+      slot = next;
+    }
+
+    next = (next + 1) & mask;
+  }
+
+  memset(&table[slot], 0, sizeof(table[slot]));
+}
+
+static void
+vaoCacheInsert(Device::VertexArrayCacheEntry *table,
+               const size_t capacity,
+               const Device::VertexArrayCacheEntry &entry)
+{
+  const size_t mask = capacity - 1;
+  size_t slot = entry.key & mask;
+
+  while(table[slot].vao)
+  {
+    slot = (slot + 1) & mask;
+  }
+
+  table[slot] = entry;
+}
+
+static size_t
+vaoBufferRefSlot(const Device::VertexArrayBufferRef *table,
+                 const size_t capacity,
+                 const uintptr_t buffer)
+{
+  // Slot holding buffer, or the empty one it would go in.
+  const size_t mask = capacity - 1;
+  size_t slot = thinHashCombine(thin_hash_seed, buffer) & mask;
+
+  while(table[slot].buffer && table[slot].buffer != buffer)
+  {
+    slot = (slot + 1) & mask;
+  }
+
+  return slot;
+}
+
+static inline bool
+vaoBufferRefUsed(const Device &dev, const uintptr_t buffer)
+{
+  return dev.vao_buffer_refs_count &&
+         dev.vao_buffer_refs[vaoBufferRefSlot(dev.vao_buffer_refs,
+                                              dev.vao_buffer_refs_capacity,
+                                              buffer)].buffer;
+}
+
+static void
+vaoBufferRefAdd(Device &dev, const uintptr_t buffer)
+{
+  // Grow, keeps the load factor under a half.
+  if((dev.vao_buffer_refs_count + 1) * 2 > dev.vao_buffer_refs_capacity)
+  {
+    const size_t new_capacity = dev.vao_buffer_refs_capacity ? dev.vao_buffer_refs_capacity * 2 : 32;
+
+    Device::VertexArrayBufferRef *new_refs = (Device::VertexArrayBufferRef*)calloc(
+      new_capacity,
+      sizeof(Device::VertexArrayBufferRef));
+
+    for(size_t i = 0; i < dev.vao_buffer_refs_capacity; ++i)
+    {
+      const Device::VertexArrayBufferRef &ref = dev.vao_buffer_refs[i];
+
+      if(ref.buffer)
+      {
+        new_refs[vaoBufferRefSlot(new_refs, new_capacity, ref.buffer)] = ref;
+      }
+    }
+
+    free(dev.vao_buffer_refs);
+    dev.vao_buffer_refs = new_refs;
+    dev.vao_buffer_refs_capacity = new_capacity;
+  }
+
+  Device::VertexArrayBufferRef &ref =
+    dev.vao_buffer_refs[vaoBufferRefSlot(dev.vao_buffer_refs, dev.vao_buffer_refs_capacity, buffer)];
+
+  dev.vao_buffer_refs_count += ref.buffer ? 0 : 1;
+  ref.buffer = buffer;
+  ref.count += 1;
+}
+
+static void
+vaoBufferRefRemove(Device &dev, const uintptr_t buffer)
+{
+  Device::VertexArrayBufferRef *table = dev.vao_buffer_refs;
+  const size_t mask = dev.vao_buffer_refs_capacity - 1;
+  size_t slot = vaoBufferRefSlot(table, dev.vao_buffer_refs_capacity, buffer);
+
+  if(!table[slot].buffer || --table[slot].count)
+  {
+    return;
+  }
+
+  // Backward shift deletion, keeps the linear probe chains intact.
+  size_t next = (slot + 1) & mask;
+
+  while(table[next].buffer)
+  {
+    const size_t home = thinHashCombine(thin_hash_seed, table[next].buffer) & mask;
+
+    if(((next - home) & mask) >= ((next - slot) & mask))
+    {
+      table[slot] = table[next];
+      slot = next;
+    }
+
+    next = (next + 1) & mask;
+  }
+
+  memset(&table[slot], 0, sizeof(table[slot]));
+  --dev.vao_buffer_refs_count;
+}
+
+static void
+vaoBufferRefsUpdate(Device &dev, const Device::VertexArrayCacheEntry &entry, const bool add)
+{
+  for(size_t b = 0; b <= THIN_MAX_VERTEX_BUFFERS; ++b)
+  {
+    const uintptr_t buffer = b < THIN_MAX_VERTEX_BUFFERS ? entry.buffers[b] : entry.index_buffer;
+
+    if(buffer && add)
+    {
+      vaoBufferRefAdd(dev, buffer);
+    }
+    else if(buffer)
+    {
+      vaoBufferRefRemove(dev, buffer);
+    }
+  }
+}
+
+static void
+vaoCacheEvictBuffer(Device &dev, const uintptr_t buffer)
+{
+  // Most deleted buffers were never in a layout.
+  if(!vaoBufferRefUsed(dev, buffer))
+  {
+    return;
+  }
+
+  size_t i = 0;
+
+  while(i < dev.vao_cache_capacity)
+  {
+    Device::VertexArrayCacheEntry &entry = dev.vao_cache[i];
+    bool uses = entry.vao && entry.index_buffer == buffer;
+
+    for(size_t b = 0; entry.vao && b < THIN_MAX_VERTEX_BUFFERS; ++b)
+    {
+      uses |= entry.buffers[b] == buffer;
+    }
+
+    if(uses)
+    {
+      const GLuint vao = (GLuint)entry.vao;
+      glDeleteVertexArrays(1, &vao);
+      dev.stats.objects_deleted += 1;
+
+      // GL falls back to VAO 0, whose index buffer isn't known.
+      if(dev.bound_vertex_array == vao)
+      {
+        dev.bound_vertex_array = 0;
+        dev.bound_buffers[Device::thin_bind_index_buffer] = Device::thin_unknown_binding;
+      }
+
+      vaoBufferRefsUpdate(dev, entry, false);
+      vaoCacheErase(dev.vao_cache, dev.vao_cache_capacity, i);
+      --dev.vao_cache_count;
+
+      // Done once the last VAO using it is gone.
+      if(!vaoBufferRefUsed(dev, buffer))
+      {
+        return;
+      }
+
+      // Erasing can shift another entry into this slot so check it again.
+      continue;
+    }
+
+    ++i;
+  }
+}
+
+static void
+vaoCacheEvictVertexArray(Device &dev, const uintptr_t vao)
+{
+  for(size_t i = 0; i < dev.vao_cache_capacity; ++i)
+  {
+    if(dev.vao_cache[i].vao == vao)
+    {
+      vaoBufferRefsUpdate(dev, dev.vao_cache[i], false);
+      vaoCacheErase(dev.vao_cache, dev.vao_cache_capacity, i);
+      --dev.vao_cache_count;
+      return;
+    }
+  }
+}
+
+
+// -----------------------------------------------------[ Framebuffer Utils ]--
+
+static uint64_t
+fboCacheKey(const FramebufferDesc &desc)
+{
+  uint64_t key = thinHashCombine(thin_hash_seed, desc.depth_stencil);
+
+  for(size_t i = 0; i <= THIN_MAX_COLOR_ATTACHMENTS; ++i)
+  {
+    const FramebufferAttachment &att = i < THIN_MAX_COLOR_ATTACHMENTS ? desc.color[i] : desc.depth;
+
+    key = thinHashCombine(key, att.object);
+
+    // The rest means nothing without an object, fboAttachmentEqual agrees.
+    if(att.object)
+    {
+      key = thinHashCombine(key, (uint64_t)att.type << 32 | (uint32_t)att.level);
+      key = thinHashCombine(key, (uint32_t)att.layer);
+    }
+  }
+
+  return key;
+}
+
+static inline bool
+fboAttachmentEqual(const FramebufferAttachment &a, const FramebufferAttachment &b)
+{
+  return a.object == b.object && (!a.object ||
+         (a.type == b.type && a.level == b.level && a.layer == b.layer));
+}
+
+static bool
+fboDescEqual(const FramebufferDesc &a, const FramebufferDesc &b)
+{
+  for(size_t i = 0; i < THIN_MAX_COLOR_ATTACHMENTS; ++i)
+  {
+    if(!fboAttachmentEqual(a.color[i], b.color[i]))
+    {
+      return false;
+    }
+  }
+
+  return fboAttachmentEqual(a.depth, b.depth) && a.depth_stencil == b.depth_stencil;
+}
+
+static void
+fboCacheErase(Device::FramebufferCacheEntry *table,
+              const size_t capacity,
+              size_t slot)
+{
+  // Backward shift deletion, keeps the linear probe chains intact.
+  const size_t mask = capacity - 1;
+  size_t next = (slot + 1) & mask;
+
+  while(table[next].framebuffer)
+  {
+    const size_t home = table[next].key & mask;
+
+    if(((next - home) & mask) >= ((next - slot) & mask))
+    {
+      table[slot] = table[next];
+      slot = next;
+    }
+
+    next = (next + 1) & mask;
+  }
+
+  memset(&table[slot], 0, sizeof(table[slot]));
+}
+
+static void
+fboCacheInsert(Device::FramebufferCacheEntry *table,
+               const size_t capacity,
+               const Device::FramebufferCacheEntry &entry)
+{
+  const size_t mask = capacity - 1;
+  size_t slot = entry.key & mask;
+
+  while(table[slot].framebuffer)
+  {
+    slot = (slot + 1) & mask;
+  }
+
+  table[slot] = entry;
+}
+
+static void
+fboForget(Device &dev, const GLuint fbo)
+{
+  const bool draw = dev.bound_draw_framebuffer == fbo;
+  const bool read = dev.bound_read_framebuffer == fbo;
+
+  if(!draw && !read)
+  {
+    return;
+  }
+
+  // GL falls back to zero, which isn't the default one when an FBO stands
+  // in for it.
+  if(dev.default_framebuffer)
+  {
+    glBindFramebuffer(draw && read ? GL_FRAMEBUFFER :
+                      draw ? GL_DRAW_FRAMEBUFFER : GL_READ_FRAMEBUFFER,
+                      dev.default_framebuffer);
+    dev.stats.bind_framebuffers += 1;
+  }
+
+  dev.bound_draw_framebuffer = draw ? dev.default_framebuffer : dev.bound_draw_framebuffer;
+  dev.bound_read_framebuffer = read ? dev.default_framebuffer : dev.bound_read_framebuffer;
+}
+
+static void
+fboCacheEvictAttachment(Device &dev, const uintptr_t object, const bool renderbuffer)
+{
+  size_t i = 0;
+
+  while(i < dev.fbo_cache_capacity)
+  {
+    Device::FramebufferCacheEntry &entry = dev.fbo_cache[i];
+    bool uses = false;
+
+    for(size_t a = 0; entry.framebuffer && a <= THIN_MAX_COLOR_ATTACHMENTS; ++a)
+    {
+      const FramebufferAttachment &att = a < THIN_MAX_COLOR_ATTACHMENTS ? entry.desc.color[a] : entry.desc.depth;
+      uses |= att.object == object && (att.type == AttachmentType::renderbuffer) == renderbuffer;
+    }
+
+    if(uses)
+    {
+      const GLuint fbo = (GLuint)entry.framebuffer;
+      glDeleteFramebuffers(1, &fbo);
+      dev.stats.objects_deleted += 1;
+      fboForget(dev, fbo);
+
+      // Erasing can shift another entry into this slot so check it again.
+      fboCacheErase(dev.fbo_cache, dev.fbo_cache_capacity, i);
+      --dev.fbo_cache_count;
+      continue;
+    }
+
+    ++i;
+  }
+}
+
+static void
+fboAttach(const GLenum point, const FramebufferAttachment &att)
+{
+  switch(att.type)
+  {
+    case AttachmentType::texture:
+      glFramebufferTexture(GL_FRAMEBUFFER, point, (GLuint)att.object, att.level);
+      break;
+
+    case AttachmentType::texture_layer:
+      glFramebufferTextureLayer(GL_FRAMEBUFFER, point, (GLuint)att.object, att.level, att.layer);
+      break;
+
+    case AttachmentType::renderbuffer:
+      glFramebufferRenderbuffer(GL_FRAMEBUFFER, point, GL_RENDERBUFFER, (GLuint)att.object);
+      break;
+  }
+}
+
+static const char *
+fboStatusMessage(const GLenum status)
+{
+  switch(status)
+  {
+    case GL_FRAMEBUFFER_INCOMPLETE_ATTACHMENT:         return "Framebuffer incomplete, bad attachment";
+    case GL_FRAMEBUFFER_INCOMPLETE_MISSING_ATTACHMENT: return "Framebuffer incomplete, no attachments";
+    case GL_FRAMEBUFFER_INCOMPLETE_MULTISAMPLE:        return "Framebuffer incomplete, mixed sample counts";
+    case GL_FRAMEBUFFER_INCOMPLETE_LAYER_TARGETS:      return "Framebuffer incomplete, mixed layered attachments";
+    case GL_FRAMEBUFFER_UNSUPPORTED:                   return "Framebuffer unsupported format combination";
+    default:                                           return "Framebuffer incomplete";
+  }
+}
+
+
+// ----------------------------------------------------------[ Memory Utils ]--
+
+static inline uint64_t
+memoryKey(const MemoryType type, const uintptr_t name)
+{
+  // Type above the name, never zero so empty slots stay zero.
+  return ((uint64_t)type + 1) << 32 | (uint32_t)name;
+}
+
+static size_t
+memorySlot(const Device &dev, const uint64_t key)
+{
+  const size_t mask = dev.memory_table_capacity - 1;
+  size_t slot = thinHashCombine(thin_hash_seed, key) & mask;
+
+  while(dev.memory_table[slot].key && dev.memory_table[slot].key != key)
+  {
+    slot = (slot + 1) & mask;
+  }
+
+  return slot;
+}
+
+static void
+memoryUsageAdd(MemoryUsage &usage, const size_t bytes, const size_t count)
+{
+  usage.bytes += bytes;
+  usage.count += count;
+  usage.peak_bytes = usage.bytes > usage.peak_bytes ? usage.bytes : usage.peak_bytes;
+}
+
+static void
+memoryUsageSub(MemoryUsage &usage, const size_t bytes, const size_t count)
+{
+  usage.bytes -= bytes;
+  usage.count -= count;
+}
+
+/*
+  Moves an object from old_bytes to new_bytes in every usage it counts
+  towards, count is +1 for a new object and -1 for a gone one.
+*/
+static void
+memoryAccount(Device &dev, const MemoryType type, const uint32_t tag,
+              const size_t old_bytes, const size_t new_bytes, const int count)
+{
+  MemoryUsage *usages[] = {
+    &dev.memory_total, &dev.memory_by_type[(size_t)type], &dev.memory_by_tag[tag],
+  };
+
+  for(MemoryUsage *usage : usages)
+  {
+    memoryUsageSub(*usage, old_bytes, count < 0 ? 1 : 0);
+    memoryUsageAdd(*usage, new_bytes, count > 0 ? 1 : 0);
+  }
+}
+
+/*
+  Sets what an object holds. An object already tracked keeps the tag it was
+  created under.
+*/
+static void
+memoryTrack(Device &dev, const MemoryType type, const uintptr_t name, const size_t bytes)
+{
+  if((dev.memory_table_count + 1) * 2 > dev.memory_table_capacity)
+  {
+    Device::MemoryEntry *old_table = dev.memory_table;
+    const size_t old_capacity = dev.memory_table_capacity;
+
+    dev.memory_table_capacity = old_capacity ? old_capacity * 2 : 64;
+    dev.memory_table = (Device::MemoryEntry*)calloc(dev.memory_table_capacity,
+                                                    sizeof(Device::MemoryEntry));
+
+    for(size_t i = 0; i < old_capacity; ++i)
+    {
+      if(old_table[i].key)
+      {
+        dev.memory_table[memorySlot(dev, old_table[i].key)] = old_table[i];
+      }
+    }
+
+    free(old_table);
+  }
+
+  const uint64_t key = memoryKey(type, name);
+  Device::MemoryEntry &entry = dev.memory_table[memorySlot(dev, key)];
+
+  if(entry.key)
+  {
+    memoryAccount(dev, type, entry.tag, entry.bytes, bytes, 0);
+  }
+  else
+  {
+    dev.memory_table_count += 1;
+    entry.key = key;
+    entry.tag = dev.memory_tag;
+    memoryAccount(dev, type, entry.tag, 0, bytes, 1);
+  }
+
+  entry.bytes = bytes;
+}
+
+static size_t
+memoryUntrack(Device &dev, const MemoryType type, const uintptr_t name)
+{
+  if(!dev.memory_table_count)
+  {
+    return 0;
+  }
+
+  const size_t mask = dev.memory_table_capacity - 1;
+  size_t slot = memorySlot(dev, memoryKey(type, name));
+
+  if(!dev.memory_table[slot].key)
+  {
+    return 0;
+  }
+
+  const size_t bytes = dev.memory_table[slot].bytes;
+  memoryAccount(dev, type, dev.memory_table[slot].tag, bytes, 0, -1);
+
+  // Backward shift so later probes still find their entries.
+  for(size_t next = (slot + 1) & mask; dev.memory_table[next].key; next = (next + 1) & mask)
+  {
+    const size_t home = thinHashCombine(thin_hash_seed, dev.memory_table[next].key) & mask;
+
+    if(((next - home) & mask) >= ((next - slot) & mask))
+    {
+      dev.memory_table[slot] = dev.memory_table[next];
+      slot = next;
+    }
+  }
+
+  dev.memory_table[slot].key = 0;
+  dev.memory_table_count -= 1;
+
+  return bytes;
+}
+
+/*
+  Slot of a tag, zero for null or one never set.
+*/
+static uint32_t
+memoryTagFind(const Device &dev, const char *tag)
+{
+  for(uint32_t i = 1; tag && i < dev.memory_tag_count; ++i)
+  {
+    if(dev.memory_tags[i] == tag || !strcmp(dev.memory_tags[i], tag))
+    {
+      return i;
+    }
+  }
+
+  return 0;
+}
+
+static GLenum
+bufferBindingQuery(const GLenum target)
+{
+  switch(target)
+  {
+    case GL_ARRAY_BUFFER:         return GL_ARRAY_BUFFER_BINDING;
+    case GL_ELEMENT_ARRAY_BUFFER: return GL_ELEMENT_ARRAY_BUFFER_BINDING;
+    case GL_UNIFORM_BUFFER:       return GL_UNIFORM_BUFFER_BINDING;
+    case GL_PIXEL_PACK_BUFFER:    return GL_PIXEL_PACK_BUFFER_BINDING;
+    case GL_PIXEL_UNPACK_BUFFER:  return GL_PIXEL_UNPACK_BUFFER_BINDING;
+    case GL_COPY_READ_BUFFER:     return GL_COPY_READ_BUFFER;
+    case GL_COPY_WRITE_BUFFER:    return GL_COPY_WRITE_BUFFER;
+    case GL_TEXTURE_BUFFER:       return GL_TEXTURE_BUFFER;
+    case GL_TRANSFORM_FEEDBACK_BUFFER: return GL_TRANSFORM_FEEDBACK_BUFFER_BINDING;
+    case GL_DRAW_INDIRECT_BUFFER: return GL_DRAW_INDIRECT_BUFFER_BINDING;
+    default:                      return 0;
+  }
+}
+
+
+// ------------------------------------------------------------[ Bind Cache ]--
+
+static inline size_t
+bindBufferTarget(const GLenum target)
+{
+  // Index buffer must stay at Device::thin_bind_index_buffer.
+  switch(target)
+  {
+    case GL_ARRAY_BUFFER:         return 0;
+    case GL_ELEMENT_ARRAY_BUFFER: return 1;
+    case GL_UNIFORM_BUFFER:       return 2;
+    case GL_PIXEL_PACK_BUFFER:    return 3;
+    case GL_PIXEL_UNPACK_BUFFER:  return 4;
+    case GL_COPY_READ_BUFFER:     return 5;
+    case GL_COPY_WRITE_BUFFER:    return 6;
+    case GL_TEXTURE_BUFFER:       return 7;
+    default:                      return Device::thin_bind_buffer_targets;
+  }
+}
+
+static inline size_t
+bindTextureTarget(const GLenum target)
+{
+  switch(target)
+  {
+    case GL_TEXTURE_2D:           return 0;
+    case GL_TEXTURE_CUBE_MAP:     return 1;
+    case GL_TEXTURE_3D:           return 2;
+    case GL_TEXTURE_2D_ARRAY:     return 3;
+    default:                      return Device::thin_bind_texture_targets;
+  }
+}
+
+
+// ---------------------------------------------------------------[ General ]--
+
+void
+Device::initialize(const GLLoading loading, GLADloadproc get_proc)
+{
+  #ifdef THIN_NULL_BACKEND
+  // No driver, loading and get_proc are ignored.
+  (void)loading;
+  (void)get_proc;
+  const bool set_ext_flags = true;
+  glLoadNull();
+  #else
+  const bool set_ext_flags = loading == GLLoading::lazy;
+
+  if(loading == GLLoading::lazy)
+  {
+    gl_lazy_device = this;
+    glLoadLazy(get_proc ? get_proc : glDefaultGetProc);
+  }
+  else if(get_proc)
+  {
+    gladLoadGLLoader(get_proc);
+  }
+  else
+  {
+    gladLoadGL();
+  }
+  #endif
+
+  buildCapabilities();
+  invalidateBindings();
+
+  #ifndef THIN_NULL_BACKEND
+  glLoadExtra(*this, loading == GLLoading::lazy ? gl_lazy_get_proc :
+                     get_proc ? get_proc : glDefaultGetProc);
+  #endif
+
+  if(set_ext_flags)
+  {
+    // glad sets these in find_extensionsGL.
+    GLAD_GL_AMD_debug_output = hasCapability(GLCap::AMD_debug_output);
+    GLAD_GL_ARB_debug_output = hasCapability(GLCap::ARB_debug_output);
+    GLAD_GL_EXT_debug_label = hasCapability(GLCap::EXT_debug_label);
+    GLAD_GL_EXT_debug_marker = hasCapability(GLCap::EXT_debug_marker);
+    GLAD_GL_EXT_texture_filter_anisotropic = hasCapability(GLCap::EXT_texture_filter_anisotropic);
+    GLAD_GL_KHR_debug = hasCapability(GLCap::KHR_debug);
+    GLAD_GL_NV_bindless_texture = hasCapability(GLCap::NV_bindless_texture);
+    GLAD_GL_NV_command_list = hasCapability(GLCap::NV_command_list);
+  }
+
+  #ifndef THIN_NULL_BACKEND
+  if(loading == GLLoading::lazy)
+  {
+    glLoadLazyGates();
+  }
+  #endif
+
+  // stderr, tools write their results to stdout.
+  fprintf(stderr, "OpenGL Version %d.%d loaded\n", GLVersion.major, GLVersion.minor);
+}
+
+void
+Device::errorCallback(const error_callback_fn err_cb)
+{
+  curr_error_callback = err_cb;
+}
+
+void
+Device::getError(const char *msg)
+{
+  const GLenum err = glGetError();
+
+  if(err && curr_error_callback)
+  {
+    // TODO: Prefix with error code.
+    curr_error_callback(msg);
+  }
+}
+
+// ------------------------------------------------------------[ Capability ]--
+
+static inline uint64_t
+extensionSetKey(const uint64_t name_hash)
+{
+  // Zero marks an empty slot.
+  return name_hash ? name_hash : 1;
+}
+
+static void
+extensionSetInsert(uint64_t *set, const size_t capacity, const uint64_t name_hash)
+{
+  const uint64_t key = extensionSetKey(name_hash);
+  const size_t mask = capacity - 1;
+  size_t slot = key & mask;
+
+  while(set[slot] && set[slot] != key)
+  {
+    slot = (slot + 1) & mask;
+  }
+
+  set[slot] = key;
+}
+
+void
+Device::buildCapabilities()
+{
+  // One pass over the driver's list, every query after is a probe or a bit
+  // test rather than a string search.
+  GLint count = 0;
+  const char *legacy = nullptr;
+
+  if(GLVersion.major >= 3)
+  {
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+  }
+  else
+  {
+    legacy = (const char*)glGetString(GL_EXTENSIONS);
+
+    for(const char *c = legacy; c && *c; ++c)
+    {
+      count += *c == ' ';
+    }
+
+    count += 1;
+  }
+
+  size_t capacity = 16;
+  while(capacity < (size_t)count * 2)
+  {
+    capacity *= 2;
+  }
+
+  free(extension_set);
+  extension_set = (uint64_t*)calloc(capacity, sizeof(uint64_t));
+  extension_set_capacity = capacity;
+
+  if(legacy)
+  {
+    uint64_t hash = thin_hash_seed;
+
+    for(const char *c = legacy; ; ++c)
+    {
+      if(*c == ' ' || *c == '\0')
+      {
+        if(hash != thin_hash_seed)
+        {
+          extensionSetInsert(extension_set, capacity, hash);
+        }
+
+        hash = thin_hash_seed;
+
+        if(*c == '\0')
+        {
+          break;
+        }
+
+        continue;
+      }
+
+      hash = thinHashCombine(hash, (uint8_t)*c);
+    }
+  }
+
+  for(GLint i = 0; i < count && !legacy; ++i)
+  {
+    const char *name = (const char*)glGetStringi(GL_EXTENSIONS, i);
+    extensionSetInsert(extension_set, capacity, thinHashString(name));
+  }
+
+  #ifdef THIN_EXTRA_ERROR_CHECKS
+  getError("Build Capabilities");
+  #endif
+
+  static constexpr uint64_t cap_hashes[] = {
+    #define THIN_GL_CAP_HASH(name) thinHashString("GL_" #name),
+    THIN_GL_CAPABILITIES(THIN_GL_CAP_HASH)
+    #undef THIN_GL_CAP_HASH
+  };
+
+  static_assert((size_t)GLCap::count <= 64, "Capabilities must fit the bitset");
+
+  capabilities = 0;
+
+  for(size_t i = 0; i < (size_t)GLCap::count; ++i)
+  {
+    if(hasExtension(cap_hashes[i]))
+    {
+      capabilities |= 1ull << i;
+    }
+  }
+}
+
+bool
+Device::hasCapability(const GLCap cap) const
+{
+  return (capabilities >> (uint64_t)cap) & 1;
+}
+
+bool
+Device::hasExtension(const uint64_t name_hash) const
+{
+  if(!extension_set_capacity)
+  {
+    return false;
+  }
+
+  const uint64_t key = extensionSetKey(name_hash);
+  const size_t mask = extension_set_capacity - 1;
+  size_t slot = key & mask;
+
+  while(extension_set[slot])
+  {
+    if(extension_set[slot] == key)
+    {
+      return true;
+    }
+
+    slot = (slot + 1) & mask;
+  }
+
+  return false;
+}
+
+bool
+Device::hasExtension(const char *name) const
+{
+  return hasExtension(thinHashString(name));
+}
+
+
+// -----------------------------------------------------------------[ Stats ]--
+
+void
+Device::beginFrame()
+{
+  frame_start_stats = stats;
+}
+
+void
+Device::endFrame()
+{
+  stats_history[frame_count % THIN_STATS_HISTORY] = deviceStatsDelta(stats, frame_start_stats);
+  frame_count += 1;
+
+  // Back to back frames without a beginFrame still get their own numbers.
+  frame_start_stats = stats;
+}
+
+bool
+Device::getFrameStats(const size_t frames_ago, DeviceStats *out_stats) const
+{
+  if(frames_ago >= THIN_STATS_HISTORY || frames_ago >= frame_count)
+  {
+    return false;
+  }
+
+  *out_stats = stats_history[(frame_count - 1 - frames_ago) % THIN_STATS_HISTORY];
+
+  return true;
+}
+
+void
+Device::invalidateBindings()
+{
+  bound_program = thin_unknown_binding;
+  bound_vertex_array = thin_unknown_binding;
+  active_texture = thin_unknown_binding;
+
+  memset(bound_buffers, 0xff, sizeof(bound_buffers));
+  memset(bound_textures, 0xff, sizeof(bound_textures));
+  memset(bound_samplers, 0xff, sizeof(bound_samplers));
+
+  bound_draw_framebuffer = thin_unknown_binding;
+  bound_read_framebuffer = thin_unknown_binding;
+}
+
+
+// ----------------------------------------------------------------[ Memory ]--
+
+void
+Device::setMemoryTag(const char *tag)
+{
+  memory_tag = memoryTagFind(*this, tag);
+
+  if(memory_tag || !tag)
+  {
+    return;
+  }
+
+  if(memory_tag_count == THIN_MAX_MEMORY_TAGS)
+  {
+    if(curr_error_callback)
+    {
+      curr_error_callback("Out of memory tags, raise THIN_MAX_MEMORY_TAGS");
+    }
+
+    return;
+  }
+
+  memory_tag = memory_tag_count++;
+  memory_tags[memory_tag] = tag;
+}
+
+MemoryUsage
+Device::getMemoryUsage() const
+{
+  return memory_total;
+}
+
+MemoryUsage
+Device::getMemoryUsage(const MemoryType type) const
+{
+  return type < MemoryType::count ? memory_by_type[(size_t)type] : MemoryUsage{};
+}
+
+MemoryUsage
+Device::getMemoryUsage(const char *tag) const
+{
+  const uint32_t slot = memoryTagFind(*this, tag);
+
+  return slot || !tag ? memory_by_tag[slot] : MemoryUsage{};
+}
+
+size_t
+Device::getTopAllocations(MemoryAllocation out_allocations[], const size_t max_count) const
+{
+  size_t count = 0;
+
+  // Insertion into a sorted window, max_count is meant to be small.
+  for(size_t i = 0; max_count && i < memory_table_capacity; ++i)
+  {
+    const MemoryEntry &entry = memory_table[i];
+
+    if(!entry.key || (count == max_count && entry.bytes <= out_allocations[count - 1].bytes))
+    {
+      continue;
+    }
+
+    size_t at = count < max_count ? count++ : count - 1;
+
+    for(; at && out_allocations[at - 1].bytes < entry.bytes; --at)
+    {
+      out_allocations[at] = out_allocations[at - 1];
+    }
+
+    out_allocations[at].type = (MemoryType)((entry.key >> 32) - 1);
+    out_allocations[at].name = (uintptr_t)(uint32_t)entry.key;
+    out_allocations[at].bytes = entry.bytes;
+    out_allocations[at].tag = memory_tags[entry.tag];
+  }
+
+  return count;
+}
+
+void
+Device::resetMemoryPeaks()
+{
+  memory_total.peak_bytes = memory_total.bytes;
+
+  for(MemoryUsage &usage : memory_by_type)
+  {
+    usage.peak_bytes = usage.bytes;
+  }
+
+  for(MemoryUsage &usage : memory_by_tag)
+  {
+    usage.peak_bytes = usage.bytes;
+  }
+}
+
+
+// ------------------------------------------------------------------[ Misc ]--
+
+void
+Device::enable(const GLenum cap)
+{
+  glEnable(cap);
+
+  #ifdef THIN_EXTRA_ERROR_CHECKS
+  getError("glEnable");
+  #endif
+}
+
+void
+Device::enable(const size_t count, const GLenum to_enable[])
+{
+  for(size_t i = 0; i < count; ++i)
+  {
+    enable(to_enable[i]);
+  }
+}
+
+void
+Device::disable(const GLenum cap)
+{
+  glDisable(cap);
+
+  #ifdef THIN_EXTRA_ERROR_CHECKS
+  getError("glDisable");
+  #endif
+}
+
+void
+Device::disable(const size_t count, const GLenum to_disable[])
+{
+  for(size_t i = 0; i < count; ++i)
+  {
+    disable(to_disable[i]);
+  }
+}
+
+
+// -------------------------------------------------------------------[ VAO ]--
+
+uintptr_t
+Device::genVertexArray()
+{
+  uintptr_t vao = 0;
+  genVertexArrays(1, &vao);
+
+  return vao;
+}
+
+void
+Device::genVertexArrays(const size_t count, uintptr_t out_vaos[])
+{
+  GLuint *vaos = (GLuint*)malloc(count * sizeof(GLuint));
+
+  glGenVertexArrays(count, vaos);
+  stats.objects_created += count;
+
+  // Convert back to uintptrs
+  for(size_t i = 0; i < count; ++i)
+  {
+    out_vaos[i] = (uintptr_t)vaos[i];
+  }
+
+  #ifdef THIN_EXTRA_ERROR_CHECKS
+  getError("glGenVertexArrays");
+  #endif
+
+  free(vaos);
+}
+
+uintptr_t
+Device::createVertexArray()
+{
+  // TODO: Need to check to see if glCreateVertexArrays exists.
+  return genVertexArray();
+}
+
+void
+Device::createVertexArrays(const size_t count, uintptr_t vaos[])
+{
+  // TODO: Need to check to see if glCreateVertexArrays exists.
+  genVertexArrays(count, vaos);
+}
+
+void
+Device::bindVertexArray(const uintptr_t vao)
+{
+  if(bound_vertex_array == (GLuint)vao)
+  {
+    stats.redundant_binds += 1;
+    return;
+  }
+
+  glBindVertexArray(vao);
+  stats.bind_vertex_arrays += 1;
+
+  // The index buffer binding belongs to the VAO.
+  bound_vertex_array = (GLuint)vao;
+  bound_buffers[thin_bind_index_buffer] = thin_unknown_binding;
+
+  #ifdef THIN_EXTRA_ERROR_CHECKS
+  getError("glBindVertexArray");
+  #endif
+}
+
+void
+Device::deleteVertexArray(const uintptr_t vao)
+{
+  deleteVertexArrays(1, &vao);
+}
+
+void
+Device::deleteVertexArrays(const size_t count,
+                           const uintptr_t vaos_to_destroy[])
+{
+  GLuint *vaos = (GLuint*)malloc(count * sizeof(GLuint));
+
+  // Convert to GLuint
+  for(size_t i = 0; i < count; ++i)
+  {
+    vaos[i] = (GLuint)vaos_to_destroy[i];
+  }
+
+  for(size_t i = 0; vao_cache_count && i < count; ++i)
+  {
+    vaoCacheEvictVertexArray(*this, vaos_to_destroy[i]);
+  }
+
+  glDeleteVertexArrays(count, vaos);
+  stats.objects_deleted += count;
+
+  for(size_t i = 0; i < count; ++i)
+  {
+    if(vaos[i] == bound_vertex_array)
+    {
+      bound_vertex_array = 0;
+      bound_buffers[thin_bind_index_buffer] = thin_unknown_binding;
+    }
+  }
+
+  #ifdef THIN_EXTRA_ERROR_CHECKS
+  getError("glDeleteVertexArrays");
+  #endif
+
+  free(vaos);
+}
+
+
+// -----------------------------------------------------------------[ Clear ]--
+
+void
+Device::clearColor(const float r, const float g, const float b, const float a)
+{
+  glClearColor(r,g,b,a);
+
+  #ifdef THIN_EXTRA_PEDANTIC_ERROR_CHECKS
+  getError("glClearColor");
+  #endif
+}
+
+void
+Device::clearColor(const float color[4])
+{
+  enum {r = 0,g,b,a};
+
+  clearColor(color[r], color[g], color[b], color[a]);
+}
+
+void
+Device::clear(const GLbitfield mask)
+{
+  glClear(mask);
+
+  #ifdef THIN_EXTRA_PEDANTIC_ERROR_CHECKS
+  getError("glClear");
+  #endif
+}
+
+void
+Device::clear(const bool color, const bool depth, const bool stencil)
+{
+  GLbitfield mask = 0;
+  if(color)   { mask |= GL_COLOR_BUFFER_BIT;   }
+  if(depth)   { mask |= GL_DEPTH_BUFFER_BIT;   }
+  if(stencil) { mask |= GL_STENCIL_BUFFER_BIT; }
+
+  clear(mask);
+}
+
+void
+Device::clearColorBuffer()
+{
+  clear(GL_COLOR_BUFFER_BIT);
+}
+
+void
+Device::clearDepthBuffer()
+{
+  clear(GL_DEPTH_BUFFER_BIT);
+}
+
+void
+Device::clearStencilBuffer()
+{
+  clear(GL_STENCIL_BUFFER_BIT);
+}
+
+void
+Device::getClearColor(float out_color[4])
+{
+}
+
+
+// ---------------------------------------------------------------[ Texture ]--
+
+uintptr_t
+Device::genTexture()
+{
+  uintptr_t tex;
+  genTextures(1, &tex);
+
+  return tex;
+}
+
+void
+Device::genTextures(const size_t count, uintptr_t out_textures[])
+{
+  GLuint *textures = (GLuint*)malloc(sizeof(GLuint) * count);
+  glGenTextures(count, textures);
+  stats.objects_created += count;
+
+  #ifdef THIN_EXTRA_ERROR_CHECKS
+  getError("glGenTextures");
+  #endif
+
+  for(size_t i = 0; i < count; ++i)
+  {
+    out_textures[i] = (uintptr_t)textures[i];
+  }
+
+  free(textures);
+}
+
+uintptr_t
+Device::createTexture()
+{
+  return genTexture();
+}
+
+void
+Device::createTextures(const size_t count, uintptr_t textures[])
+{
+  return genTextures(count, textures);
+}
+
+void
+Device::bindTexture(const GLenum target, const uintptr_t texture)
+{
+  const GLuint unit = active_texture - GL_TEXTURE0;
+  const size_t slot = bindTextureTarget(target);
+  const bool cached = unit < THIN_MAX_TEXTURE_UNITS &&
+                      slot < thin_bind_texture_targets;
+
+  if(cached && bound_textures[unit][slot] == (GLuint)texture)
+  {
+    stats.redundant_binds += 1;
+    return;
+  }
+
+  glBindTexture(target, (GLuint)texture);
+  stats.bind_textures += 1;
+
+  if(cached)
+  {
+    bound_textures[unit][slot] = (GLuint)texture;
+  }
+
+  #ifdef THIN_EXTRA_ERROR_CHECKS
+  getError("glBindTexture");
+  #endif
+}
+
+void
+Device::bindActiveTexture(const GLuint texture_slot,
+                          const GLenum target,
+                          const uintptr_t texture)
+{
+  const GLuint unit = texture_slot - GL_TEXTURE0;
+  const size_t slot = bindTextureTarget(target);
+  const bool cached = unit < THIN_MAX_TEXTURE_UNITS &&
+                      slot < thin_bind_texture_targets;
+
+  // Callers expect the unit active afterwards even when the bind is
+  // redundant, texture calls that follow go to it.
+  if(active_texture != texture_slot)
+  {
+    glActiveTexture(texture_slot);
+    active_texture = texture_slot;
+  }
+
+  if(cached && bound_textures[unit][slot] == (GLuint)texture)
+  {
+    stats.redundant_binds += 1;
+    return;
+  }
+
+  glBindTexture(target, (GLuint)texture);
+  stats.bind_textures += 1;
+
+  if(cached)
+  {
+    bound_textures[unit][slot] = (GLuint)texture;
+  }
+
+  #ifdef THIN_EXTRA_ERROR_CHECKS
+  getError("glBindTexture");
+  #endif
+}
+
+void
+Device::bindTextures(const GLuint first_unit,
+                     const size_t count,
+                     const uintptr_t in_textures[],
+                     const GLenum targets[])
+{
+  if(!gl_bind_textures)
+  {
+    for(size_t i = 0; i < count; ++i)
+    {
+      bindActiveTexture(GL_TEXTURE0 + first_unit + (GLuint)i,
+                        targets ? targets[i] : GL_TEXTURE_2D,
+                        in_textures[i]);
+    }
+
+    return;
+  }
+
+  // Batches keep the names on the stack.
+  constexpr size_t batch_size = 32;
+  GLuint textures[batch_size];
+
+  for(size_t batch = 0; batch < count; batch += batch_size)
+  {
+    const size_t batch_count = count - batch < batch_size ? count - batch : batch_size;
+
+    // Narrow the call to the units that change.
+    size_t lo = batch_count;
+    size_t hi = 0;
+
+    for(size_t i = 0; i < batch_count; ++i)
+    {
+      const size_t unit = first_unit + batch + i;
+      const GLuint texture = (GLuint)in_textures[batch + i];
+      const size_t slot = bindTextureTarget(targets ? targets[batch + i] : GL_TEXTURE_2D);
+
+      bool changed = unit >= THIN_MAX_TEXTURE_UNITS || slot >= thin_bind_texture_targets;
+
+      // Zero clears every target of the unit.
+      for(size_t t = 0; !changed && t < thin_bind_texture_targets; ++t)
+      {
+        changed = texture ? t == slot && bound_textures[unit][t] != texture :
+                            bound_textures[unit][t] != 0;
+      }
+
+      if(changed)
+      {
+        lo = i < lo ? i : lo;
+        hi = i + 1;
+      }
+
+      textures[i] = texture;
+    }
+
+    if(lo == batch_count)
+    {
+      stats.redundant_binds += batch_count;
+      continue;
+    }
+
+    gl_bind_textures(first_unit + (GLuint)(batch + lo), (GLsizei)(hi - lo), textures + lo);
+    stats.bind_textures += 1;
+    stats.redundant_binds += batch_count - (hi - lo);
+
+    for(size_t i = lo; i < hi; ++i)
+    {
+      const size_t unit = first_unit + batch + i;
+      const size_t slot = bindTextureTarget(targets ? targets[batch + i] : GL_TEXTURE_2D);
+
+      if(unit >= THIN_MAX_TEXTURE_UNITS)
+      {
+        continue;
+      }
+
+      if(!textures[i])
+      {
+        memset(bound_textures[unit], 0, sizeof(bound_textures[unit]));
+      }
+      else if(slot < thin_bind_texture_targets)
+      {
+        bound_textures[unit][slot] = textures[i];
+      }
+    }
+  }
+
+  #ifdef THIN_EXTRA_ERROR_CHECKS
+  getError("Bind Textures");
+  #endif
+}
+
+void
+Device::deleteTexture(const uintptr_t texture)
+{
+  deleteTextures(1, &texture);
+}
+
+void
+Device::deleteTextures(const size_t count, const uintptr_t in_textures[])
+{
+  GLuint *textures = (GLuint*)malloc(sizeof(GLuint) * count);
+
+  for(size_t i = 0; i < count; ++i)
+  {
+    textures[i] = (GLuint)in_textures[i];
+  }
+
+  for(size_t i = 0; fbo_cache_count && i < count; ++i)
+  {
+    fboCacheEvictAttachment(*this, in_textures[i], false);
+  }
+
+  glDeleteTextures(count, textures);
+  stats.objects_deleted += count;
+
+  // Deleted textures unbind from every unit, cheaper to forget them all
+  // than to search.
+  memset(bound_textures, 0xff, sizeof(bound_textures));
+
+  for(size_t i = 0; memory_table_count && i < count; ++i)
+  {
+    memoryUntrack(*this, MemoryType::texture, in_textures[i]);
+  }
+
+  free(textures);
+
+  #ifdef THIN_EXTRA_ERROR_CHECKS
+  getError("glDeleteTextures");
+  #endif
+}
+
+uintptr_t
+Device::createTexture2D(const TextureDesc &desc)
+{
+  TextureFormatInfo info;
+
+  if(!textureFormatInfo(desc.internal_format, &info))
+  {
+    if(curr_error_callback)
+    {
+      curr_error_callback("Texture desc needs a sized internal format");
+    }
+
+    return 0;
+  }
+
+  #ifdef THIN_EXTRA_PARAM_CHECKS
+  if(desc.width <= 0 || desc.height <= 0 || desc.layers < 0)
+  {
+    if(curr_error_callback)
+    {
+      curr_error_callback("Texture desc has no size");
+    }
+
+    return 0;
+  }
+  #endif
+
+  const bool is_array = desc.layers > 1 || desc.array;
+  const GLenum target = is_array ? GL_TEXTURE_2D_ARRAY : GL_TEXTURE_2D;
+  const GLsizei layers = is_array && desc.layers > 1 ? desc.layers : 1;
+  const GLsizei full_mips = textureFullMipCount(desc.width, desc.height);
+  const GLsizei mips = desc.mip_count > 0 && desc.mip_count < full_mips ?
+    desc.mip_count :
+    full_mips;
+
+  const GLenum data_format = desc.data_format ? desc.data_format : info.format;
+  const GLenum data_type = desc.data_type ? desc.data_type : info.type;
+
+  const uintptr_t texture = genTexture();
+  bindTexture(target, texture);
+
+  const bool immutable = is_array ? gl_tex_storage_3d != nullptr :
+                                    gl_tex_storage_2d != nullptr;
+
+  if(immutable && is_array)
+  {
+    gl_tex_storage_3d(target, mips, desc.internal_format, desc.width, desc.height, layers);
+  }
+  else if(immutable)
+  {
+    gl_tex_storage_2d(target, mips, desc.internal_format, desc.width, desc.height);
+  }
+
+  // Level 0, with data when there is some.
+  if(immutable && desc.data && is_array)
+  {
+    glTexSubImage3D(target, 0, 0, 0, 0, desc.width, desc.height, layers,
+                    data_format, data_type, desc.data);
+  }
+  else if(immutable && desc.data)
+  {
+    glTexSubImage2D(target, 0, 0, 0, desc.width, desc.height,
+                    data_format, data_type, desc.data);
+  }
+  else if(!immutable && is_array)
+  {
+    glTexImage3D(target, 0, desc.internal_format, desc.width, desc.height, layers, 0,
+                 data_format, data_type, desc.data);
+  }
+  else if(!immutable)
+  {
+    glTexImage2D(target, 0, desc.internal_format, desc.width, desc.height, 0,
+                 data_format, data_type, desc.data);
+  }
+
+  const bool generate = desc.generate_mips && desc.data && mips > 1;
+
+  // Mutable textures need every level allocated, glGenerateMipmap does that
+  // itself.
+  for(GLsizei level = 1; !immutable && !generate && level < mips; ++level)
+  {
+    const GLsizei w = desc.width >> level ? desc.width >> level : 1;
+    const GLsizei h = desc.height >> level ? desc.height >> level : 1;
+
+    if(is_array)
+    {
+      glTexImage3D(target, level, desc.internal_format, w, h, layers, 0,
+                   data_format, data_type, nullptr);
+    }
+    else
+    {
+      glTexImage2D(target, level, desc.internal_format, w, h, 0,
+                   data_format, data_type, nullptr);
+    }
+  }
+
+  if(!immutable && mips < full_mips)
+  {
+    glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, mips - 1);
+  }
+
+  if(generate)
+  {
+    glGenerateMipmap(target);
+  }
+
+  // Only what differs from the GL defaults.
+  const GLenum min_filter = desc.min_filter ? desc.min_filter :
+                            mips > 1 ? GL_NEAREST_MIPMAP_LINEAR : GL_LINEAR;
+
+  if(min_filter != GL_NEAREST_MIPMAP_LINEAR)
+  {
+    glTexParameteri(target, GL_TEXTURE_MIN_FILTER, min_filter);
+  }
+
+  if(desc.mag_filter && desc.mag_filter != GL_LINEAR)
+  {
+    glTexParameteri(target, GL_TEXTURE_MAG_FILTER, desc.mag_filter);
+  }
+
+  if(desc.wrap_s && desc.wrap_s != GL_REPEAT)
+  {
+    glTexParameteri(target, GL_TEXTURE_WRAP_S, desc.wrap_s);
+  }
+
+  if(desc.wrap_t && desc.wrap_t != GL_REPEAT)
+  {
+    glTexParameteri(target, GL_TEXTURE_WRAP_T, desc.wrap_t);
+  }
+
+  #ifdef THIN_EXTRA_ERROR_CHECKS
+  getError("Create Texture 2D");
+  #endif
+
+  size_t bytes = 0;
+
+  for(GLsizei level = 0; level < mips; ++level)
+  {
+    const size_t w = desc.width >> level ? desc.width >> level : 1;
+    const size_t h = desc.height >> level ? desc.height >> level : 1;
+
+    bytes += w * h * info.bytes * layers;
+  }
+
+  memoryTrack(*this, MemoryType::texture, texture, bytes);
+
+  if(desc.data)
+  {
+    stats.bytes_uploaded += pixelDataSize(desc.width, desc.height, data_format, data_type) * layers;
+  }
+
+  return texture;
+}
+
+uintptr_t
+Device::createCompressedTexture2D(const GLenum internal_format,
+                                  const GLsizei width,
+                                  const GLsizei height,
+                                  const GLsizei mip_count,
+                                  const CompressedLevel levels[])
+{
+  const GLsizei block_bytes = compressedBlockBytes(internal_format);
+
+  const bool s3tc = block_bytes && internal_format >= GL_COMPRESSED_RGB_S3TC_DXT1_EXT &&
+                    internal_format <= GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+  const bool bptc = internal_format >= GL_COMPRESSED_RGBA_BPTC_UNORM &&
+                    internal_format <= GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT;
+
+  const bool supported = block_bytes &&
+    (!s3tc || hasCapability(GLCap::EXT_texture_compression_s3tc)) &&
+    (!bptc || glVersionAtLeast(4, 2) || hasCapability(GLCap::ARB_texture_compression_bptc));
+
+  if(!supported)
+  {
+    if(curr_error_callback)
+    {
+      curr_error_callback("Compressed format isn't BC1 to BC7 or the driver lacks it");
+    }
+
+    return 0;
+  }
+
+  const GLsizei full_mips = textureFullMipCount(width, height);
+  const GLsizei mips = mip_count > 0 && mip_count < full_mips ? mip_count : full_mips;
+
+  #ifdef THIN_EXTRA_PARAM_CHECKS
+  for(GLsizei level = 0; level < mips; ++level)
+  {
+    const GLsizei w = width >> level ? width >> level : 1;
+    const GLsizei h = height >> level ? height >> level : 1;
+    const GLsizei expected = ((w + 3) / 4) * ((h + 3) / 4) * block_bytes;
+
+    if(!levels[level].data || levels[level].size != expected)
+    {
+      if(curr_error_callback)
+      {
+        curr_error_callback("Compressed level is missing or the wrong size");
+      }
+
+      return 0;
+    }
+  }
+  #endif
+
+  const uintptr_t texture = genTexture();
+  bindTexture(GL_TEXTURE_2D, texture);
+
+  const bool immutable = gl_tex_storage_2d != nullptr;
+
+  if(immutable)
+  {
+    gl_tex_storage_2d(GL_TEXTURE_2D, mips, internal_format, width, height);
+  }
+
+  size_t bytes = 0;
+
+  for(GLsizei level = 0; level < mips; ++level)
+  {
+    const GLsizei w = width >> level ? width >> level : 1;
+    const GLsizei h = height >> level ? height >> level : 1;
+
+    if(immutable)
+    {
+      glCompressedTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, w, h, internal_format,
+                                levels[level].size, levels[level].data);
+    }
+    else
+    {
+      glCompressedTexImage2D(GL_TEXTURE_2D, level, internal_format, w, h, 0,
+                             levels[level].size, levels[level].data);
+    }
+
+    bytes += levels[level].size;
+  }
+
+  if(!immutable && mips < full_mips)
+  {
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, mips - 1);
+  }
+
+  // Complete with a single level, like createTexture2D.
+  if(mips == 1)
+  {
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  }
+
+  #ifdef THIN_EXTRA_ERROR_CHECKS
+  getError("Create Compressed Texture 2D");
+  #endif
+
+  memoryTrack(*this, MemoryType::texture, texture, bytes);
+  stats.bytes_uploaded += bytes;
+
+  return texture;
+}
+
+void
+Device::setTextureMemory(const uintptr_t texture, const size_t bytes)
+{
+  if(bytes)
+  {
+    memoryTrack(*this, MemoryType::texture, texture, bytes);
+  }
+  else
+  {
+    memoryUntrack(*this, MemoryType::texture, texture);
+  }
+}
+
+size_t
+Device::getTextureMemory(const uintptr_t texture) const
+{
+  if(!memory_table_count)
+  {
+    return 0;
+  }
+
+  const MemoryEntry &entry = memory_table[memorySlot(*this, memoryKey(MemoryType::texture, texture))];
+
+  return entry.key ? entry.bytes : 0;
+}
+
+
+// --------------------------------------------------------------[ Samplers ]--
+
+uintptr_t
+Device::getSampler(const SamplerDesc &desc)
+{
+  uint32_t key = 0;
+
+  if(!samplerKey(desc, &key))
+  {
+    if(curr_error_callback)
+    {
+      curr_error_callback("Sampler desc has an unknown filter, wrap or compare");
+    }
+
+    return 0;
+  }
+
+  if(sampler_cache_count)
+  {
+    const SamplerCacheEntry &entry = sampler_cache[samplerCacheSlot(*this, key)];
+
+    if(entry.sampler)
+    {
+      return entry.sampler;
+    }
+  }
+
+  if(!samplerObjectsSupported(*this))
+  {
+    return 0;
+  }
+
+  // Grow, keeps the load factor under a half.
+  if((sampler_cache_count + 1) * 2 > sampler_cache_capacity)
+  {
+    SamplerCacheEntry *old_cache = sampler_cache;
+    const size_t old_capacity = sampler_cache_capacity;
+
+    sampler_cache_capacity = old_capacity ? old_capacity * 2 : 16;
+    sampler_cache = (SamplerCacheEntry*)calloc(sampler_cache_capacity,
+                                               sizeof(SamplerCacheEntry));
+
+    for(size_t i = 0; i < old_capacity; ++i)
+    {
+      if(old_cache[i].sampler)
+      {
+        sampler_cache[samplerCacheSlot(*this, old_cache[i].key)] = old_cache[i];
+      }
+    }
+
+    free(old_cache);
+  }
+
+  GLuint sampler = 0;
+  glGenSamplers(1, &sampler);
+  stats.objects_created += 1;
+
+  // Only what differs from the GL defaults.
+  if(desc.min_filter && desc.min_filter != GL_NEAREST_MIPMAP_LINEAR)
+  {
+    glSamplerParameteri(sampler, GL_TEXTURE_MIN_FILTER, desc.min_filter);
+  }
+
+  if(desc.mag_filter && desc.mag_filter != GL_LINEAR)
+  {
+    glSamplerParameteri(sampler, GL_TEXTURE_MAG_FILTER, desc.mag_filter);
+  }
+
+  const GLenum wrap_params[] = {GL_TEXTURE_WRAP_S, GL_TEXTURE_WRAP_T, GL_TEXTURE_WRAP_R};
+  const GLenum wraps[] = {desc.wrap_s, desc.wrap_t, desc.wrap_r};
+
+  for(int i = 0; i < 3; ++i)
+  {
+    if(wraps[i] && wraps[i] != GL_REPEAT)
+    {
+      glSamplerParameteri(sampler, wrap_params[i], wraps[i]);
+    }
+  }
+
+  if(desc.compare_func)
+  {
+    glSamplerParameteri(sampler, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+    glSamplerParameteri(sampler, GL_TEXTURE_COMPARE_FUNC, desc.compare_func);
+  }
+
+  if(desc.max_anisotropy > 1 && hasCapability(GLCap::EXT_texture_filter_anisotropic))
+  {
+    const GLuint anisotropy = desc.max_anisotropy > 16 ? 16 : desc.max_anisotropy;
+    glSamplerParameterf(sampler, GL_TEXTURE_MAX_ANISOTROPY_EXT, (GLfloat)anisotropy);
+  }
+
+  #ifdef THIN_EXTRA_ERROR_CHECKS
+  getError("Create Sampler");
+  #endif
+
+  SamplerCacheEntry &entry = sampler_cache[samplerCacheSlot(*this, key)];
+  entry.key = key;
+  entry.sampler = (uintptr_t)sampler;
+  ++sampler_cache_count;
+
+  return entry.sampler;
+}
+
+void
+Device::bindSampler(const GLuint unit, const uintptr_t sampler)
+{
+  // getSampler only hands out zero then, textures keep their own state.
+  if(!samplerObjectsSupported(*this))
+  {
+    return;
+  }
+
+  const bool cached = unit < THIN_MAX_TEXTURE_UNITS;
+
+  if(cached && bound_samplers[unit] == (GLuint)sampler)
+  {
+    stats.redundant_binds += 1;
+    return;
+  }
+
+  glBindSampler(unit, (GLuint)sampler);
+  stats.bind_samplers += 1;
+
+  if(cached)
+  {
+    bound_samplers[unit] = (GLuint)sampler;
+  }
+
+  #ifdef THIN_EXTRA_ERROR_CHECKS
+  getError("Bind Sampler");
+  #endif
+}
+
+void
+Device::clearSamplerCache()
+{
+  for(size_t i = 0; i < sampler_cache_capacity; ++i)
+  {
+    if(sampler_cache[i].sampler)
+    {
+      const GLuint sampler = (GLuint)sampler_cache[i].sampler;
+      glDeleteSamplers(1, &sampler);
+    }
+  }
+
+  #ifdef THIN_EXTRA_ERROR_CHECKS
+  getError("Clear Sampler Cache");
+  #endif
+
+  // Deleted samplers unbind, units go back to the texture's parameters.
+  memset(bound_samplers, 0xff, sizeof(bound_samplers));
+
+  stats.objects_deleted += sampler_cache_count;
+
+  free(sampler_cache);
+  sampler_cache = nullptr;
+  sampler_cache_capacity = 0;
+  sampler_cache_count = 0;
+}
+
+
+// --------------------------------------------------------[ Texture Upload ]--
+
+static size_t
+unpackDataSize(const GLsizei width,
+               const GLsizei height,
+               const GLenum format,
+               const GLenum type)
+{
+  // Span glTexSubImage2D reads from the client pointer, first byte to last.
+  const size_t bytes = pixelBytes(format, type);
+
+  if(!bytes || width <= 0 || height <= 0)
+  {
+    return 0;
+  }
+
+  GLint alignment = 4;
+  GLint row_length = 0;
+  GLint skip_rows = 0;
+  GLint skip_pixels = 0;
+
+  glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+  glGetIntegerv(GL_UNPACK_ROW_LENGTH, &row_length);
+  glGetIntegerv(GL_UNPACK_SKIP_ROWS, &skip_rows);
+  glGetIntegerv(GL_UNPACK_SKIP_PIXELS, &skip_pixels);
+
+  const size_t row_pixels = row_length > 0 ? (size_t)row_length : (size_t)width;
+  const size_t row = (row_pixels * bytes + alignment - 1) / alignment * alignment;
+
+  return (size_t)skip_rows * row + (size_t)skip_pixels * bytes +
+         (size_t)(height - 1) * row + (size_t)width * bytes;
+}
+
+static size_t
+uploadStageFind(Device &dev, const size_t size)
+{
+  size_t best = dev.upload_stage_count;
+
+  for(size_t i = 0; i < dev.upload_stage_count; ++i)
+  {
+    Device::UploadStage &stage = dev.upload_stages[i];
+
+    if(stage.fence)
+    {
+      // Poll only, a busy stage is skipped rather than waited on.
+      const GLenum status = glClientWaitSync(stage.fence, 0, 0);
+
+      if(status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+      {
+        continue;
+      }
+
+      glDeleteSync(stage.fence);
+      stage.fence = nullptr;
+    }
+
+    if(stage.size >= size &&
+       (best == dev.upload_stage_count || stage.size < dev.upload_stages[best].size))
+    {
+      best = i;
+    }
+  }
+
+  return best;
+}
+
+static size_t
+uploadStageCreate(Device &dev, const size_t size)
+{
+  size_t stage_size = THIN_UPLOAD_MIN_STAGE;
+
+  while(stage_size < size)
+  {
+    stage_size *= 2;
+  }
+
+  // Over budget, free stages are all too small so make room from those.
+  if(dev.upload_pool_bytes + stage_size > THIN_UPLOAD_POOL_BYTES)
+  {
+    size_t i = 0;
+
+    while(i < dev.upload_stage_count)
+    {
+      Device::UploadStage &stage = dev.upload_stages[i];
+
+      if(stage.fence)
+      {
+        ++i;
+        continue;
+      }
+
+      dev.deleteBuffer(stage.buffer);
+      dev.upload_pool_bytes -= stage.size;
+      stage = dev.upload_stages[--dev.upload_stage_count];
+    }
+
+    if(dev.upload_pool_bytes + stage_size > THIN_UPLOAD_POOL_BYTES)
+    {
+      return dev.upload_stage_count;
+    }
+  }
+
+  if(dev.upload_stage_count == dev.upload_stage_capacity)
+  {
+    dev.upload_stage_capacity = dev.upload_stage_capacity ? dev.upload_stage_capacity * 2 : 8;
+    dev.upload_stages = (Device::UploadStage*)realloc(
+      dev.upload_stages,
+      dev.upload_stage_capacity * sizeof(Device::UploadStage));
+  }
+
+  Device::UploadStage &stage = dev.upload_stages[dev.upload_stage_count];
+  stage.buffer = dev.genBuffer();
+  stage.size = stage_size;
+  stage.fence = nullptr;
+
+  dev.bindBuffer(GL_PIXEL_UNPACK_BUFFER, stage.buffer);
+  dev.bufferData(GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr)stage_size, nullptr, GL_STREAM_DRAW);
+
+  dev.upload_pool_bytes += stage_size;
+
+  return dev.upload_stage_count++;
+}
+
+void
+Device::uploadTexture2D(const uintptr_t texture,
+                        const GLint level,
+                        const GLint x,
+                        const GLint y,
+                        const GLsizei width,
+                        const GLsizei height,
+                        const GLenum format,
+                        const GLenum type,
+                        const GLvoid *pixels)
+{
+  // Null pixels is legal, there's nothing to stage then.
+  const bool can_stage = pixels &&
+                         (GLAD_GL_VERSION_3_2 || hasCapability(GLCap::ARB_sync));
+
+  // The buffer mirrors the client layout, the unpack state reads it the same.
+  const size_t size = can_stage ? unpackDataSize(width, height, format, type) : 0;
+
+  size_t stage_index = upload_stage_count;
+
+  if(size)
+  {
+    stage_index = uploadStageFind(*this, size);
+
+    if(stage_index == upload_stage_count)
+    {
+      stage_index = uploadStageCreate(*this, size);
+    }
+  }
+
+  bindTexture(GL_TEXTURE_2D, texture);
+  stats.bytes_uploaded += pixels ? pixelDataSize(width, height, format, type) : 0;
+
+  if(stage_index == upload_stage_count)
+  {
+    glTexSubImage2D(GL_TEXTURE_2D, level, x, y, width, height, format, type, pixels);
+
+    #ifdef THIN_EXTRA_ERROR_CHECKS
+    getError("Upload Texture 2D");
+    #endif
+
+    return;
+  }
+
+  UploadStage &stage = upload_stages[stage_index];
+  bindBuffer(GL_PIXEL_UNPACK_BUFFER, stage.buffer);
+
+  // The fence says the GPU is done with it, no need for the driver to sync.
+  void *staging = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER,
+                                   0,
+                                   (GLsizeiptr)size,
+                                   GL_MAP_WRITE_BIT |
+                                   GL_MAP_INVALIDATE_RANGE_BIT |
+                                   GL_MAP_UNSYNCHRONIZED_BIT);
+
+  if(staging)
+  {
+    memcpy(staging, pixels, size);
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+    glTexSubImage2D(GL_TEXTURE_2D, level, x, y, width, height, format, type, nullptr);
+  }
+
+  // Client pointers mean client memory again for everyone else.
+  bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+  if(staging)
+  {
+    stage.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  }
+  else
+  {
+    glTexSubImage2D(GL_TEXTURE_2D, level, x, y, width, height, format, type, pixels);
+  }
+
+  #ifdef THIN_EXTRA_ERROR_CHECKS
+  getError("Upload Texture 2D");
+  #endif
+}
+
+void
+Device::clearUploadPool()
+{
+  for(size_t i = 0; i < upload_stage_count; ++i)
+  {
+    UploadStage &stage = upload_stages[i];
+
+    if(stage.fence)
+    {
+      glClientWaitSync(stage.fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+      glDeleteSync(stage.fence);
+    }
+
+    deleteBuffer(stage.buffer);
+  }
+
+  #ifdef THIN_EXTRA_ERROR_CHECKS
+  getError("Clear Upload Pool");
+  #endif
+
+  free(upload_stages);
+  upload_stages = nullptr;
+  upload_stage_count = 0;
+  upload_stage_capacity = 0;
+  upload_pool_bytes = 0;
+}
+
+
+// ---------------------------------------------------------[ Renderbuffers ]--
+
+uintptr_t
+Device::createRenderbuffer(const GLenum internal_format,
+                           const GLsizei width,
+                           const GLsizei height,
+                           const GLsizei samples)
+{
+  TextureFormatInfo info;
+
+  if(!textureFormatInfo(internal_format, &info))
+  {
+    #ifdef THIN_EXTRA_PARAM_CHECKS
+    if(curr_error_callback)
+    {
+      curr_error_callback("Unknown renderbuffer format");
+    }
+    #endif
+
+    return 0;
+  }
+
+  GLuint renderbuffer = 0;
+
+  glGenRenderbuffers(1, &renderbuffer);
+  stats.objects_created += 1;
+
+  glBindRenderbuffer(GL_RENDERBUFFER, renderbuffer);
+
+  if(samples)
+  {
+    glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, internal_format, width, height);
+  }
+  else
+  {
+    glRenderbufferStorage(GL_RENDERBUFFER, internal_format, width, height);
+  }
+
+  glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+  #ifdef THIN_EXTRA_ERROR_CHECKS
+  getError("Create Renderbuffer");
+  #endif
+
+  memoryTrack(*this, MemoryType::renderbuffer, renderbuffer,
+              (size_t)width * height * info.bytes * (samples ? samples : 1));
+
+  return renderbuffer;
 }
 
 void
-Device::getClearColor(float out_color[4])
+Device::deleteRenderbuffers(const size_t count, const uintptr_t del_renderbuffers[])
 {
+  GLuint *renderbuffers = (GLuint*)malloc(count * sizeof(GLuint));
+
+  for(size_t i = 0; i < count; ++i)
+  {
+    renderbuffers[i] = (GLuint)del_renderbuffers[i];
+    memoryUntrack(*this, MemoryType::renderbuffer, del_renderbuffers[i]);
+  }
+
+  for(size_t i = 0; fbo_cache_count && i < count; ++i)
+  {
+    fboCacheEvictAttachment(*this, del_renderbuffers[i], true);
+  }
+
+  glDeleteRenderbuffers(count, renderbuffers);
+  stats.objects_deleted += count;
+
+  #ifdef THIN_EXTRA_ERROR_CHECKS
+  getError("Delete Renderbuffers");
+  #endif
+
+  free(renderbuffers);
 }
 
 
-// ---------------------------------------------------------------[ Texture ]--
+// ----------------------------------------------------------[ Framebuffers ]--
 
 uintptr_t
-Device::genTexture()
+Device::getFramebuffer(const FramebufferDesc &desc)
 {
-  uintptr_t tex;
-  genTextures(1, &tex);
+  const uint64_t key = fboCacheKey(desc);
 
-  return tex;
-}
+  // Lookup
+  if(fbo_cache_capacity)
+  {
+    const size_t mask = fbo_cache_capacity - 1;
+    size_t slot = key & mask;
 
-void
-Device::genTextures(const size_t count, uintptr_t out_textures[])
-{
-  GLuint *textures = (GLuint*)malloc(sizeof(GLuint) * count);
-  glGenTextures(count, textures);
+    while(fbo_cache[slot].framebuffer)
+    {
+      const FramebufferCacheEntry &entry = fbo_cache[slot];
+
+      if(entry.key == key && fboDescEqual(entry.desc, desc))
+      {
+        return entry.framebuffer;
+      }
+
+      slot = (slot + 1) & mask;
+    }
+  }
+
+  // Create and check, then put back what was bound.
+  GLuint prev_draw = bound_draw_framebuffer;
+  GLuint prev_read = bound_read_framebuffer;
+
+  if(prev_draw == thin_unknown_binding || prev_read == thin_unknown_binding)
+  {
+    GLint binding = 0;
+
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &binding);
+    prev_draw = (GLuint)binding;
+
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &binding);
+    prev_read = (GLuint)binding;
+  }
+
+  GLuint fbo = 0;
+
+  glGenFramebuffers(1, &fbo);
+  stats.objects_created += 1;
+
+  glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+  stats.bind_framebuffers += 1;
+
+  GLenum draw_buffers[THIN_MAX_COLOR_ATTACHMENTS];
+  GLsizei draw_count = 0;
+
+  for(GLsizei i = 0; i < THIN_MAX_COLOR_ATTACHMENTS; ++i)
+  {
+    draw_buffers[i] = desc.color[i].object ? GL_COLOR_ATTACHMENT0 + i : GL_NONE;
+    draw_count = desc.color[i].object ? i + 1 : draw_count;
+
+    if(desc.color[i].object)
+    {
+      fboAttach(GL_COLOR_ATTACHMENT0 + i, desc.color[i]);
+    }
+  }
+
+  if(desc.depth.object)
+  {
+    fboAttach(desc.depth_stencil ? GL_DEPTH_STENCIL_ATTACHMENT : GL_DEPTH_ATTACHMENT, desc.depth);
+  }
+
+  // Depth only passes read and draw no color.
+  if(draw_count)
+  {
+    glDrawBuffers(draw_count, draw_buffers);
+  }
+  else
+  {
+    glDrawBuffer(GL_NONE);
+    glReadBuffer(GL_NONE);
+  }
+
+  const GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+
+  if(prev_draw == prev_read)
+  {
+    glBindFramebuffer(GL_FRAMEBUFFER, prev_draw);
+  }
+  else
+  {
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, prev_draw);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, prev_read);
+  }
+
+  stats.bind_framebuffers += 1;
+  bound_draw_framebuffer = prev_draw;
+  bound_read_framebuffer = prev_read;
 
   #ifdef THIN_EXTRA_ERROR_CHECKS
-  getError("glGenTextures");
+  getError("Create Framebuffer");
   #endif
 
-  for(size_t i = 0; i < count; ++i)
+  if(status != GL_FRAMEBUFFER_COMPLETE)
   {
-    out_textures[i] = (uintptr_t)textures[i];
+    if(curr_error_callback)
+    {
+      curr_error_callback(fboStatusMessage(status));
+    }
+
+    glDeleteFramebuffers(1, &fbo);
+    stats.objects_deleted += 1;
+
+    return 0;
   }
 
-  free(textures);
-}
+  // Grow, keeps the load factor under a half.
+  if((fbo_cache_count + 1) * 2 > fbo_cache_capacity)
+  {
+    const size_t new_capacity = fbo_cache_capacity ? fbo_cache_capacity * 2 : 16;
+
+    FramebufferCacheEntry *new_cache = (FramebufferCacheEntry*)calloc(
+      new_capacity,
+      sizeof(FramebufferCacheEntry));
+
+    for(size_t i = 0; i < fbo_cache_capacity; ++i)
+    {
+      if(fbo_cache[i].framebuffer)
+      {
+        fboCacheInsert(new_cache, new_capacity, fbo_cache[i]);
+      }
+    }
+
+    free(fbo_cache);
+    fbo_cache = new_cache;
+    fbo_cache_capacity = new_capacity;
+  }
 
-uintptr_t
-Device::createTexture()
-{
-  return genTexture();
+  FramebufferCacheEntry entry;
+  memset(&entry, 0, sizeof(entry));
+
+  entry.key = key;
+  entry.desc = desc;
+  entry.framebuffer = fbo;
+
+  fboCacheInsert(fbo_cache, fbo_cache_capacity, entry);
+  ++fbo_cache_count;
+
+  return entry.framebuffer;
 }
 
 void
-Device::createTextures(const size_t count, uintptr_t textures[])
+Device::setDefaultFramebuffer(const uintptr_t framebuffer)
 {
-  return genTextures(count, textures);
+  default_framebuffer = (GLuint)framebuffer;
 }
 
 void
-Device::bindTexture(const GLenum target, const uintptr_t texture)
+Device::bindFramebuffer(const GLenum target, const uintptr_t framebuffer)
 {
-  glBindTexture(target, (GLuint)texture);
+  const GLuint fbo = framebuffer ? (GLuint)framebuffer : default_framebuffer;
+  const bool draw = target != GL_READ_FRAMEBUFFER;
+  const bool read = target != GL_DRAW_FRAMEBUFFER;
 
-  #ifdef THIN_EXTRA_ERROR_CHECKS
-  getError("glBindTexture");
-  #endif
-}
+  if((!draw || bound_draw_framebuffer == fbo) && (!read || bound_read_framebuffer == fbo))
+  {
+    stats.redundant_binds += 1;
+    return;
+  }
 
-void
-Device::bindActiveTexture(const GLuint texture_slot,
-                          const GLenum target,
-                          const uintptr_t texture)
-{
-  glActiveTexture(texture_slot);
-  glBindTexture(target, (GLuint)texture);
+  glBindFramebuffer(target, fbo);
+  stats.bind_framebuffers += 1;
+
+  bound_draw_framebuffer = draw ? fbo : bound_draw_framebuffer;
+  bound_read_framebuffer = read ? fbo : bound_read_framebuffer;
 
   #ifdef THIN_EXTRA_ERROR_CHECKS
-  getError("glBindTexture");
+  getError("Binding Framebuffer");
   #endif
 }
 
-void
-Device::bindTextures(const GLuint first_target,
-                     const size_t count,
-                     const uintptr_t in_textures[])
+bool
+Device::bindFramebuffer(const FramebufferDesc &desc)
 {
-  // GLuint *textures = (GLuint*)malloc(sizeof(GLuint) * count);
-  //
-  // for(size_t i = 0; i < count; ++i)
-  // {
-  //   textures[i] = (GLuint)in_textures[i];
-  // }
-  //
-  // glBindTextures(first_target, count, textures);
-  //
-  // free(textures);
-  //
-  // #ifdef THIN_EXTRA_ERROR_CHECKS
-  // getError("Bind Textures");
-  // #endif
-}
+  const uintptr_t fbo = getFramebuffer(desc);
 
-void
-Device::deleteTexture(const uintptr_t texture)
-{
-  deleteTextures(1, &texture);
+  if(fbo)
+  {
+    bindFramebuffer(GL_FRAMEBUFFER, fbo);
+  }
+
+  return fbo != 0;
 }
 
 void
-Device::deleteTextures(const size_t count, const uintptr_t in_textures[])
+Device::clearFramebufferCache()
 {
-  GLuint *textures = (GLuint*)malloc(sizeof(GLuint) * count);
-
-  for(size_t i = 0; i < count; ++i)
+  for(size_t i = 0; i < fbo_cache_capacity; ++i)
   {
-    textures[i] = (GLuint)in_textures[i];
+    if(fbo_cache[i].framebuffer)
+    {
+      const GLuint fbo = (GLuint)fbo_cache[i].framebuffer;
+      glDeleteFramebuffers(1, &fbo);
+      fboForget(*this, fbo);
+    }
   }
 
-  glDeleteTextures(count, textures);
-
-  free(textures);
-
   #ifdef THIN_EXTRA_ERROR_CHECKS
-  getError("glDeleteTextures");
+  getError("Clear Framebuffer Cache");
   #endif
+
+  stats.objects_deleted += fbo_cache_count;
+
+  free(fbo_cache);
+  fbo_cache = nullptr;
+  fbo_cache_capacity = 0;
+  fbo_cache_count = 0;
 }
 
 
@@ -589,6 +5432,7 @@ Device::createProgram(const char *vs, const char *gs, const char *fs)
   glCompileShader(frag_shd);
 
   GLuint prog = glCreateProgram();
+  stats.objects_created += 1;
   glAttachShader(prog, vert_shd);
 
   if(geo_shd)
@@ -609,7 +5453,15 @@ Device::createProgram(const char *vs, const char *gs, const char *fs)
 void
 Device::useProgram(const uintptr_t program)
 {
+  if(bound_program == (GLuint)program)
+  {
+    stats.redundant_binds += 1;
+    return;
+  }
+
   glUseProgram((GLuint)program);
+  stats.bind_programs += 1;
+  bound_program = (GLuint)program;
 
   #ifdef THIN_EXTRA_ERROR_CHECKS
   getError("Use Program");
@@ -635,6 +5487,14 @@ Device::deleteProgram(const uintptr_t program)
   #endif
 
   glDeleteProgram((GLuint)program);
+  stats.objects_deleted += 1;
+
+  // GL keeps it current, but its name can be handed out again and a new
+  // program under it has to be bound for real.
+  if(bound_program == (GLuint)program)
+  {
+    bound_program = thin_unknown_binding;
+  }
 
   #ifdef THIN_EXTRA_ERROR_CHECKS
   getError("Deleting Program");
@@ -672,6 +5532,7 @@ void
 Device::uniform1i(const intptr_t location, const GLint v0)
 {
   glUniform1i((GLint)location, v0);
+  stats.uniform_uploads += 1;
 
   #ifdef THIN_EXTRA_ERROR_CHECKS
   getError("Setting location");
@@ -695,6 +5556,7 @@ Device::genBuffers(const size_t count, uintptr_t out_buffers[])
   GLuint *buffers = (GLuint*)malloc(count * sizeof(GLuint));
 
   glGenBuffers(count, buffers);
+  stats.objects_created += count;
 
   // Convert back to uintptrs
   for(size_t i = 0; i < count; ++i)
@@ -726,7 +5588,21 @@ Device::createBuffers(const size_t count, uintptr_t buffers[])
 void
 Device::bindBuffer(const GLenum target, const uintptr_t buffer)
 {
+  const size_t slot = bindBufferTarget(target);
+
+  if(slot < thin_bind_buffer_targets && bound_buffers[slot] == (GLuint)buffer)
+  {
+    stats.redundant_binds += 1;
+    return;
+  }
+
   glBindBuffer(target, (GLuint)buffer);
+  stats.bind_buffers += 1;
+
+  if(slot < thin_bind_buffer_targets)
+  {
+    bound_buffers[slot] = (GLuint)buffer;
+  }
 
   #ifdef THIN_EXTRA_ERROR_CHECKS
   getError("Binding Buffer");
@@ -740,6 +5616,29 @@ Device::bufferData(const GLenum target,
                    const GLenum use)
 {
   glBufferData(target, size, data, use);
+  stats.bytes_uploaded += data ? (uint64_t)size : 0;
+
+  // Storage belongs to whatever is bound, ask GL when the cache can't say.
+  const size_t slot = bindBufferTarget(target);
+  GLuint buffer = slot < thin_bind_buffer_targets ? bound_buffers[slot] : thin_unknown_binding;
+
+  if(buffer == thin_unknown_binding)
+  {
+    const GLenum query = bufferBindingQuery(target);
+    GLint bound = 0;
+
+    if(query)
+    {
+      glGetIntegerv(query, &bound);
+    }
+
+    buffer = (GLuint)bound;
+  }
+
+  if(buffer)
+  {
+    memoryTrack(*this, MemoryType::buffer, buffer, (size_t)size);
+  }
 
   #ifdef THIN_EXTRA_ERROR_CHECKS
   getError("Adding Buffer Data");
@@ -763,7 +5662,28 @@ Device::deleteBuffers(const size_t count, const uintptr_t del_buffers[])
     buffers[i] = (GLuint)del_buffers[i];
   }
 
+  // Cached VAOs would keep the old buffers alive under recycled names.
+  for(size_t i = 0; vao_cache_count && i < count; ++i)
+  {
+    vaoCacheEvictBuffer(*this, del_buffers[i]);
+  }
+
   glDeleteBuffers(count, buffers);
+  stats.objects_deleted += count;
+
+  for(size_t i = 0; memory_table_count && i < count; ++i)
+  {
+    memoryUntrack(*this, MemoryType::buffer, del_buffers[i]);
+  }
+
+  // Deleted buffers unbind, from the current VAO too.
+  for(size_t i = 0; i < count; ++i)
+  {
+    for(size_t t = 0; t < thin_bind_buffer_targets; ++t)
+    {
+      bound_buffers[t] = bound_buffers[t] == buffers[i] ? 0 : bound_buffers[t];
+    }
+  }
 
   #ifdef THIN_EXTRA_ERROR_CHECKS
   getError("Destroying Buffers");
@@ -824,12 +5744,233 @@ Device::enableVertexAttribArrayPointer(const intptr_t attr_index,
 }
 
 
+// -------------------------------------------------------------[ VAO Cache ]--
+
+uintptr_t
+Device::getVertexArray(const VertexLayout &layout,
+                       const size_t buffer_count,
+                       const uintptr_t buffers[],
+                       const uintptr_t index_buffer)
+{
+  return getVertexArray(vertexLayoutHash(layout),
+                        layout,
+                        buffer_count,
+                        buffers,
+                        index_buffer);
+}
+
+uintptr_t
+Device::getVertexArray(const uint64_t layout_hash,
+                       const VertexLayout &layout,
+                       const size_t buffer_count,
+                       const uintptr_t buffers[],
+                       const uintptr_t index_buffer)
+{
+  #ifdef THIN_EXTRA_PARAM_CHECKS
+  if(buffer_count > THIN_MAX_VERTEX_BUFFERS ||
+     layout.attrib_count > THIN_MAX_VERTEX_ATTRIBS)
+  {
+    if(curr_error_callback)
+    {
+      curr_error_callback("Vertex layout exceeds THIN_MAX_VERTEX_* limits");
+    }
+
+    return 0;
+  }
+  #endif
+
+  const uint64_t key = vaoCacheKey(layout_hash,
+                                   buffer_count,
+                                   buffers,
+                                   index_buffer);
+
+  // Lookup
+  if(vao_cache_capacity)
+  {
+    const size_t mask = vao_cache_capacity - 1;
+    size_t slot = key & mask;
+
+    while(vao_cache[slot].vao)
+    {
+      const VertexArrayCacheEntry &entry = vao_cache[slot];
+
+      if(entry.key == key &&
+         entry.layout_hash == layout_hash &&
+         entry.buffer_count == buffer_count &&
+         entry.index_buffer == index_buffer &&
+         vertexLayoutEqual(entry.layout, layout) &&
+         memcmp(entry.buffers, buffers, buffer_count * sizeof(uintptr_t)) == 0)
+      {
+        return entry.vao;
+      }
+
+      slot = (slot + 1) & mask;
+    }
+  }
+
+  // Grow, keeps the load factor under a half.
+  if((vao_cache_count + 1) * 2 > vao_cache_capacity)
+  {
+    const size_t new_capacity = vao_cache_capacity ? vao_cache_capacity * 2 : 16;
+
+    VertexArrayCacheEntry *new_cache = (VertexArrayCacheEntry*)calloc(
+      new_capacity,
+      sizeof(VertexArrayCacheEntry));
+
+    for(size_t i = 0; i < vao_cache_capacity; ++i)
+    {
+      if(vao_cache[i].vao)
+      {
+        vaoCacheInsert(new_cache, new_capacity, vao_cache[i]);
+      }
+    }
+
+    free(vao_cache);
+    vao_cache = new_cache;
+    vao_cache_capacity = new_capacity;
+  }
+
+  // Create and configure
+  VertexArrayCacheEntry entry;
+  memset(&entry, 0, sizeof(entry));
+
+  entry.key = key;
+  entry.layout_hash = layout_hash;
+  entry.layout = layout;
+  entry.buffer_count = buffer_count;
+  entry.index_buffer = index_buffer;
+  memcpy(entry.buffers, buffers, buffer_count * sizeof(uintptr_t));
+
+  entry.vao = genVertexArray();
+  bindVertexArray(entry.vao);
+
+  for(GLuint i = 0; i < layout.attrib_count; ++i)
+  {
+    const VertexAttrib &attr = layout.attribs[i];
+
+    #ifdef THIN_EXTRA_PARAM_CHECKS
+    if(attr.buffer >= buffer_count)
+    {
+      if(curr_error_callback)
+      {
+        curr_error_callback("Vertex attrib references a missing buffer");
+      }
+
+      continue;
+    }
+    #endif
+
+    const GLsizei stride = layout.strides[attr.buffer];
+    const GLvoid *pointer = (const GLvoid*)(uintptr_t)attr.offset;
+
+    bindBuffer(GL_ARRAY_BUFFER, buffers[attr.buffer]);
+    enableVertexAttribArray(attr.index);
+
+    if(attr.integer)
+    {
+      glVertexAttribIPointer(attr.index, attr.size, attr.type, stride, pointer);
+    }
+    else
+    {
+      glVertexAttribPointer(attr.index,
+                            attr.size,
+                            attr.type,
+                            attr.normalized,
+                            stride,
+                            pointer);
+    }
+
+    if(attr.divisor)
+    {
+      glVertexAttribDivisor(attr.index, attr.divisor);
+    }
+
+    #ifdef THIN_EXTRA_ERROR_CHECKS
+    getError("Vertex Layout Attrib");
+    #endif
+  }
+
+  if(index_buffer)
+  {
+    bindBuffer(GL_ELEMENT_ARRAY_BUFFER, index_buffer);
+  }
+
+  vaoCacheInsert(vao_cache, vao_cache_capacity, entry);
+  ++vao_cache_count;
+  vaoBufferRefsUpdate(*this, entry, true);
+
+  return entry.vao;
+}
+
+void
+Device::bindVertexLayout(const VertexLayout &layout,
+                         const size_t buffer_count,
+                         const uintptr_t buffers[],
+                         const uintptr_t index_buffer)
+{
+  bindVertexLayout(vertexLayoutHash(layout),
+                   layout,
+                   buffer_count,
+                   buffers,
+                   index_buffer);
+}
+
+void
+Device::bindVertexLayout(const uint64_t layout_hash,
+                         const VertexLayout &layout,
+                         const size_t buffer_count,
+                         const uintptr_t buffers[],
+                         const uintptr_t index_buffer)
+{
+  bindVertexArray(getVertexArray(layout_hash,
+                                 layout,
+                                 buffer_count,
+                                 buffers,
+                                 index_buffer));
+}
+
+void
+Device::clearVertexArrayCache()
+{
+  for(size_t i = 0; i < vao_cache_capacity; ++i)
+  {
+    if(vao_cache[i].vao)
+    {
+      const GLuint vao = (GLuint)vao_cache[i].vao;
+      glDeleteVertexArrays(1, &vao);
+    }
+  }
+
+  #ifdef THIN_EXTRA_ERROR_CHECKS
+  getError("Clear Vertex Array Cache");
+  #endif
+
+  stats.objects_deleted += vao_cache_count;
+
+  // The bound VAO may have been one of them.
+  bound_vertex_array = thin_unknown_binding;
+  bound_buffers[thin_bind_index_buffer] = thin_unknown_binding;
+
+  free(vao_cache);
+  vao_cache = nullptr;
+  vao_cache_capacity = 0;
+  vao_cache_count = 0;
+
+  free(vao_buffer_refs);
+  vao_buffer_refs = nullptr;
+  vao_buffer_refs_capacity = 0;
+  vao_buffer_refs_count = 0;
+}
+
+
 // ---------------------------------------------------------------[ Drawing ]--
 
 void
 Device::drawArrays(const GLenum mode, const GLint first, const GLsizei count)
 {
   glDrawArrays(mode, first, count);
+  stats.draw_calls += 1;
+  stats.vertices += (uint64_t)count;
 
   #ifdef THIN_EXTRA_ERROR_CHECKS
   getError("Draw Arrays");
@@ -843,6 +5984,8 @@ Device::drawElements(const GLenum mode,
                      const GLvoid *index)
 {
   glDrawElements(mode, count, type, index);
+  stats.draw_calls += 1;
+  stats.indices += (uint64_t)count;
 
   #ifdef THIN_EXTRA_ERROR_CHECKS
   getError("Draw Elements");
@@ -850,4 +5993,93 @@ Device::drawElements(const GLenum mode,
 }
 
 
+// ---------------------------------------------------------[ Debug Markers ]--
+
+bool
+Device::getHasDebugMarkers()
+{
+  return hasCapability(GLCap::KHR_debug) ||
+         hasCapability(GLCap::EXT_debug_marker);
+}
+
+void
+Device::markerCallback(const marker_callback_fn marker_cb, void *user)
+{
+  curr_marker_callback = marker_cb;
+  curr_marker_user = user;
+}
+
+void
+Device::insertEventMarker(const char *msg)
+{
+  if(hasCapability(GLCap::KHR_debug))
+  {
+    glDebugMessageInsert(GL_DEBUG_SOURCE_APPLICATION,
+                         GL_DEBUG_TYPE_MARKER,
+                         0,
+                         GL_DEBUG_SEVERITY_NOTIFICATION,
+                         -1,
+                         msg);
+  }
+  else if(hasCapability(GLCap::EXT_debug_marker))
+  {
+    glInsertEventMarkerEXT(0, msg);
+  }
+
+  if(curr_marker_callback)
+  {
+    curr_marker_callback(curr_marker_user, MarkerEvent::insert, msg);
+  }
+
+  #ifdef THIN_EXTRA_ERROR_CHECKS
+  getError("Insert Event Marker");
+  #endif
+}
+
+void
+Device::pushGroupMarker(const char *debug)
+{
+  if(hasCapability(GLCap::KHR_debug))
+  {
+    glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, -1, debug);
+  }
+  else if(hasCapability(GLCap::EXT_debug_marker))
+  {
+    glPushGroupMarkerEXT(0, debug);
+  }
+
+  if(curr_marker_callback)
+  {
+    curr_marker_callback(curr_marker_user, MarkerEvent::push, debug);
+  }
+
+  #ifdef THIN_EXTRA_ERROR_CHECKS
+  getError("Push Group Marker");
+  #endif
+}
+
+void
+Device::popGroupMarker()
+{
+  // Callback first, GPU timing wants to end before the driver's pop.
+  if(curr_marker_callback)
+  {
+    curr_marker_callback(curr_marker_user, MarkerEvent::pop, nullptr);
+  }
+
+  if(hasCapability(GLCap::KHR_debug))
+  {
+    glPopDebugGroup();
+  }
+  else if(hasCapability(GLCap::EXT_debug_marker))
+  {
+    glPopGroupMarkerEXT();
+  }
+
+  #ifdef THIN_EXTRA_ERROR_CHECKS
+  getError("Pop Group Marker");
+  #endif
+}
+
+
 #endif // impl guard
@@ -0,0 +1,316 @@
+#ifndef THIN_OGL_HEADLESS_INCLUDED_
+#define THIN_OGL_HEADLESS_INCLUDED_
+
+
+/*
+  Creates a GL context with no window or display server through EGL, for
+  benchmarks and CI boxes that only have Mesa's llvmpipe. Link with -lEGL.
+
+  Surfaceless contexts have no default framebuffer, so one is made from an
+  FBO and left bound, draws and glReadPixels then behave as with a window.
+  Pass framebuffer to Device::setDefaultFramebuffer so binding zero gets it.
+*/
+
+
+#include <stdint.h>
+#include <stddef.h>
+
+
+struct HeadlessContext
+{
+  void      *display;       // EGLDisplay
+  void      *context;       // EGLContext
+  void      *surface;       // EGLSurface, only with the pbuffer fallback.
+  uint32_t  framebuffer;    // FBO standing in for the default framebuffer.
+  uint32_t  renderbuffers[2];
+  int       width;
+  int       height;
+  bool      surfaceless;
+};
+
+bool
+createHeadlessContext(HeadlessContext *out_ctx,
+                      const int width = 800,
+                      const int height = 480,
+                      const int gl_major = 3,
+                      const int gl_minor = 3);
+
+void
+destroyHeadlessContext(HeadlessContext *ctx);
+
+/*
+  eglGetProcAddress, pass to Device::initialize.
+*/
+void*
+headlessGetProc(const char *name);
+
+
+#endif // inc guard
+
+
+#if defined(THIN_HEADLESS_IMPL) && !defined(THIN_HEADLESS_IMPL_INCLUDED_)
+#define THIN_HEADLESS_IMPL_INCLUDED_
+
+#include <string.h>
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+
+// --------------------------------------------------------------[ Headless ]--
+
+namespace {
+
+// Raw GL for the stand in framebuffer, Device isn't loaded yet.
+typedef void (*headless_gen_fn)(int, uint32_t*);
+typedef void (*headless_bind_fn)(uint32_t, uint32_t);
+typedef void (*headless_storage_fn)(uint32_t, uint32_t, int, int);
+typedef void (*headless_attach_fn)(uint32_t, uint32_t, uint32_t, uint32_t);
+typedef void (*headless_delete_fn)(int, const uint32_t*);
+typedef void (*headless_viewport_fn)(int, int, int, int);
+
+} // anon ns
+
+static bool
+headlessHasExtension(const char *extensions, const char *name)
+{
+  const size_t len = strlen(name);
+
+  for(const char *loc = extensions; loc && (loc = strstr(loc, name)); loc += len)
+  {
+    if((loc == extensions || loc[-1] == ' ') && (loc[len] == ' ' || !loc[len]))
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+static EGLDisplay
+headlessDisplay(bool *out_surfaceless)
+{
+  *out_surfaceless = false;
+
+  const char *client_exts = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+
+  if(headlessHasExtension(client_exts, "EGL_MESA_platform_surfaceless"))
+  {
+    PFNEGLGETPLATFORMDISPLAYEXTPROC get_platform_display =
+      (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+
+    if(get_platform_display)
+    {
+      EGLDisplay display = get_platform_display(EGL_PLATFORM_SURFACELESS_MESA,
+                                                EGL_DEFAULT_DISPLAY,
+                                                nullptr);
+
+      if(display != EGL_NO_DISPLAY && eglInitialize(display, nullptr, nullptr))
+      {
+        *out_surfaceless = true;
+        return display;
+      }
+    }
+  }
+
+  EGLDisplay display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+  if(display != EGL_NO_DISPLAY && eglInitialize(display, nullptr, nullptr))
+  {
+    return display;
+  }
+
+  return EGL_NO_DISPLAY;
+}
+
+bool
+createHeadlessContext(HeadlessContext *out_ctx,
+                      const int width,
+                      const int height,
+                      const int gl_major,
+                      const int gl_minor)
+{
+  memset(out_ctx, 0, sizeof(*out_ctx));
+  out_ctx->width = width;
+  out_ctx->height = height;
+
+  bool surfaceless = false;
+  EGLDisplay display = headlessDisplay(&surfaceless);
+
+  if(display == EGL_NO_DISPLAY || !eglBindAPI(EGL_OPENGL_API))
+  {
+    return false;
+  }
+
+  const char *display_exts = eglQueryString(display, EGL_EXTENSIONS);
+  surfaceless = surfaceless ||
+                headlessHasExtension(display_exts, "EGL_KHR_surfaceless_context");
+
+  const EGLint config_attribs[] = {
+    EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+    EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+    EGL_RED_SIZE, 8,
+    EGL_GREEN_SIZE, 8,
+    EGL_BLUE_SIZE, 8,
+    EGL_ALPHA_SIZE, 8,
+    EGL_DEPTH_SIZE, 24,
+    EGL_STENCIL_SIZE, 8,
+    EGL_NONE
+  };
+
+  EGLConfig config = nullptr;
+  EGLint config_count = 0;
+  eglChooseConfig(display, config_attribs, &config, 1, &config_count);
+
+  if(!config_count)
+  {
+    // Mesa's surfaceless platform reports no configs at all.
+    if(!headlessHasExtension(display_exts, "EGL_KHR_no_config_context"))
+    {
+      eglTerminate(display);
+      return false;
+    }
+
+    config = (EGLConfig)0; // EGL_NO_CONFIG_KHR
+  }
+
+  const EGLint context_attribs[] = {
+    EGL_CONTEXT_MAJOR_VERSION, gl_major,
+    EGL_CONTEXT_MINOR_VERSION, gl_minor,
+    EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+    EGL_NONE
+  };
+
+  EGLContext context = eglCreateContext(display,
+                                        config,
+                                        EGL_NO_CONTEXT,
+                                        context_attribs);
+
+  if(context == EGL_NO_CONTEXT)
+  {
+    eglTerminate(display);
+    return false;
+  }
+
+  EGLSurface surface = EGL_NO_SURFACE;
+
+  if(!surfaceless || config_count)
+  {
+    const EGLint pbuffer_attribs[] = {
+      EGL_WIDTH, width,
+      EGL_HEIGHT, height,
+      EGL_NONE
+    };
+
+    surface = eglCreatePbufferSurface(display, config, pbuffer_attribs);
+  }
+
+  if(!eglMakeCurrent(display, surface, surface, context))
+  {
+    if(surface != EGL_NO_SURFACE)
+    {
+      eglDestroySurface(display, surface);
+    }
+
+    eglDestroyContext(display, context);
+    eglTerminate(display);
+    return false;
+  }
+
+  out_ctx->display = display;
+  out_ctx->context = context;
+  out_ctx->surface = surface;
+  out_ctx->surfaceless = surface == EGL_NO_SURFACE;
+
+  if(out_ctx->surfaceless)
+  {
+    headless_gen_fn gen_fbos = (headless_gen_fn)eglGetProcAddress("glGenFramebuffers");
+    headless_bind_fn bind_fbo = (headless_bind_fn)eglGetProcAddress("glBindFramebuffer");
+    headless_gen_fn gen_rbos = (headless_gen_fn)eglGetProcAddress("glGenRenderbuffers");
+    headless_bind_fn bind_rbo = (headless_bind_fn)eglGetProcAddress("glBindRenderbuffer");
+    headless_storage_fn storage = (headless_storage_fn)eglGetProcAddress("glRenderbufferStorage");
+    headless_attach_fn attach = (headless_attach_fn)eglGetProcAddress("glFramebufferRenderbuffer");
+    headless_viewport_fn viewport = (headless_viewport_fn)eglGetProcAddress("glViewport");
+
+    if(!gen_fbos || !bind_fbo || !gen_rbos || !bind_rbo ||
+       !storage || !attach || !viewport)
+    {
+      destroyHeadlessContext(out_ctx);
+      return false;
+    }
+
+    // GL enums spelled out, glad isn't required by this header.
+    const uint32_t gl_framebuffer = 0x8D40;
+    const uint32_t gl_renderbuffer = 0x8D41;
+    const uint32_t gl_rgba8 = 0x8058;
+    const uint32_t gl_depth24_stencil8 = 0x88F0;
+    const uint32_t gl_color_attachment0 = 0x8CE0;
+    const uint32_t gl_depth_stencil_attachment = 0x821A;
+
+    gen_rbos(2, out_ctx->renderbuffers);
+
+    bind_rbo(gl_renderbuffer, out_ctx->renderbuffers[0]);
+    storage(gl_renderbuffer, gl_rgba8, width, height);
+
+    bind_rbo(gl_renderbuffer, out_ctx->renderbuffers[1]);
+    storage(gl_renderbuffer, gl_depth24_stencil8, width, height);
+
+    bind_rbo(gl_renderbuffer, 0);
+
+    gen_fbos(1, &out_ctx->framebuffer);
+    bind_fbo(gl_framebuffer, out_ctx->framebuffer);
+
+    attach(gl_framebuffer,
+           gl_color_attachment0,
+           gl_renderbuffer,
+           out_ctx->renderbuffers[0]);
+
+    attach(gl_framebuffer,
+           gl_depth_stencil_attachment,
+           gl_renderbuffer,
+           out_ctx->renderbuffers[1]);
+
+    viewport(0, 0, width, height);
+  }
+
+  return true;
+}
+
+void
+destroyHeadlessContext(HeadlessContext *ctx)
+{
+  if(!ctx->display)
+  {
+    return;
+  }
+
+  if(ctx->framebuffer)
+  {
+    headless_delete_fn delete_fbos = (headless_delete_fn)eglGetProcAddress("glDeleteFramebuffers");
+    headless_delete_fn delete_rbos = (headless_delete_fn)eglGetProcAddress("glDeleteRenderbuffers");
+
+    delete_fbos(1, &ctx->framebuffer);
+    delete_rbos(2, ctx->renderbuffers);
+  }
+
+  eglMakeCurrent(ctx->display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+
+  if(ctx->surface)
+  {
+    eglDestroySurface(ctx->display, ctx->surface);
+  }
+
+  eglDestroyContext(ctx->display, ctx->context);
+  eglTerminate(ctx->display);
+
+  memset(ctx, 0, sizeof(*ctx));
+}
+
+void*
+headlessGetProc(const char *name)
+{
+  return (void*)eglGetProcAddress(name);
+}
+
+
+#endif // impl guard
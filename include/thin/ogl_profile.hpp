@@ -0,0 +1,689 @@
+#ifndef THIN_OGL_PROFILE_INCLUDED_
+#define THIN_OGL_PROFILE_INCLUDED_
+
+
+/*
+  Times Device's debug marker scopes on the CPU, and on the GPU with
+  timestamp queries when the driver has them, then writes both timelines
+  with per frame DeviceStats as Chrome Trace Event JSON. Open the file in
+  Perfetto or chrome://tracing.
+
+  GPU results are read a few frames late so the render thread never waits
+  on them, writeChromeTrace waits for whatever is still in flight.
+*/
+
+
+#include "ogl_device.hpp"
+
+
+#ifndef THIN_PROFILE_MAX_DEPTH
+#define THIN_PROFILE_MAX_DEPTH 32
+#endif
+
+
+// ---------------------------------------------------------------[ Profile ]--
+
+struct ProfileScope
+{
+  uint32_t  name;           // Offset into Profiler::names.
+  uint32_t  frame;
+  uint32_t  depth;
+  GLuint    queries[2];     // Timestamps at push and pop, zero if untimed.
+  bool      instant;        // insertEventMarker, no duration.
+  bool      resolved;       // GPU times are in, or never will be.
+  int64_t   gpu_offset_ns;  // Profiler's offset when pushed.
+  uint64_t  cpu_begin_ns;
+  uint64_t  cpu_end_ns;
+  uint64_t  gpu_begin_ns;   // CPU clock, zero if untimed.
+  uint64_t  gpu_end_ns;
+};
+
+struct ProfileFrame
+{
+  uint64_t    cpu_begin_ns;
+  uint64_t    cpu_end_ns;
+  DeviceStats stats;        // This frame only.
+};
+
+struct Profiler
+{
+  Device        *device;
+  uint64_t      epoch_ns;
+  bool          gpu_timing;
+  int64_t       gpu_offset_ns;  // CPU clock minus GPU clock, per frame.
+
+  ProfileScope  *scopes;
+  size_t        scope_count;
+  size_t        scope_capacity;
+  size_t        first_unresolved;
+
+  ProfileFrame  *frames;
+  size_t        frame_count;
+  size_t        frame_capacity;
+  bool          in_frame;
+  uint32_t      frame_scope;
+  uint32_t      frame_depth;
+  DeviceStats   frame_start_stats;
+
+  uint32_t      stack[THIN_PROFILE_MAX_DEPTH];
+  uint32_t      depth;
+  uint32_t      dropped_scopes; // Pushed past THIN_PROFILE_MAX_DEPTH, not kept.
+
+  // Scope names, interned on their hash.
+  char          *names;
+  size_t        names_size;
+  size_t        names_capacity;
+  uint64_t      *name_hashes;
+  uint32_t      *name_offsets;
+  size_t        name_table_capacity;
+  size_t        name_count;
+
+  GLuint        *free_queries;
+  size_t        free_query_count;
+  size_t        free_query_capacity;
+};
+
+/*
+  Takes over the device's marker callback, every push/pop after this is a
+  scope. GPU timing needs GL 3.3 or ARB_timer_query.
+*/
+void
+createProfiler(Profiler *out_profiler, Device *device);
+
+void
+destroyProfiler(Profiler *profiler);
+
+/*
+  Frames are scopes too, and where the stats counters are cut.
+*/
+void
+profileBeginFrame(Profiler *profiler);
+
+void
+profileEndFrame(Profiler *profiler);
+
+/*
+  Collects finished GPU timings, with wait it blocks until all are in.
+*/
+void
+profileResolve(Profiler *profiler, const bool wait = false);
+
+/*
+  Drops everything recorded so far, open scopes carry on.
+*/
+void
+profileReset(Profiler *profiler);
+
+bool
+writeChromeTrace(Profiler *profiler, const char *path);
+
+
+#endif // inc guard
+
+
+#if defined(THIN_PROFILE_IMPL) && !defined(THIN_PROFILE_IMPL_INCLUDED_)
+#define THIN_PROFILE_IMPL_INCLUDED_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+
+
+// -----------------------------------------------------------------[ Utils ]--
+
+static inline uint64_t
+profileNow(const Profiler *profiler)
+{
+  const auto now = std::chrono::steady_clock::now().time_since_epoch();
+  const uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+
+  return ns - profiler->epoch_ns;
+}
+
+template<typename T>
+static void
+profileGrow(T **arr, size_t *capacity, const size_t needed, const size_t first)
+{
+  if(needed <= *capacity)
+  {
+    return;
+  }
+
+  size_t grown = *capacity ? *capacity : first;
+
+  while(grown < needed)
+  {
+    grown *= 2;
+  }
+
+  *arr = (T*)realloc(*arr, grown * sizeof(T));
+  *capacity = grown;
+}
+
+static uint32_t
+profileNameInsert(Profiler *profiler, const uint64_t hash, const uint32_t offset);
+
+static uint32_t
+profileInternName(Profiler *profiler, const char *name)
+{
+  name = name ? name : "";
+
+  const uint64_t hash = thinHashString(name);
+
+  if(profiler->name_table_capacity)
+  {
+    const size_t mask = profiler->name_table_capacity - 1;
+
+    for(size_t slot = hash & mask;
+        profiler->name_offsets[slot] != UINT32_MAX;
+        slot = (slot + 1) & mask)
+    {
+      const uint32_t offset = profiler->name_offsets[slot];
+
+      if(profiler->name_hashes[slot] == hash &&
+         strcmp(profiler->names + offset, name) == 0)
+      {
+        return offset;
+      }
+    }
+  }
+
+  const size_t len = strlen(name) + 1;
+  const uint32_t offset = (uint32_t)profiler->names_size;
+
+  profileGrow(&profiler->names,
+              &profiler->names_capacity,
+              profiler->names_size + len,
+              1024);
+
+  memcpy(profiler->names + offset, name, len);
+  profiler->names_size += len;
+
+  return profileNameInsert(profiler, hash, offset);
+}
+
+static uint32_t
+profileNameInsert(Profiler *profiler, const uint64_t hash, const uint32_t offset)
+{
+  if((profiler->name_count + 1) * 2 > profiler->name_table_capacity)
+  {
+    uint64_t *old_hashes = profiler->name_hashes;
+    uint32_t *old_offsets = profiler->name_offsets;
+    const size_t old_capacity = profiler->name_table_capacity;
+
+    profiler->name_table_capacity = old_capacity ? old_capacity * 2 : 64;
+    profiler->name_hashes = (uint64_t*)malloc(profiler->name_table_capacity * sizeof(uint64_t));
+    profiler->name_offsets = (uint32_t*)malloc(profiler->name_table_capacity * sizeof(uint32_t));
+    profiler->name_count = 0;
+
+    memset(profiler->name_offsets, 0xff, profiler->name_table_capacity * sizeof(uint32_t));
+
+    for(size_t i = 0; i < old_capacity; ++i)
+    {
+      if(old_offsets[i] != UINT32_MAX)
+      {
+        profileNameInsert(profiler, old_hashes[i], old_offsets[i]);
+      }
+    }
+
+    free(old_hashes);
+    free(old_offsets);
+  }
+
+  const size_t mask = profiler->name_table_capacity - 1;
+  size_t slot = hash & mask;
+
+  while(profiler->name_offsets[slot] != UINT32_MAX)
+  {
+    slot = (slot + 1) & mask;
+  }
+
+  profiler->name_hashes[slot] = hash;
+  profiler->name_offsets[slot] = offset;
+  profiler->name_count += 1;
+
+  return offset;
+}
+
+static GLuint
+profileTimestamp(Profiler *profiler)
+{
+  GLuint query = 0;
+
+  if(profiler->free_query_count)
+  {
+    query = profiler->free_queries[--profiler->free_query_count];
+  }
+  else
+  {
+    glGenQueries(1, &query);
+  }
+
+  glQueryCounter(query, GL_TIMESTAMP);
+
+  return query;
+}
+
+static void
+profileFreeQuery(Profiler *profiler, const GLuint query)
+{
+  profileGrow(&profiler->free_queries,
+              &profiler->free_query_capacity,
+              profiler->free_query_count + 1,
+              64);
+
+  profiler->free_queries[profiler->free_query_count++] = query;
+}
+
+static void
+profileSyncClocks(Profiler *profiler)
+{
+  // Doesn't flush, only reads the GPU clock. Redone every frame as the two
+  // clocks drift apart over a long capture.
+  GLint64 gpu_now = 0;
+  glGetInteger64v(GL_TIMESTAMP, &gpu_now);
+
+  profiler->gpu_offset_ns = (int64_t)profileNow(profiler) - (int64_t)gpu_now;
+}
+
+
+// ----------------------------------------------------------------[ Scopes ]--
+
+static ProfileScope*
+profileAddScope(Profiler *profiler, const char *name)
+{
+  profileGrow(&profiler->scopes,
+              &profiler->scope_capacity,
+              profiler->scope_count + 1,
+              256);
+
+  ProfileScope *scope = &profiler->scopes[profiler->scope_count++];
+  memset(scope, 0, sizeof(*scope));
+
+  scope->name = profileInternName(profiler, name);
+  scope->frame = (uint32_t)profiler->frame_count;
+  scope->depth = profiler->depth;
+  scope->cpu_begin_ns = profileNow(profiler);
+  scope->cpu_end_ns = scope->cpu_begin_ns;
+
+  return scope;
+}
+
+static void
+profilePush(Profiler *profiler, const char *name)
+{
+  // Too deep to track, no scope and no query, the pop only unwinds depth.
+  if(profiler->depth >= THIN_PROFILE_MAX_DEPTH)
+  {
+    profiler->dropped_scopes += 1;
+    profiler->depth += 1;
+    return;
+  }
+
+  ProfileScope *scope = profileAddScope(profiler, name);
+
+  if(profiler->gpu_timing)
+  {
+    scope->gpu_offset_ns = profiler->gpu_offset_ns;
+    scope->queries[0] = profileTimestamp(profiler);
+  }
+
+  profiler->stack[profiler->depth] = (uint32_t)(profiler->scope_count - 1);
+  profiler->depth += 1;
+}
+
+static void
+profilePop(Profiler *profiler)
+{
+  if(!profiler->depth)
+  {
+    return;
+  }
+
+  profiler->depth -= 1;
+
+  // Matches a push profilePush didn't keep.
+  if(profiler->depth >= THIN_PROFILE_MAX_DEPTH)
+  {
+    return;
+  }
+
+  ProfileScope *scope = &profiler->scopes[profiler->stack[profiler->depth]];
+  scope->cpu_end_ns = profileNow(profiler);
+
+  if(scope->queries[0])
+  {
+    scope->queries[1] = profileTimestamp(profiler);
+  }
+  else
+  {
+    scope->resolved = true;
+  }
+}
+
+static void
+profileMarker(void *user, const MarkerEvent event, const char *name)
+{
+  Profiler *profiler = (Profiler*)user;
+
+  if(event == MarkerEvent::push)
+  {
+    profilePush(profiler, name);
+  }
+  else if(event == MarkerEvent::pop)
+  {
+    profilePop(profiler);
+  }
+  else
+  {
+    ProfileScope *scope = profileAddScope(profiler, name);
+    scope->instant = true;
+    scope->resolved = true;
+  }
+}
+
+
+// --------------------------------------------------------------[ Profiler ]--
+
+void
+createProfiler(Profiler *out_profiler, Device *device)
+{
+  memset(out_profiler, 0, sizeof(*out_profiler));
+
+  out_profiler->device = device;
+  out_profiler->epoch_ns = 0;
+  out_profiler->epoch_ns = profileNow(out_profiler);
+  out_profiler->gpu_timing = (GLAD_GL_VERSION_3_3 ||
+                              device->hasCapability(GLCap::ARB_timer_query)) &&
+                             glQueryCounter && glGetInteger64v;
+
+  if(out_profiler->gpu_timing)
+  {
+    profileSyncClocks(out_profiler);
+  }
+
+  device->markerCallback(profileMarker, out_profiler);
+}
+
+void
+destroyProfiler(Profiler *profiler)
+{
+  if(profiler->device->curr_marker_user == profiler)
+  {
+    profiler->device->markerCallback(nullptr, nullptr);
+  }
+
+  for(size_t i = profiler->first_unresolved; i < profiler->scope_count; ++i)
+  {
+    glDeleteQueries(2, profiler->scopes[i].queries);
+  }
+
+  if(profiler->free_query_count)
+  {
+    glDeleteQueries((GLsizei)profiler->free_query_count, profiler->free_queries);
+  }
+
+  #ifdef THIN_EXTRA_ERROR_CHECKS
+  profiler->device->getError("Destroy Profiler");
+  #endif
+
+  free(profiler->scopes);
+  free(profiler->frames);
+  free(profiler->names);
+  free(profiler->name_hashes);
+  free(profiler->name_offsets);
+  free(profiler->free_queries);
+
+  memset(profiler, 0, sizeof(*profiler));
+}
+
+void
+profileBeginFrame(Profiler *profiler)
+{
+  if(profiler->in_frame)
+  {
+    profileEndFrame(profiler);
+  }
+
+  if(profiler->gpu_timing)
+  {
+    profileSyncClocks(profiler);
+  }
+
+  profiler->in_frame = true;
+  profiler->frame_scope = (uint32_t)profiler->scope_count;
+  profiler->frame_depth = profiler->depth;
+  profiler->frame_start_stats = profiler->device->stats;
+
+  profilePush(profiler, "Frame");
+}
+
+void
+profileEndFrame(Profiler *profiler)
+{
+  if(!profiler->in_frame)
+  {
+    return;
+  }
+
+  // Anything left open inside the frame is closed with it.
+  const uint32_t frame_scope = profiler->frame_scope;
+
+  while(profiler->depth > profiler->frame_depth)
+  {
+    profilePop(profiler);
+  }
+
+  profileGrow(&profiler->frames,
+              &profiler->frame_capacity,
+              profiler->frame_count + 1,
+              64);
+
+  ProfileFrame *frame = &profiler->frames[profiler->frame_count++];
+  frame->cpu_begin_ns = profiler->scopes[frame_scope].cpu_begin_ns;
+  frame->cpu_end_ns = profiler->scopes[frame_scope].cpu_end_ns;
+  frame->stats = deviceStatsDelta(profiler->device->stats,
+                                  profiler->frame_start_stats);
+
+  profiler->in_frame = false;
+
+  profileResolve(profiler);
+}
+
+void
+profileResolve(Profiler *profiler, const bool wait)
+{
+  // Timestamps land in submission order, stop at the first one still out.
+  while(profiler->first_unresolved < profiler->scope_count)
+  {
+    ProfileScope *scope = &profiler->scopes[profiler->first_unresolved];
+
+    if(!scope->resolved)
+    {
+      if(!scope->queries[1])
+      {
+        break; // Still open.
+      }
+
+      if(!wait)
+      {
+        GLuint available = 0;
+        glGetQueryObjectuiv(scope->queries[1], GL_QUERY_RESULT_AVAILABLE, &available);
+
+        if(!available)
+        {
+          break;
+        }
+      }
+
+      GLuint64 gpu_begin = 0;
+      GLuint64 gpu_end = 0;
+      glGetQueryObjectui64v(scope->queries[0], GL_QUERY_RESULT, &gpu_begin);
+      glGetQueryObjectui64v(scope->queries[1], GL_QUERY_RESULT, &gpu_end);
+
+      scope->gpu_begin_ns = (uint64_t)((int64_t)gpu_begin + scope->gpu_offset_ns);
+      scope->gpu_end_ns = (uint64_t)((int64_t)gpu_end + scope->gpu_offset_ns);
+      scope->resolved = true;
+
+      profileFreeQuery(profiler, scope->queries[0]);
+      profileFreeQuery(profiler, scope->queries[1]);
+    }
+
+    profiler->first_unresolved += 1;
+  }
+
+  #ifdef THIN_EXTRA_ERROR_CHECKS
+  profiler->device->getError("Profile Resolve");
+  #endif
+}
+
+void
+profileReset(Profiler *profiler)
+{
+  // Open scopes and ones waiting on the GPU are kept at the front.
+  size_t keep_from = profiler->first_unresolved;
+
+  if(profiler->depth && profiler->stack[0] < keep_from)
+  {
+    keep_from = profiler->stack[0];
+  }
+
+  const size_t kept = profiler->scope_count - keep_from;
+
+  memmove(profiler->scopes,
+          profiler->scopes + keep_from,
+          kept * sizeof(ProfileScope));
+
+  for(uint32_t i = 0; i < profiler->depth && i < THIN_PROFILE_MAX_DEPTH; ++i)
+  {
+    profiler->stack[i] -= (uint32_t)keep_from;
+  }
+
+  profiler->frame_scope -= profiler->in_frame ? (uint32_t)keep_from : 0;
+  profiler->scope_count = kept;
+  profiler->first_unresolved -= keep_from;
+  profiler->frame_count = 0;
+
+  for(size_t i = 0; i < kept; ++i)
+  {
+    profiler->scopes[i].frame = 0;
+  }
+}
+
+
+// ----------------------------------------------------------[ Chrome Trace ]--
+
+static void
+profileWriteString(FILE *file, const char *str)
+{
+  fputc('"', file);
+
+  for(; *str; ++str)
+  {
+    const unsigned char c = (unsigned char)*str;
+
+    if(c == '"' || c == '\\')
+    {
+      fputc('\\', file);
+      fputc(c, file);
+    }
+    else if(c < 0x20)
+    {
+      fprintf(file, "\\u%04x", c);
+    }
+    else
+    {
+      fputc(c, file);
+    }
+  }
+
+  fputc('"', file);
+}
+
+static void
+profileWriteEvent(FILE *file,
+                  const char *name,
+                  const char *cat,
+                  const int tid,
+                  const uint64_t begin_ns,
+                  const uint64_t end_ns,
+                  const bool instant)
+{
+  fprintf(file, ",\n{\"name\":");
+  profileWriteString(file, name);
+
+  // Timestamps are microseconds.
+  if(instant)
+  {
+    fprintf(file, ",\"cat\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%d,\"ts\":%.3f}",
+            cat, tid, (double)begin_ns / 1000.);
+  }
+  else
+  {
+    fprintf(file, ",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+            cat, tid, (double)begin_ns / 1000., (double)(end_ns - begin_ns) / 1000.);
+  }
+}
+
+bool
+writeChromeTrace(Profiler *profiler, const char *path)
+{
+  FILE *file = fopen(path, "w");
+
+  if(!file)
+  {
+    return false;
+  }
+
+  profileResolve(profiler, true);
+
+  // Pids and tids are only labels, CPU is tid 1 and GPU tid 2.
+  fprintf(file,
+          "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+          "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"thin\"}},\n"
+          "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"CPU\"}},\n"
+          "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"GPU\"}}");
+
+  for(size_t i = 0; i < profiler->first_unresolved; ++i)
+  {
+    const ProfileScope &scope = profiler->scopes[i];
+    const char *name = profiler->names + scope.name;
+
+    profileWriteEvent(file, name, "cpu", 1,
+                      scope.cpu_begin_ns, scope.cpu_end_ns, scope.instant);
+
+    if(scope.queries[0])
+    {
+      profileWriteEvent(file, name, "gpu", 2,
+                        scope.gpu_begin_ns, scope.gpu_end_ns, false);
+    }
+  }
+
+  // One counter track per stat, stepped at each frame start.
+  for(size_t i = 0; i < profiler->frame_count; ++i)
+  {
+    const ProfileFrame &frame = profiler->frames[i];
+    const double ts = (double)frame.cpu_begin_ns / 1000.;
+
+    #define THIN_PROFILE_COUNTER(name)                                        \
+      fprintf(file,                                                           \
+              ",\n{\"name\":\"" #name "\",\"ph\":\"C\",\"pid\":1,"            \
+              "\"ts\":%.3f,\"args\":{\"" #name "\":%llu}}",                   \
+              ts, (unsigned long long)frame.stats.name);
+
+    THIN_DEVICE_STATS(THIN_PROFILE_COUNTER)
+    #undef THIN_PROFILE_COUNTER
+  }
+
+  fprintf(file, "\n]}\n");
+
+  const bool ok = !ferror(file);
+  fclose(file);
+
+  return ok;
+}
+
+
+#endif // impl guard
@@ -0,0 +1,942 @@
+#ifndef THIN_OGL_REPLAY_INCLUDED_
+#define THIN_OGL_REPLAY_INCLUDED_
+
+
+/*
+  Plays back traces written by glTraceBegin through the glad pointers. Object
+  names, uniform and attrib locations in the trace are mapped onto the ones
+  the live context hands out, so a capture replays on any driver.
+
+  Queries (glGet*, glIs*) and buffer mapping are skipped, whatever was read
+  through them isn't in the trace. Writes through a mapping were recorded as
+  a glBufferSubData and play as one.
+*/
+
+
+#include "ogl_device.hpp"
+
+
+// -----------------------------------------------------------------[ Trace ]--
+
+struct ReplayTrace
+{
+  uint8_t   *data;
+  size_t    size;
+  size_t    *records;         // Byte offset of each record.
+  size_t    record_count;
+  size_t    *frame_markers;   // Record index of each glTraceFrame.
+  size_t    frame_count;
+};
+
+struct ReplayCall
+{
+  const GLTraceRecord *record;
+  const uint64_t      *args;
+  const uint64_t      *ret;     // nullptr if the call returns nothing.
+  const void          *payload; // nullptr if nothing was copied.
+};
+
+bool
+loadTrace(const char *path, ReplayTrace *out_trace);
+
+void
+unloadTrace(ReplayTrace *trace);
+
+ReplayCall
+traceCall(const ReplayTrace &trace, const size_t index);
+
+/*
+  Record range of a frame, first inclusive, last exclusive, the marker itself
+  is not part of it.
+*/
+void
+traceFrameRange(const ReplayTrace &trace,
+                const size_t frame,
+                size_t *out_first,
+                size_t *out_last);
+
+// --------------------------------------------------------------[ Replayer ]--
+
+enum class ReplayNameKind : uint8_t
+{
+  buffer,
+  texture,
+  vertex_array,
+  framebuffer,
+  renderbuffer,
+  sampler,
+  query,
+  transform_feedback,
+  shader,
+  program,
+  sync,
+  uniform,          // Keyed on program and location.
+  attrib,           // Same, see replayAttrib.
+
+  count
+};
+
+enum class ReplayAction : uint8_t
+{
+  play,
+  skip,
+};
+
+/*
+  Called before each record plays, can skip it or swap the function for
+  another with the same signature (see replaySameSignature) for A/B runs.
+*/
+using replay_filter_fn = ReplayAction(*)(void *user,
+                                         const size_t index,
+                                         GLFunctionID *id);
+
+struct ReplayNameMap
+{
+  uint64_t  *keys;
+  uint64_t  *values;
+  size_t    capacity;
+  size_t    count;
+};
+
+struct Replayer
+{
+  ReplayNameMap     names[(size_t)ReplayNameKind::count];
+  uint64_t          program;        // Recorded name of the bound program.
+  uint64_t          attrib_program; // Of the last glGetAttribLocation.
+  replay_filter_fn  filter;
+  void              *filter_user;
+  uint64_t          calls;          // GL calls issued so far.
+};
+
+void
+createReplayer(Replayer *out_replayer,
+               const replay_filter_fn filter = nullptr,
+               void *filter_user = nullptr);
+
+void
+destroyReplayer(Replayer *replayer);
+
+/*
+  Plays records first to last (exclusive), returns the GL calls issued.
+*/
+size_t
+replayRecords(Replayer *replayer,
+              const ReplayTrace &trace,
+              const size_t first,
+              const size_t last);
+
+size_t
+replayFrame(Replayer *replayer, const ReplayTrace &trace, const size_t frame);
+
+bool
+replaySameSignature(const GLFunctionID a, const GLFunctionID b);
+
+GLFunctionID
+replayFunctionID(const char *name);
+
+
+#endif // inc guard
+
+
+#if defined(THIN_REPLAY_IMPL) && !defined(THIN_REPLAY_IMPL_INCLUDED_)
+#define THIN_REPLAY_IMPL_INCLUDED_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <type_traits>
+#include <utility>
+
+
+// -------------------------------------------------------------[ Invokers ]--
+
+template<typename T>
+struct GLReplayArg
+{
+  static T from(const uint64_t value) { return (T)value; }
+  static uint64_t to(const T value) { return (uint64_t)value; }
+};
+
+template<typename T>
+struct GLReplayArg<T*>
+{
+  static T *from(const uint64_t value) { return (T*)(uintptr_t)value; }
+  static uint64_t to(T *ptr) { return (uint64_t)(uintptr_t)ptr; }
+};
+
+template<>
+struct GLReplayArg<float>
+{
+  static float from(const uint64_t value)
+  {
+    const uint32_t bits = (uint32_t)value;
+    float result = 0.f;
+    memcpy(&result, &bits, sizeof(result));
+
+    return result;
+  }
+};
+
+template<>
+struct GLReplayArg<double>
+{
+  static double from(const uint64_t value)
+  {
+    double result = 0.;
+    memcpy(&result, &value, sizeof(result));
+
+    return result;
+  }
+};
+
+template<typename ...Args>
+static constexpr size_t
+glReplayLastPointer()
+{
+  // The trace copies what a call reads through a pointer, which is always
+  // the last pointer argument for the calls that get a payload.
+  const bool pointers[] = {std::is_pointer<Args>::value..., false};
+  size_t last = sizeof...(Args);
+
+  for(size_t i = 0; i < sizeof...(Args); ++i)
+  {
+    last = pointers[i] ? i : last;
+  }
+
+  return last;
+}
+
+using replay_invoke_fn = uint64_t(*)(void *fn, const uint64_t *args, const void *payload);
+
+template<typename fn_type>
+struct GLReplayStub;
+
+template<typename R, typename ...Args>
+struct GLReplayStub<R(APIENTRYP)(Args...)>
+{
+  template<size_t ...I>
+  static uint64_t
+  call(void *fn, const uint64_t *args, const void *payload, std::index_sequence<I...>)
+  {
+    using fn_type = R(APIENTRYP)(Args...);
+    constexpr size_t last_pointer = glReplayLastPointer<Args...>();
+
+    return GLReplayArg<R>::to(((fn_type)fn)(
+      GLReplayArg<Args>::from(I == last_pointer && payload && args[I] ?
+                              (uint64_t)(uintptr_t)payload :
+                              args[I])...));
+  }
+
+  static uint64_t
+  invoke(void *fn, const uint64_t *args, const void *payload)
+  {
+    return call(fn, args, payload, std::index_sequence_for<Args...>());
+  }
+};
+
+template<typename ...Args>
+struct GLReplayStub<void(APIENTRYP)(Args...)>
+{
+  template<size_t ...I>
+  static uint64_t
+  call(void *fn, const uint64_t *args, const void *payload, std::index_sequence<I...>)
+  {
+    using fn_type = void(APIENTRYP)(Args...);
+    constexpr size_t last_pointer = glReplayLastPointer<Args...>();
+
+    ((fn_type)fn)(
+      GLReplayArg<Args>::from(I == last_pointer && payload && args[I] ?
+                              (uint64_t)(uintptr_t)payload :
+                              args[I])...);
+
+    return 0;
+  }
+
+  static uint64_t
+  invoke(void *fn, const uint64_t *args, const void *payload)
+  {
+    return call(fn, args, payload, std::index_sequence_for<Args...>());
+  }
+};
+
+static void ** const gl_replay_slots[] = {
+  #define THIN_GL_FUNCTION(name) (void**)&glad_##name,
+  #include "glad_functions.inl"
+  #undef THIN_GL_FUNCTION
+
+  #define THIN_GL_EXTRA(name, ptr) (void**)&ptr,
+  THIN_GL_EXTRA_FUNCTIONS(THIN_GL_EXTRA)
+  #undef THIN_GL_EXTRA
+};
+
+// One per signature, two ids share an invoker only if their types match.
+static const replay_invoke_fn gl_replay_invokers[] = {
+  #define THIN_GL_FUNCTION(name) &GLReplayStub<decltype(glad_##name)>::invoke,
+  #include "glad_functions.inl"
+  #undef THIN_GL_FUNCTION
+
+  #define THIN_GL_EXTRA(name, ptr) &GLReplayStub<decltype(ptr)>::invoke,
+  THIN_GL_EXTRA_FUNCTIONS(THIN_GL_EXTRA)
+  #undef THIN_GL_EXTRA
+};
+
+
+// ----------------------------------------------------------[ Replay Tables ]--
+
+/*
+  Which arguments carry object names, per function. Anything not listed (or
+  a name the trace never created) is passed through unchanged.
+*/
+#define THIN_REPLAY_NAMES(X)                                \
+  X(glBindBuffer, 1, buffer)                                \
+  X(glBindBufferBase, 2, buffer)                            \
+  X(glBindBufferRange, 2, buffer)                           \
+  X(glBindTexture, 1, texture)                              \
+  X(glBindVertexArray, 0, vertex_array)                     \
+  X(glBindFramebuffer, 1, framebuffer)                      \
+  X(glBindRenderbuffer, 1, renderbuffer)                    \
+  X(glFramebufferTexture, 2, texture)                       \
+  X(glFramebufferTexture2D, 3, texture)                     \
+  X(glFramebufferTextureLayer, 2, texture)                  \
+  X(glFramebufferRenderbuffer, 3, renderbuffer)             \
+  X(glBindSampler, 1, sampler)                              \
+  X(glSamplerParameteri, 0, sampler)                        \
+  X(glSamplerParameterf, 0, sampler)                        \
+  X(glSamplerParameteriv, 0, sampler)                       \
+  X(glSamplerParameterfv, 0, sampler)                       \
+  X(glBeginQuery, 1, query)                                 \
+  X(glQueryCounter, 0, query)                               \
+  X(glBindTransformFeedback, 1, transform_feedback)         \
+  X(glShaderSource, 0, shader)                              \
+  X(glCompileShader, 0, shader)                             \
+  X(glDeleteShader, 0, shader)                              \
+  X(glAttachShader, 0, program)                             \
+  X(glAttachShader, 1, shader)                              \
+  X(glDetachShader, 0, program)                             \
+  X(glDetachShader, 1, shader)                              \
+  X(glLinkProgram, 0, program)                              \
+  X(glUseProgram, 0, program)                               \
+  X(glDeleteProgram, 0, program)                            \
+  X(glBindAttribLocation, 0, program)                       \
+  X(glBindFragDataLocation, 0, program)                     \
+  X(glUniformBlockBinding, 0, program)                      \
+  X(glGetUniformLocation, 0, program)                       \
+  X(glGetAttribLocation, 0, program)                        \
+  X(glVertexAttribPointer, 0, attrib)                       \
+  X(glVertexAttribIPointer, 0, attrib)                      \
+  X(glVertexAttribDivisor, 0, attrib)                       \
+  X(glEnableVertexAttribArray, 0, attrib)                   \
+  X(glDisableVertexAttribArray, 0, attrib)                  \
+  X(glWaitSync, 0, sync)                                    \
+  X(glClientWaitSync, 0, sync)                              \
+  X(glDeleteSync, 0, sync)
+
+#define THIN_REPLAY_GEN(X)                                  \
+  X(glGenBuffers, glDeleteBuffers, buffer)                  \
+  X(glGenTextures, glDeleteTextures, texture)               \
+  X(glGenVertexArrays, glDeleteVertexArrays, vertex_array)  \
+  X(glGenFramebuffers, glDeleteFramebuffers, framebuffer)   \
+  X(glGenRenderbuffers, glDeleteRenderbuffers, renderbuffer)\
+  X(glGenSamplers, glDeleteSamplers, sampler)               \
+  X(glGenQueries, glDeleteQueries, query)                   \
+  X(glGenTransformFeedbacks, glDeleteTransformFeedbacks, transform_feedback)
+
+namespace {
+
+constexpr size_t replay_max_remaps = 2;
+
+struct ReplayOp
+{
+  uint8_t skip;
+  uint8_t uniform;          // Location in arg 0, mapped on the bound program.
+  uint8_t gen;              // 1 for glGen*, 2 for glDelete*.
+  uint8_t gen_kind;
+  uint8_t remap_count;
+  uint8_t remap_arg[replay_max_remaps];
+  uint8_t remap_kind[replay_max_remaps];
+};
+
+} // anon ns
+
+static ReplayOp gl_replay_ops[gl_id_count];
+static bool gl_replay_ops_built = false;
+
+static void
+replayBuildOps()
+{
+  if(gl_replay_ops_built)
+  {
+    return;
+  }
+
+  memset(gl_replay_ops, 0, sizeof(gl_replay_ops));
+
+  for(size_t i = 0; i < gl_id_count; ++i)
+  {
+    const char *name = glFunctionName((GLFunctionID)i);
+    ReplayOp &op = gl_replay_ops[i];
+
+    // Reads back into memory that doesn't exist any more.
+    op.skip = strncmp(name, "glGet", 5) == 0 ||
+              strncmp(name, "glIs", 4) == 0 ||
+              strncmp(name, "glMap", 5) == 0 ||
+              strncmp(name, "glDebugMessage", 14) == 0;
+
+    op.uniform = strncmp(name, "glUniform", 9) == 0 &&
+                 ((name[9] >= '1' && name[9] <= '4') || strncmp(name + 9, "Matrix", 6) == 0);
+  }
+
+  const GLFunctionID playable[] = {
+    gl_id_glGetUniformLocation,
+    gl_id_glGetAttribLocation,
+  };
+
+  for(const GLFunctionID id : playable)
+  {
+    gl_replay_ops[id].skip = 0;
+  }
+
+  gl_replay_ops[gl_id_glReadPixels].skip = 1;
+  gl_replay_ops[gl_id_glUnmapBuffer].skip = 1;
+  gl_replay_ops[gl_id_glFlushMappedBufferRange].skip = 1;
+
+  #define THIN_REPLAY_NAME(fn, arg, kind)                                     \
+    {                                                                         \
+      ReplayOp &op = gl_replay_ops[gl_id_##fn];                               \
+      op.remap_arg[op.remap_count] = arg;                                     \
+      op.remap_kind[op.remap_count++] = (uint8_t)ReplayNameKind::kind;        \
+    }
+
+  THIN_REPLAY_NAMES(THIN_REPLAY_NAME)
+
+  #undef THIN_REPLAY_NAME
+
+  #define THIN_REPLAY_GEN_OP(gen_fn, del_fn, kind)                            \
+    gl_replay_ops[gl_id_##gen_fn].gen = 1;                                    \
+    gl_replay_ops[gl_id_##gen_fn].gen_kind = (uint8_t)ReplayNameKind::kind;   \
+    gl_replay_ops[gl_id_##del_fn].gen = 2;                                    \
+    gl_replay_ops[gl_id_##del_fn].gen_kind = (uint8_t)ReplayNameKind::kind;
+
+  THIN_REPLAY_GEN(THIN_REPLAY_GEN_OP)
+
+  #undef THIN_REPLAY_GEN_OP
+
+  gl_replay_ops_built = true;
+}
+
+
+// -------------------------------------------------------------[ Name Maps ]--
+
+static inline uint64_t
+replayNameKey(const uint64_t name)
+{
+  // Zero marks an empty slot, GL never hands out name 0.
+  return name ? name : ~(uint64_t)0;
+}
+
+static void
+replayNameInsert(ReplayNameMap &map, const uint64_t name, const uint64_t value)
+{
+  if((map.count + 1) * 2 > map.capacity)
+  {
+    ReplayNameMap grown;
+    grown.capacity = map.capacity ? map.capacity * 2 : 64;
+    grown.count = 0;
+    grown.keys = (uint64_t*)calloc(grown.capacity, sizeof(uint64_t));
+    grown.values = (uint64_t*)malloc(grown.capacity * sizeof(uint64_t));
+
+    for(size_t i = 0; i < map.capacity; ++i)
+    {
+      if(map.keys[i])
+      {
+        replayNameInsert(grown, map.keys[i], map.values[i]);
+      }
+    }
+
+    free(map.keys);
+    free(map.values);
+    map = grown;
+  }
+
+  const uint64_t key = replayNameKey(name);
+  const size_t mask = map.capacity - 1;
+  size_t slot = thinHashCombine(thin_hash_seed, key) & mask;
+
+  while(map.keys[slot] && map.keys[slot] != key)
+  {
+    slot = (slot + 1) & mask;
+  }
+
+  map.count += map.keys[slot] ? 0 : 1;
+  map.keys[slot] = key;
+  map.values[slot] = value;
+}
+
+static bool
+replayNameFind(const ReplayNameMap &map, const uint64_t name, uint64_t *out_value)
+{
+  if(!map.capacity)
+  {
+    return false;
+  }
+
+  const uint64_t key = replayNameKey(name);
+  const size_t mask = map.capacity - 1;
+  size_t slot = thinHashCombine(thin_hash_seed, key) & mask;
+
+  while(map.keys[slot])
+  {
+    if(map.keys[slot] == key)
+    {
+      *out_value = map.values[slot];
+      return true;
+    }
+
+    slot = (slot + 1) & mask;
+  }
+
+  return false;
+}
+
+static inline uint64_t
+replayName(const Replayer *replayer, const ReplayNameKind kind, const uint64_t name)
+{
+  uint64_t live = name;
+  replayNameFind(replayer->names[(size_t)kind], name, &live);
+
+  return live;
+}
+
+static inline uint64_t
+replayUniformKey(const uint64_t program, const uint64_t location)
+{
+  return (program << 32) | (uint32_t)location;
+}
+
+static uint64_t
+replayAttrib(const Replayer *replayer, const uint64_t location)
+{
+  // Attrib calls name no program. Layouts are usually set up with the
+  // program they were queried on bound, or right after querying it.
+  const ReplayNameMap &map = replayer->names[(size_t)ReplayNameKind::attrib];
+  uint64_t live = location;
+
+  if(!replayNameFind(map, replayUniformKey(replayer->program, location), &live))
+  {
+    replayNameFind(map, replayUniformKey(replayer->attrib_program, location), &live);
+  }
+
+  return live;
+}
+
+
+// -----------------------------------------------------------------[ Trace ]--
+
+bool
+loadTrace(const char *path, ReplayTrace *out_trace)
+{
+  memset(out_trace, 0, sizeof(*out_trace));
+
+  FILE *file = fopen(path, "rb");
+
+  if(!file)
+  {
+    return false;
+  }
+
+  fseek(file, 0, SEEK_END);
+  const long size = ftell(file);
+  fseek(file, 0, SEEK_SET);
+
+  uint8_t *data = size > 0 ? (uint8_t*)malloc(size) : nullptr;
+  const bool read = data && fread(data, 1, size, file) == (size_t)size;
+
+  fclose(file);
+
+  GLTraceFileHeader header;
+
+  if(!read || (size_t)size < sizeof(header))
+  {
+    free(data);
+    return false;
+  }
+
+  memcpy(&header, data, sizeof(header));
+
+  if(header.magic != gl_trace_magic ||
+     header.version != gl_trace_version ||
+     header.function_count != gl_id_count)
+  {
+    free(data);
+    return false;
+  }
+
+  // Two passes, count then index.
+  size_t record_count = 0;
+  size_t frame_count = 0;
+
+  for(int pass = 0; pass < 2; ++pass)
+  {
+    size_t at = sizeof(header);
+    size_t record = 0;
+    size_t frame = 0;
+
+    while(at + sizeof(GLTraceRecord) <= (size_t)size)
+    {
+      GLTraceRecord rec;
+      memcpy(&rec, data + at, sizeof(rec));
+
+      const size_t bytes = sizeof(rec) +
+                           (rec.arg_count + (rec.flags & gl_trace_has_return ? 1 : 0)) * sizeof(uint64_t) +
+                           ((rec.payload_size + 7) & ~(size_t)7);
+
+      if(at + bytes > (size_t)size)
+      {
+        // Truncated capture, keep what is complete.
+        break;
+      }
+
+      if(pass == 1)
+      {
+        out_trace->records[record] = at;
+
+        if(rec.id == gl_trace_frame)
+        {
+          out_trace->frame_markers[frame] = record;
+        }
+      }
+
+      record += 1;
+      frame += rec.id == gl_trace_frame;
+      at += bytes;
+    }
+
+    if(pass == 0)
+    {
+      record_count = record;
+      frame_count = frame;
+
+      out_trace->records = (size_t*)malloc((record_count + 1) * sizeof(size_t));
+      out_trace->frame_markers = (size_t*)malloc((frame_count + 1) * sizeof(size_t));
+    }
+  }
+
+  out_trace->data = data;
+  out_trace->size = size;
+  out_trace->record_count = record_count;
+  out_trace->frame_count = frame_count;
+
+  return true;
+}
+
+void
+unloadTrace(ReplayTrace *trace)
+{
+  free(trace->data);
+  free(trace->records);
+  free(trace->frame_markers);
+
+  memset(trace, 0, sizeof(*trace));
+}
+
+ReplayCall
+traceCall(const ReplayTrace &trace, const size_t index)
+{
+  const uint8_t *at = trace.data + trace.records[index];
+
+  ReplayCall call;
+  call.record = (const GLTraceRecord*)at;
+  call.args = (const uint64_t*)(at + sizeof(GLTraceRecord));
+  call.ret = call.record->flags & gl_trace_has_return ?
+    call.args + call.record->arg_count :
+    nullptr;
+  call.payload = call.record->payload_size ?
+    (const void*)(call.args + call.record->arg_count + (call.ret ? 1 : 0)) :
+    nullptr;
+
+  return call;
+}
+
+void
+traceFrameRange(const ReplayTrace &trace,
+                const size_t frame,
+                size_t *out_first,
+                size_t *out_last)
+{
+  *out_first = frame ? trace.frame_markers[frame - 1] + 1 : 0;
+  *out_last = frame < trace.frame_count ?
+    trace.frame_markers[frame] :
+    trace.record_count;
+}
+
+
+// --------------------------------------------------------------[ Replayer ]--
+
+void
+createReplayer(Replayer *out_replayer,
+               const replay_filter_fn filter,
+               void *filter_user)
+{
+  replayBuildOps();
+
+  memset(out_replayer, 0, sizeof(*out_replayer));
+  out_replayer->filter = filter;
+  out_replayer->filter_user = filter_user;
+}
+
+void
+destroyReplayer(Replayer *replayer)
+{
+  for(ReplayNameMap &map : replayer->names)
+  {
+    free(map.keys);
+    free(map.values);
+  }
+
+  memset(replayer, 0, sizeof(*replayer));
+}
+
+static void
+replayGenNames(Replayer *replayer,
+               const ReplayCall &call,
+               const GLFunctionID id,
+               void *fn)
+{
+  const ReplayOp &op = gl_replay_ops[id];
+  ReplayNameMap &map = replayer->names[op.gen_kind];
+
+  const GLsizei n = (GLsizei)call.args[0];
+  const GLuint *recorded = (const GLuint*)call.payload;
+
+  if(n <= 0 || !recorded)
+  {
+    return;
+  }
+
+  GLuint *live = (GLuint*)malloc(n * sizeof(GLuint));
+
+  if(op.gen == 1)
+  {
+    ((PFNGLGENBUFFERSPROC)fn)(n, live);
+
+    for(GLsizei i = 0; i < n; ++i)
+    {
+      replayNameInsert(map, recorded[i], live[i]);
+    }
+  }
+  else
+  {
+    for(GLsizei i = 0; i < n; ++i)
+    {
+      live[i] = (GLuint)replayName(replayer, (ReplayNameKind)op.gen_kind, recorded[i]);
+    }
+
+    ((PFNGLDELETEBUFFERSPROC)fn)(n, live);
+  }
+
+  free(live);
+}
+
+static void
+replayShaderSource(Replayer *replayer, const ReplayCall &call, void *fn)
+{
+  const GLuint shader = (GLuint)replayName(replayer, ReplayNameKind::shader, call.args[0]);
+  const GLsizei count = (GLsizei)call.args[1];
+
+  const GLchar **strings = (const GLchar**)malloc((count ? count : 1) * sizeof(GLchar*));
+  const GLchar *at = (const GLchar*)call.payload;
+
+  for(GLsizei i = 0; i < count; ++i)
+  {
+    strings[i] = at;
+    at += strlen(at) + 1;
+  }
+
+  ((PFNGLSHADERSOURCEPROC)fn)(shader, count, strings, nullptr);
+
+  free(strings);
+}
+
+static void
+replayBindTextures(Replayer *replayer, const ReplayCall &call, void *fn)
+{
+  const GLuint first = (GLuint)call.args[0];
+  const GLsizei count = (GLsizei)call.args[1];
+  const GLuint *recorded = (const GLuint*)call.payload;
+
+  if(count <= 0 || !recorded)
+  {
+    ((thin_bind_textures_fn)fn)(first, count, nullptr);
+    return;
+  }
+
+  GLuint *live = (GLuint*)malloc(count * sizeof(GLuint));
+
+  for(GLsizei i = 0; i < count; ++i)
+  {
+    live[i] = (GLuint)replayName(replayer, ReplayNameKind::texture, recorded[i]);
+  }
+
+  ((thin_bind_textures_fn)fn)(first, count, live);
+
+  free(live);
+}
+
+size_t
+replayRecords(Replayer *replayer,
+              const ReplayTrace &trace,
+              const size_t first,
+              const size_t last)
+{
+  const size_t start_calls = replayer->calls;
+
+  for(size_t i = first; i < last && i < trace.record_count; ++i)
+  {
+    const ReplayCall call = traceCall(trace, i);
+    GLFunctionID id = (GLFunctionID)call.record->id;
+
+    if(id >= gl_id_count)
+    {
+      continue;
+    }
+
+    if(replayer->filter &&
+       replayer->filter(replayer->filter_user, i, &id) == ReplayAction::skip)
+    {
+      continue;
+    }
+
+    const ReplayOp &op = gl_replay_ops[id];
+    void *fn = *gl_replay_slots[id];
+
+    if(op.skip || !fn)
+    {
+      continue;
+    }
+
+    replayer->calls += 1;
+
+    if(op.gen)
+    {
+      replayGenNames(replayer, call, id, fn);
+      continue;
+    }
+
+    if(id == gl_id_glShaderSource)
+    {
+      replayShaderSource(replayer, call, fn);
+      continue;
+    }
+
+    if(id == gl_id_glBindTextures)
+    {
+      replayBindTextures(replayer, call, fn);
+      continue;
+    }
+
+    uint64_t args[32];
+    const size_t arg_count = call.record->arg_count < 32 ? call.record->arg_count : 32;
+
+    memcpy(args, call.args, arg_count * sizeof(uint64_t));
+
+    for(size_t r = 0; r < op.remap_count; ++r)
+    {
+      const ReplayNameKind kind = (ReplayNameKind)op.remap_kind[r];
+      uint64_t &arg = args[op.remap_arg[r]];
+
+      arg = kind == ReplayNameKind::attrib ?
+        replayAttrib(replayer, arg) :
+        replayName(replayer, kind, arg);
+    }
+
+    if(op.uniform)
+    {
+      const uint64_t key = replayUniformKey(replayer->program, call.args[0]);
+      args[0] = replayName(replayer, ReplayNameKind::uniform, key);
+
+      // Unmapped, the location wasn't queried in the trace, use it as is.
+      args[0] = args[0] == key ? call.args[0] : args[0];
+    }
+
+    if(id == gl_id_glUseProgram)
+    {
+      replayer->program = call.args[0];
+    }
+
+    const uint64_t ret = gl_replay_invokers[id](fn, args, call.payload);
+
+    if(!call.ret)
+    {
+      continue;
+    }
+
+    // Outputs the trace refers to later.
+    switch(id)
+    {
+      case gl_id_glCreateShader:
+        replayNameInsert(replayer->names[(size_t)ReplayNameKind::shader], *call.ret, ret);
+        break;
+
+      case gl_id_glCreateProgram:
+        replayNameInsert(replayer->names[(size_t)ReplayNameKind::program], *call.ret, ret);
+        break;
+
+      case gl_id_glFenceSync:
+        replayNameInsert(replayer->names[(size_t)ReplayNameKind::sync], *call.ret, ret);
+        break;
+
+      case gl_id_glGetUniformLocation:
+        replayNameInsert(replayer->names[(size_t)ReplayNameKind::uniform],
+                         replayUniformKey(call.args[0], *call.ret),
+                         ret);
+        break;
+
+      case gl_id_glGetAttribLocation:
+        replayNameInsert(replayer->names[(size_t)ReplayNameKind::attrib],
+                         replayUniformKey(call.args[0], *call.ret),
+                         ret);
+        replayer->attrib_program = call.args[0];
+        break;
+
+      default:
+        break;
+    }
+  }
+
+  return replayer->calls - start_calls;
+}
+
+size_t
+replayFrame(Replayer *replayer, const ReplayTrace &trace, const size_t frame)
+{
+  size_t first = 0;
+  size_t last = 0;
+  traceFrameRange(trace, frame, &first, &last);
+
+  return replayRecords(replayer, trace, first, last);
+}
+
+bool
+replaySameSignature(const GLFunctionID a, const GLFunctionID b)
+{
+  return a < gl_id_count && b < gl_id_count &&
+         gl_replay_invokers[a] == gl_replay_invokers[b];
+}
+
+GLFunctionID
+replayFunctionID(const char *name)
+{
+  for(size_t i = 0; i < gl_id_count; ++i)
+  {
+    if(strcmp(glFunctionName((GLFunctionID)i), name) == 0)
+    {
+      return (GLFunctionID)i;
+    }
+  }
+
+  return gl_id_count;
+}
+
+
+#endif // impl guard
@@ -0,0 +1,324 @@
+#ifndef THIN_OGL_TARGET_POOL_INCLUDED_
+#define THIN_OGL_TARGET_POOL_INCLUDED_
+
+
+/*
+  Intermediate render targets for passes that only need them for a while,
+  post processing chains and the like. A pass acquires a target by format,
+  size and samples, and gives it back with releaseRenderTarget once later
+  passes are done reading it, so the next pass asking for the same shape
+  reuses it in the same frame. renderTargetPoolEndFrame takes back the rest
+  and deletes targets nobody acquired for max_idle_frames.
+
+  Live bytes then follow the most targets alive at once rather than how
+  many passes ask for one. Contents are whatever the last user left, clear
+  or overwrite them. Targets plug straight into a FramebufferDesc and the
+  FBOs made over them stay cached for as long as the targets live.
+*/
+
+
+#include "ogl_device.hpp"
+
+
+// -----------------------------------------------------------[ Target Pool ]--
+
+struct RenderTargetDesc
+{
+  GLenum    internal_format;  // Sized, color or depth.
+  GLsizei   width;
+  GLsizei   height;
+  GLsizei   samples;          // Above zero is always a renderbuffer.
+  bool      renderbuffer;     // Never sampled, skips making a texture.
+};
+
+struct RenderTargetPoolStats
+{
+  size_t    bytes;                // Every target, acquired or idle.
+  size_t    peak_bytes;
+  size_t    acquired_bytes;
+  size_t    peak_acquired_bytes;  // Most that were in use at once.
+  uint32_t  target_count;
+  uint32_t  created;              // Since the pool was made.
+  uint32_t  deleted;
+};
+
+struct PooledRenderTarget
+{
+  RenderTargetDesc      desc;
+  FramebufferAttachment attachment;
+  size_t                bytes;
+  uint64_t              last_used_frame;
+  bool                  acquired;
+};
+
+struct RenderTargetPool
+{
+  Device                *device;
+  PooledRenderTarget    *targets;
+  size_t                target_count;
+  size_t                target_capacity;
+  uint32_t              max_idle_frames;
+  uint64_t              frame;
+  RenderTargetPoolStats stats;
+};
+
+/*
+  Targets left idle for more than max_idle_frames ends of frame are
+  deleted, zero deletes them at the first end of frame they sit out.
+*/
+void
+createRenderTargetPool(RenderTargetPool *out_pool, Device *device, const uint32_t max_idle_frames = 2);
+
+/*
+  Deletes every target, acquired or not.
+*/
+void
+destroyRenderTargetPool(RenderTargetPool *pool);
+
+/*
+  An idle target matching desc, made if there's none. The attachment has
+  a zero object when the target couldn't be made.
+*/
+FramebufferAttachment
+acquireRenderTarget(RenderTargetPool *pool, const RenderTargetDesc &desc);
+
+/*
+  Hands a target back before the end of the frame so later passes can
+  reuse it.
+*/
+void
+releaseRenderTarget(RenderTargetPool *pool, const FramebufferAttachment &target);
+
+/*
+  Releases whatever is still acquired and deletes targets that sat idle
+  too long.
+*/
+void
+renderTargetPoolEndFrame(RenderTargetPool *pool);
+
+
+#endif // inc guard
+
+
+#if defined(THIN_TARGET_POOL_IMPL) && !defined(THIN_TARGET_POOL_IMPL_INCLUDED_)
+#define THIN_TARGET_POOL_IMPL_INCLUDED_
+
+#include <stdlib.h>
+#include <string.h>
+
+
+// ----------------------------------------------------------[ Target Utils ]--
+
+static inline bool
+targetDescEqual(const RenderTargetDesc &a, const RenderTargetDesc &b)
+{
+  return a.internal_format == b.internal_format &&
+         a.width == b.width &&
+         a.height == b.height &&
+         a.samples == b.samples &&
+         a.renderbuffer == b.renderbuffer;
+}
+
+static bool
+targetCreate(RenderTargetPool *pool, const RenderTargetDesc &desc, PooledRenderTarget *out_target)
+{
+  Device *device = pool->device;
+  const bool renderbuffer = desc.renderbuffer || desc.samples > 0;
+  const MemoryType type = renderbuffer ? MemoryType::renderbuffer : MemoryType::texture;
+
+  // Device sizes it, whatever it counts is what the pool counts.
+  const size_t bytes_before = device->getMemoryUsage(type).bytes;
+
+  memset(out_target, 0, sizeof(PooledRenderTarget));
+  out_target->desc = desc;
+
+  if(renderbuffer)
+  {
+    out_target->attachment.type = AttachmentType::renderbuffer;
+    out_target->attachment.object = device->createRenderbuffer(desc.internal_format,
+                                                               desc.width,
+                                                               desc.height,
+                                                               desc.samples);
+  }
+  else
+  {
+    TextureDesc tex_desc = {};
+    tex_desc.internal_format = desc.internal_format;
+    tex_desc.width = desc.width;
+    tex_desc.height = desc.height;
+    tex_desc.mip_count = 1;
+    tex_desc.wrap_s = GL_CLAMP_TO_EDGE;
+    tex_desc.wrap_t = GL_CLAMP_TO_EDGE;
+    tex_desc.min_filter = GL_LINEAR;
+    tex_desc.mag_filter = GL_LINEAR;
+
+    out_target->attachment.type = AttachmentType::texture;
+    out_target->attachment.object = device->createTexture2D(tex_desc);
+  }
+
+  out_target->bytes = device->getMemoryUsage(type).bytes - bytes_before;
+
+  return out_target->attachment.object != 0;
+}
+
+static void
+targetDelete(RenderTargetPool *pool, const size_t index)
+{
+  PooledRenderTarget &target = pool->targets[index];
+
+  if(target.attachment.type == AttachmentType::renderbuffer)
+  {
+    pool->device->deleteRenderbuffers(1, &target.attachment.object);
+  }
+  else
+  {
+    pool->device->deleteTextures(1, &target.attachment.object);
+  }
+
+  pool->stats.bytes -= target.bytes;
+  pool->stats.target_count -= 1;
+  pool->stats.deleted += 1;
+
+  // Order doesn't matter, the last one fills the hole.
+  pool->targets[index] = pool->targets[pool->target_count - 1];
+  pool->target_count -= 1;
+}
+
+static void
+targetSetAcquired(RenderTargetPool *pool, PooledRenderTarget &target, const bool acquired)
+{
+  RenderTargetPoolStats &stats = pool->stats;
+
+  if(acquired)
+  {
+    stats.acquired_bytes += target.bytes;
+    stats.peak_acquired_bytes = stats.acquired_bytes > stats.peak_acquired_bytes ?
+                                stats.acquired_bytes : stats.peak_acquired_bytes;
+  }
+  else
+  {
+    stats.acquired_bytes -= target.bytes;
+  }
+
+  target.acquired = acquired;
+  target.last_used_frame = pool->frame;
+}
+
+
+// -----------------------------------------------------------[ Target Pool ]--
+
+void
+createRenderTargetPool(RenderTargetPool *out_pool, Device *device, const uint32_t max_idle_frames)
+{
+  memset(out_pool, 0, sizeof(RenderTargetPool));
+
+  out_pool->device = device;
+  out_pool->max_idle_frames = max_idle_frames;
+}
+
+void
+destroyRenderTargetPool(RenderTargetPool *pool)
+{
+  while(pool->target_count)
+  {
+    targetDelete(pool, pool->target_count - 1);
+  }
+
+  free(pool->targets);
+  memset(pool, 0, sizeof(RenderTargetPool));
+}
+
+FramebufferAttachment
+acquireRenderTarget(RenderTargetPool *pool, const RenderTargetDesc &desc)
+{
+  // Pools hold tens of targets, a scan beats keeping a table in step.
+  for(size_t i = 0; i < pool->target_count; ++i)
+  {
+    PooledRenderTarget &target = pool->targets[i];
+
+    if(!target.acquired && targetDescEqual(target.desc, desc))
+    {
+      targetSetAcquired(pool, target, true);
+      return target.attachment;
+    }
+  }
+
+  if(pool->target_count == pool->target_capacity)
+  {
+    pool->target_capacity = pool->target_capacity ? pool->target_capacity * 2 : 16;
+    pool->targets = (PooledRenderTarget*)realloc(pool->targets,
+                                                 pool->target_capacity * sizeof(PooledRenderTarget));
+  }
+
+  PooledRenderTarget &target = pool->targets[pool->target_count];
+
+  if(!targetCreate(pool, desc, &target))
+  {
+    return target.attachment;
+  }
+
+  pool->target_count += 1;
+  pool->stats.target_count += 1;
+  pool->stats.created += 1;
+  pool->stats.bytes += target.bytes;
+  pool->stats.peak_bytes = pool->stats.bytes > pool->stats.peak_bytes ?
+                           pool->stats.bytes : pool->stats.peak_bytes;
+
+  targetSetAcquired(pool, target, true);
+
+  return target.attachment;
+}
+
+void
+releaseRenderTarget(RenderTargetPool *pool, const FramebufferAttachment &attachment)
+{
+  for(size_t i = 0; i < pool->target_count; ++i)
+  {
+    PooledRenderTarget &target = pool->targets[i];
+
+    if(target.acquired &&
+       target.attachment.object == attachment.object &&
+       target.attachment.type == attachment.type)
+    {
+      targetSetAcquired(pool, target, false);
+      return;
+    }
+  }
+
+  #ifdef THIN_EXTRA_PARAM_CHECKS
+  if(pool->device->curr_error_callback)
+  {
+    pool->device->curr_error_callback("Releasing a render target the pool hasn't handed out");
+  }
+  #endif
+}
+
+void
+renderTargetPoolEndFrame(RenderTargetPool *pool)
+{
+  size_t i = 0;
+
+  while(i < pool->target_count)
+  {
+    PooledRenderTarget &target = pool->targets[i];
+
+    if(target.acquired)
+    {
+      targetSetAcquired(pool, target, false);
+    }
+
+    if(pool->frame - target.last_used_frame > pool->max_idle_frames)
+    {
+      // Swaps another target into i, so look at i again.
+      targetDelete(pool, i);
+      continue;
+    }
+
+    ++i;
+  }
+
+  pool->frame += 1;
+}
+
+
+#endif // impl guard
@@ -0,0 +1,612 @@
+#ifndef THIN_OGL_TEXTURE_FILE_INCLUDED_
+#define THIN_OGL_TEXTURE_FILE_INCLUDED_
+
+
+/*
+  Maps KTX (1 and 2) and DDS files holding BC1 to BC7 2D textures and hands
+  their levels to the driver straight out of the mapping, the pixels are
+  never decoded or copied on the CPU.
+
+  Arrays, cube maps, volumes, uncompressed formats and supercompressed KTX2
+  files are refused.
+*/
+
+
+#include "ogl_device.hpp"
+
+
+#ifndef THIN_TEXTURE_FILE_MAX_LEVELS
+#define THIN_TEXTURE_FILE_MAX_LEVELS 16
+#endif
+
+
+// ----------------------------------------------------------[ Texture File ]--
+
+struct TextureFile
+{
+  const uint8_t   *bytes;       // The whole file, read only.
+  size_t          size;
+  GLenum          internal_format;
+  GLsizei         width;
+  GLsizei         height;
+  GLsizei         mip_count;
+  CompressedLevel levels[THIN_TEXTURE_FILE_MAX_LEVELS];
+};
+
+/*
+  Maps and parses a file, levels point into the mapping until it's closed.
+  False and a zeroed file when it can't be read or isn't something we take.
+*/
+bool
+openTextureFile(TextureFile *out_file, const char *path);
+
+void
+closeTextureFile(TextureFile *file);
+
+/*
+  Same as openTextureFile over bytes already in memory, nothing is mapped
+  and closeTextureFile is not needed.
+*/
+bool
+parseTextureFile(TextureFile *out_file, const void *bytes, const size_t size);
+
+/*
+  Opens, uploads with Device::createCompressedTexture2D and closes. Zero
+  on failure.
+*/
+uintptr_t
+loadTextureFile(Device *device, const char *path);
+
+
+#endif // inc guard
+
+
+#if defined(THIN_TEXTURE_FILE_IMPL) && !defined(THIN_TEXTURE_FILE_IMPL_INCLUDED_)
+#define THIN_TEXTURE_FILE_IMPL_INCLUDED_
+
+#include <string.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+// -----------------------------------------------------------------[ Utils ]--
+
+static inline uint32_t
+textureFileU32(const uint8_t *bytes)
+{
+  uint32_t value;
+  memcpy(&value, bytes, sizeof(value));
+
+  return value;
+}
+
+static inline uint64_t
+textureFileU64(const uint8_t *bytes)
+{
+  uint64_t value;
+  memcpy(&value, bytes, sizeof(value));
+
+  return value;
+}
+
+static inline uint32_t
+textureFileFourCC(const char *code)
+{
+  return (uint32_t)code[0] | ((uint32_t)code[1] << 8) |
+         ((uint32_t)code[2] << 16) | ((uint32_t)code[3] << 24);
+}
+
+static size_t
+textureFileLevelSize(const GLenum internal_format, const GLsizei width, const GLsizei height)
+{
+  // BC1 and BC4 are 8 bytes a block, the rest 16.
+  size_t block_bytes = 16;
+
+  switch(internal_format)
+  {
+    case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+    case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+    case GL_COMPRESSED_SRGB_S3TC_DXT1_EXT:
+    case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT:
+    case GL_COMPRESSED_RED_RGTC1:
+    case GL_COMPRESSED_SIGNED_RED_RGTC1:
+      block_bytes = 8;
+      break;
+  }
+
+  return (size_t)((width + 3) / 4) * ((height + 3) / 4) * block_bytes;
+}
+
+static bool
+textureFileIsBC(const GLenum internal_format)
+{
+  switch(internal_format)
+  {
+    case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+    case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+    case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+    case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+    case GL_COMPRESSED_SRGB_S3TC_DXT1_EXT:
+    case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT:
+    case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT:
+    case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT:
+    case GL_COMPRESSED_RED_RGTC1:
+    case GL_COMPRESSED_SIGNED_RED_RGTC1:
+    case GL_COMPRESSED_RG_RGTC2:
+    case GL_COMPRESSED_SIGNED_RG_RGTC2:
+    case GL_COMPRESSED_RGBA_BPTC_UNORM:
+    case GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM:
+    case GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT:
+    case GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT:
+      return true;
+  }
+
+  return false;
+}
+
+/*
+  Levels packed back to back from offset. KTX1 puts a 4 byte size in front
+  of each, DDS doesn't.
+*/
+static bool
+textureFileSequentialLevels(TextureFile *file,
+                            size_t offset,
+                            const bool size_prefix)
+{
+  if(file->mip_count > THIN_TEXTURE_FILE_MAX_LEVELS)
+  {
+    return false;
+  }
+
+  for(GLsizei level = 0; level < file->mip_count; ++level)
+  {
+    const GLsizei w = file->width >> level ? file->width >> level : 1;
+    const GLsizei h = file->height >> level ? file->height >> level : 1;
+    const size_t size = textureFileLevelSize(file->internal_format, w, h);
+
+    if(size_prefix)
+    {
+      if(offset + 4 > file->size || textureFileU32(file->bytes + offset) != size)
+      {
+        return false;
+      }
+
+      offset += 4;
+    }
+
+    if(offset + size > file->size)
+    {
+      return false;
+    }
+
+    file->levels[level].data = file->bytes + offset;
+    file->levels[level].size = (GLsizei)size;
+
+    // KTX1 pads each level to 4, BC sizes already are.
+    offset += size;
+  }
+
+  return true;
+}
+
+
+// -------------------------------------------------------------------[ KTX ]--
+
+static bool
+textureFileParseKTX1(TextureFile *file)
+{
+  constexpr size_t header_size = 64;
+
+  if(file->size < header_size)
+  {
+    return false;
+  }
+
+  const uint8_t *header = file->bytes + 12;
+
+  const uint32_t endianness = textureFileU32(header + 0);
+  const uint32_t gl_type = textureFileU32(header + 4);
+  const uint32_t internal_format = textureFileU32(header + 16);
+  const uint32_t width = textureFileU32(header + 24);
+  const uint32_t height = textureFileU32(header + 28);
+  const uint32_t depth = textureFileU32(header + 32);
+  const uint32_t array_elements = textureFileU32(header + 36);
+  const uint32_t faces = textureFileU32(header + 40);
+  const uint32_t mip_count = textureFileU32(header + 44);
+  const uint32_t key_value_bytes = textureFileU32(header + 48);
+
+  // Written on a machine of the other endianness.
+  if(endianness != 0x04030201)
+  {
+    return false;
+  }
+
+  if(gl_type != 0 || depth > 1 || array_elements > 0 || faces != 1)
+  {
+    return false;
+  }
+
+  file->internal_format = internal_format;
+  file->width = (GLsizei)width;
+  file->height = (GLsizei)height;
+  file->mip_count = mip_count ? (GLsizei)mip_count : 1;
+
+  return textureFileSequentialLevels(file, header_size + key_value_bytes, true);
+}
+
+static GLenum
+textureFileVkFormat(const uint32_t vk_format)
+{
+  switch(vk_format)
+  {
+    case 131: return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+    case 132: return GL_COMPRESSED_SRGB_S3TC_DXT1_EXT;
+    case 133: return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+    case 134: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT;
+    case 135: return GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+    case 136: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT;
+    case 137: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    case 138: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+    case 139: return GL_COMPRESSED_RED_RGTC1;
+    case 140: return GL_COMPRESSED_SIGNED_RED_RGTC1;
+    case 141: return GL_COMPRESSED_RG_RGTC2;
+    case 142: return GL_COMPRESSED_SIGNED_RG_RGTC2;
+    case 143: return GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT;
+    case 144: return GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT;
+    case 145: return GL_COMPRESSED_RGBA_BPTC_UNORM;
+    case 146: return GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
+  }
+
+  return 0;
+}
+
+static bool
+textureFileParseKTX2(TextureFile *file)
+{
+  constexpr size_t header_size = 80;
+
+  if(file->size < header_size)
+  {
+    return false;
+  }
+
+  const uint8_t *header = file->bytes + 12;
+
+  const uint32_t vk_format = textureFileU32(header + 0);
+  const uint32_t width = textureFileU32(header + 8);
+  const uint32_t height = textureFileU32(header + 12);
+  const uint32_t depth = textureFileU32(header + 16);
+  const uint32_t layers = textureFileU32(header + 20);
+  const uint32_t faces = textureFileU32(header + 24);
+  const uint32_t mip_count = textureFileU32(header + 28);
+  const uint32_t supercompression = textureFileU32(header + 32);
+
+  if(depth > 1 || layers > 0 || faces != 1 || supercompression != 0)
+  {
+    return false;
+  }
+
+  file->internal_format = textureFileVkFormat(vk_format);
+  file->width = (GLsizei)width;
+  file->height = (GLsizei)height;
+  file->mip_count = mip_count ? (GLsizei)mip_count : 1;
+
+  if(file->mip_count > THIN_TEXTURE_FILE_MAX_LEVELS ||
+     header_size + file->mip_count * 24 > file->size)
+  {
+    return false;
+  }
+
+  // Level index, three u64 per level, offsets from the start of the file.
+  for(GLsizei level = 0; level < file->mip_count; ++level)
+  {
+    const uint8_t *entry = file->bytes + header_size + level * 24;
+    const uint64_t offset = textureFileU64(entry + 0);
+    const uint64_t size = textureFileU64(entry + 8);
+
+    const GLsizei w = file->width >> level ? file->width >> level : 1;
+    const GLsizei h = file->height >> level ? file->height >> level : 1;
+
+    if(size != textureFileLevelSize(file->internal_format, w, h) ||
+       offset > file->size || size > file->size - offset)
+    {
+      return false;
+    }
+
+    file->levels[level].data = file->bytes + offset;
+    file->levels[level].size = (GLsizei)size;
+  }
+
+  return true;
+}
+
+
+// -------------------------------------------------------------------[ DDS ]--
+
+static GLenum
+textureFileDXGIFormat(const uint32_t dxgi_format)
+{
+  switch(dxgi_format)
+  {
+    case 71: return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+    case 72: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT;
+    case 74: return GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+    case 75: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT;
+    case 77: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    case 78: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+    case 80: return GL_COMPRESSED_RED_RGTC1;
+    case 81: return GL_COMPRESSED_SIGNED_RED_RGTC1;
+    case 83: return GL_COMPRESSED_RG_RGTC2;
+    case 84: return GL_COMPRESSED_SIGNED_RG_RGTC2;
+    case 95: return GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT;
+    case 96: return GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT;
+    case 98: return GL_COMPRESSED_RGBA_BPTC_UNORM;
+    case 99: return GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
+  }
+
+  return 0;
+}
+
+static bool
+textureFileParseDDS(TextureFile *file)
+{
+  constexpr size_t header_size = 128;
+  constexpr size_t dx10_header_size = 20;
+
+  if(file->size < header_size)
+  {
+    return false;
+  }
+
+  const uint8_t *bytes = file->bytes;
+
+  const uint32_t height = textureFileU32(bytes + 12);
+  const uint32_t width = textureFileU32(bytes + 16);
+  const uint32_t mip_count = textureFileU32(bytes + 28);
+  const uint32_t pixel_flags = textureFileU32(bytes + 80);
+  const uint32_t four_cc = textureFileU32(bytes + 84);
+  const uint32_t caps2 = textureFileU32(bytes + 112);
+
+  constexpr uint32_t pixel_flag_four_cc = 0x4;
+  constexpr uint32_t caps2_cubemap = 0x200;
+  constexpr uint32_t caps2_volume = 0x200000;
+
+  if(!(pixel_flags & pixel_flag_four_cc) || (caps2 & (caps2_cubemap | caps2_volume)))
+  {
+    return false;
+  }
+
+  GLenum internal_format = 0;
+  size_t data_offset = header_size;
+
+  if(four_cc == textureFileFourCC("DX10"))
+  {
+    if(file->size < header_size + dx10_header_size)
+    {
+      return false;
+    }
+
+    const uint32_t dxgi_format = textureFileU32(bytes + 128);
+    const uint32_t dimension = textureFileU32(bytes + 132);
+    const uint32_t misc_flags = textureFileU32(bytes + 136);
+    const uint32_t array_size = textureFileU32(bytes + 140);
+
+    constexpr uint32_t dimension_2d = 3;
+    constexpr uint32_t misc_cubemap = 0x4;
+
+    if(dimension != dimension_2d || (misc_flags & misc_cubemap) || array_size > 1)
+    {
+      return false;
+    }
+
+    internal_format = textureFileDXGIFormat(dxgi_format);
+    data_offset += dx10_header_size;
+  }
+  else if(four_cc == textureFileFourCC("DXT1"))
+  {
+    internal_format = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+  }
+  else if(four_cc == textureFileFourCC("DXT2") || four_cc == textureFileFourCC("DXT3"))
+  {
+    internal_format = GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+  }
+  else if(four_cc == textureFileFourCC("DXT4") || four_cc == textureFileFourCC("DXT5"))
+  {
+    internal_format = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+  }
+  else if(four_cc == textureFileFourCC("ATI1") || four_cc == textureFileFourCC("BC4U"))
+  {
+    internal_format = GL_COMPRESSED_RED_RGTC1;
+  }
+  else if(four_cc == textureFileFourCC("BC4S"))
+  {
+    internal_format = GL_COMPRESSED_SIGNED_RED_RGTC1;
+  }
+  else if(four_cc == textureFileFourCC("ATI2") || four_cc == textureFileFourCC("BC5U"))
+  {
+    internal_format = GL_COMPRESSED_RG_RGTC2;
+  }
+  else if(four_cc == textureFileFourCC("BC5S"))
+  {
+    internal_format = GL_COMPRESSED_SIGNED_RG_RGTC2;
+  }
+
+  file->internal_format = internal_format;
+  file->width = (GLsizei)width;
+  file->height = (GLsizei)height;
+  file->mip_count = mip_count ? (GLsizei)mip_count : 1;
+
+  return textureFileSequentialLevels(file, data_offset, false);
+}
+
+
+// ----------------------------------------------------------[ Texture File ]--
+
+bool
+parseTextureFile(TextureFile *out_file, const void *bytes, const size_t size)
+{
+  memset(out_file, 0, sizeof(TextureFile));
+
+  static const uint8_t ktx1_id[12] = {
+    0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n',
+  };
+
+  static const uint8_t ktx2_id[12] = {
+    0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n',
+  };
+
+  out_file->bytes = (const uint8_t*)bytes;
+  out_file->size = size;
+
+  bool parsed = false;
+
+  if(size >= 12 && memcmp(bytes, ktx1_id, 12) == 0)
+  {
+    parsed = textureFileParseKTX1(out_file);
+  }
+  else if(size >= 12 && memcmp(bytes, ktx2_id, 12) == 0)
+  {
+    parsed = textureFileParseKTX2(out_file);
+  }
+  else if(size >= 4 && memcmp(bytes, "DDS ", 4) == 0)
+  {
+    parsed = textureFileParseDDS(out_file);
+  }
+
+  parsed = parsed &&
+           textureFileIsBC(out_file->internal_format) &&
+           out_file->width > 0 && out_file->height > 0 &&
+           out_file->mip_count <= THIN_TEXTURE_FILE_MAX_LEVELS;
+
+  if(!parsed)
+  {
+    memset(out_file, 0, sizeof(TextureFile));
+  }
+
+  return parsed;
+}
+
+bool
+openTextureFile(TextureFile *out_file, const char *path)
+{
+  memset(out_file, 0, sizeof(TextureFile));
+
+  const void *bytes = nullptr;
+  size_t size = 0;
+
+  #if defined(_WIN32)
+  HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+  if(file == INVALID_HANDLE_VALUE)
+  {
+    return false;
+  }
+
+  LARGE_INTEGER file_size;
+  HANDLE mapping = GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0 ?
+    CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) :
+    nullptr;
+
+  // The view keeps the file open on its own.
+  if(mapping)
+  {
+    bytes = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    size = (size_t)file_size.QuadPart;
+    CloseHandle(mapping);
+  }
+
+  CloseHandle(file);
+  #else
+  const int fd = open(path, O_RDONLY);
+
+  if(fd < 0)
+  {
+    return false;
+  }
+
+  struct stat file_stat;
+
+  if(fstat(fd, &file_stat) == 0 && file_stat.st_size > 0)
+  {
+    void *mapped = mmap(nullptr, (size_t)file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    if(mapped != MAP_FAILED)
+    {
+      bytes = mapped;
+      size = (size_t)file_stat.st_size;
+    }
+  }
+
+  close(fd);
+  #endif
+
+  if(!bytes)
+  {
+    return false;
+  }
+
+  if(!parseTextureFile(out_file, bytes, size))
+  {
+    #if defined(_WIN32)
+    UnmapViewOfFile(bytes);
+    #else
+    munmap((void*)bytes, size);
+    #endif
+
+    return false;
+  }
+
+  return true;
+}
+
+void
+closeTextureFile(TextureFile *file)
+{
+  if(file->bytes)
+  {
+    #if defined(_WIN32)
+    UnmapViewOfFile(file->bytes);
+    #else
+    munmap((void*)file->bytes, file->size);
+    #endif
+  }
+
+  memset(file, 0, sizeof(TextureFile));
+}
+
+uintptr_t
+loadTextureFile(Device *device, const char *path)
+{
+  TextureFile file;
+
+  if(!openTextureFile(&file, path))
+  {
+    if(device->curr_error_callback)
+    {
+      device->curr_error_callback("Texture file missing or not a 2D BC1-7 KTX/DDS");
+    }
+
+    return 0;
+  }
+
+  const uintptr_t texture = device->createCompressedTexture2D(file.internal_format,
+                                                              file.width,
+                                                              file.height,
+                                                              file.mip_count,
+                                                              file.levels);
+
+  closeTextureFile(&file);
+
+  return texture;
+}
+
+
+#endif // impl guard
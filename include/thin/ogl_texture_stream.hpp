@@ -0,0 +1,528 @@
+#ifndef THIN_OGL_TEXTURE_STREAM_INCLUDED_
+#define THIN_OGL_TEXTURE_STREAM_INCLUDED_
+
+
+/*
+  Keeps textures only as sharp as they're drawn. Each starts with its small
+  mips resident, streamRequest says which level a draw wants and
+  streamUpdate uploads finer levels towards it, coarse first, under a
+  per-frame upload budget. When resident bytes would pass the memory budget
+  the least recently used textures give back their finest levels.
+
+  Textures use mutable storage so single levels can be allocated and
+  released, GL_TEXTURE_BASE_LEVEL is the finest resident level and sampling
+  never sees the missing ones. Level data is read from the caller's
+  pointers, which must stay valid while the texture is in the stream, a
+  mapped TextureFile or an image.hpp mip chain both work.
+*/
+
+
+#include "ogl_device.hpp"
+
+
+// --------------------------------------------------------[ Texture Stream ]--
+
+struct StreamTextureDesc
+{
+  GLenum                internal_format;  // Sized or BC1-7.
+  GLsizei               width;
+  GLsizei               height;
+  GLsizei               mip_count;
+  const CompressedLevel *levels;          // mip_count of them, copied.
+  GLenum                data_format;      // Zero for block compressed,
+  GLenum                data_type;        // sizes are only read then.
+};
+
+struct TextureStreamDesc
+{
+  size_t    budget_bytes;             // Every resident level, tails can
+                                      // push past it as they never leave.
+  size_t    upload_bytes_per_frame;   // Zero is 4MB, one level always goes.
+  GLsizei   tail_size;                // Levels this size and under never
+                                      // leave, zero is 64.
+};
+
+struct TextureStreamStats
+{
+  size_t    budget_bytes;
+  size_t    resident_bytes;           // Tails included.
+  size_t    wanted_bytes;             // If every request were met.
+  uint32_t  texture_count;
+  uint32_t  levels_uploaded;          // Last streamUpdate.
+  uint32_t  levels_evicted;
+  size_t    bytes_uploaded;
+};
+
+struct StreamTexture
+{
+  uintptr_t         texture;          // Zero for a free slot.
+  StreamTextureDesc desc;
+  GLsizei           tail_level;       // Coarsest level that can be evicted,
+                                      // plus one.
+  GLsizei           resident_level;   // Finest level in memory.
+  GLsizei           wanted_level;
+  uint64_t          last_used_frame;
+  size_t            resident_bytes;
+};
+
+struct TextureStream
+{
+  Device              *device;
+  TextureStreamDesc   desc;
+  StreamTexture       *textures;
+  size_t              texture_capacity;
+  uint64_t            frame;
+  TextureStreamStats  stats;
+};
+
+void
+createTextureStream(TextureStream *out_stream, Device *device, const TextureStreamDesc &desc);
+
+/*
+  Deletes every texture still in the stream.
+*/
+void
+destroyTextureStream(TextureStream *stream);
+
+/*
+  Creates the texture with its tail levels, returns a handle for the other
+  calls or zero if the description is unusable.
+*/
+uint32_t
+streamAddTexture(TextureStream *stream, const StreamTextureDesc &desc);
+
+void
+streamRemoveTexture(TextureStream *stream, const uint32_t handle);
+
+/*
+  Marks the texture used this frame and wanting level lod, the finest of a
+  frame's requests wins. Returns the GL texture to bind, whatever is
+  resident now.
+*/
+uintptr_t
+streamRequest(TextureStream *stream, const uint32_t handle, const float lod = 0.f);
+
+/*
+  Once a frame, uploads towards the requests and evicts to stay in budget,
+  then refreshes stream->stats.
+*/
+void
+streamUpdate(TextureStream *stream);
+
+
+#endif // inc guard
+
+
+#if defined(THIN_TEXTURE_STREAM_IMPL) && !defined(THIN_TEXTURE_STREAM_IMPL_INCLUDED_)
+#define THIN_TEXTURE_STREAM_IMPL_INCLUDED_
+
+#include <stdlib.h>
+#include <string.h>
+
+
+// ----------------------------------------------------------------[ Levels ]--
+
+static size_t
+streamLevelBytes(const StreamTexture &tex, const GLsizei level)
+{
+  if(!tex.desc.data_format)
+  {
+    return tex.desc.levels[level].size;
+  }
+
+  const GLsizei w = tex.desc.width >> level ? tex.desc.width >> level : 1;
+  const GLsizei h = tex.desc.height >> level ? tex.desc.height >> level : 1;
+
+  return pixelDataSize(w, h, tex.desc.data_format, tex.desc.data_type);
+}
+
+static void
+streamUploadLevel(TextureStream *stream, StreamTexture &tex, const GLsizei level)
+{
+  Device *device = stream->device;
+  const StreamTextureDesc &desc = tex.desc;
+
+  const GLsizei w = desc.width >> level ? desc.width >> level : 1;
+  const GLsizei h = desc.height >> level ? desc.height >> level : 1;
+
+  device->bindTexture(GL_TEXTURE_2D, tex.texture);
+
+  if(desc.data_format)
+  {
+    // Storage here, pixels through the device's staging buffers.
+    glTexImage2D(GL_TEXTURE_2D, level, desc.internal_format, w, h, 0,
+                 desc.data_format, desc.data_type, nullptr);
+
+    device->uploadTexture2D(tex.texture, level, 0, 0, w, h,
+                            desc.data_format, desc.data_type, desc.levels[level].data);
+  }
+  else
+  {
+    glCompressedTexImage2D(GL_TEXTURE_2D, level, desc.internal_format, w, h, 0,
+                           desc.levels[level].size, desc.levels[level].data);
+
+    device->stats.bytes_uploaded += desc.levels[level].size;
+  }
+
+  const size_t bytes = streamLevelBytes(tex, level);
+
+  tex.resident_bytes += bytes;
+  stream->stats.resident_bytes += bytes;
+  stream->stats.levels_uploaded += 1;
+  stream->stats.bytes_uploaded += bytes;
+
+  #ifdef THIN_EXTRA_ERROR_CHECKS
+  device->getError("Stream Upload Level");
+  #endif
+}
+
+static void
+streamApplyLevels(TextureStream *stream, StreamTexture &tex)
+{
+  Device *device = stream->device;
+
+  device->bindTexture(GL_TEXTURE_2D, tex.texture);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, tex.resident_level);
+
+  device->setTextureMemory(tex.texture, tex.resident_bytes);
+}
+
+/*
+  Drops the finest resident level, base level moves past it first so the
+  texture stays complete.
+*/
+static void
+streamEvictLevel(TextureStream *stream, StreamTexture &tex)
+{
+  const GLsizei level = tex.resident_level;
+  const size_t bytes = streamLevelBytes(tex, level);
+
+  tex.resident_level += 1;
+  tex.resident_bytes -= bytes;
+  streamApplyLevels(stream, tex);
+
+  // Respecifying as empty hands the memory back.
+  if(tex.desc.data_format)
+  {
+    glTexImage2D(GL_TEXTURE_2D, level, tex.desc.internal_format, 0, 0, 0,
+                 tex.desc.data_format, tex.desc.data_type, nullptr);
+  }
+  else
+  {
+    glCompressedTexImage2D(GL_TEXTURE_2D, level, tex.desc.internal_format, 0, 0, 0, 0, nullptr);
+  }
+
+  stream->stats.resident_bytes -= bytes;
+  stream->stats.levels_evicted += 1;
+}
+
+/*
+  Levels finer than their texture wants go first, then the least recently
+  used texture's finest. Textures used this frame only give up unwanted
+  levels. False if nothing can go.
+*/
+static bool
+streamEvictOne(TextureStream *stream, const StreamTexture *keep)
+{
+  StreamTexture *victim = nullptr;
+  bool victim_unwanted = false;
+
+  for(size_t i = 0; i < stream->texture_capacity; ++i)
+  {
+    StreamTexture &tex = stream->textures[i];
+
+    if(!tex.texture || &tex == keep || tex.resident_level >= tex.tail_level)
+    {
+      continue;
+    }
+
+    const bool unwanted = tex.resident_level < tex.wanted_level;
+
+    if(!unwanted && tex.last_used_frame == stream->frame)
+    {
+      continue;
+    }
+
+    if(!victim ||
+       (unwanted && !victim_unwanted) ||
+       (unwanted == victim_unwanted && tex.last_used_frame < victim->last_used_frame))
+    {
+      victim = &tex;
+      victim_unwanted = unwanted;
+    }
+  }
+
+  if(!victim)
+  {
+    return false;
+  }
+
+  streamEvictLevel(stream, *victim);
+  return true;
+}
+
+/*
+  What streamEvictOne would free if called until it returns false.
+*/
+static size_t
+streamEvictableBytes(const TextureStream *stream, const StreamTexture *keep)
+{
+  size_t bytes = 0;
+
+  for(size_t i = 0; i < stream->texture_capacity; ++i)
+  {
+    const StreamTexture &tex = stream->textures[i];
+
+    if(!tex.texture || &tex == keep)
+    {
+      continue;
+    }
+
+    const GLsizei end = tex.last_used_frame == stream->frame ? tex.wanted_level : tex.tail_level;
+
+    for(GLsizei level = tex.resident_level; level < end; ++level)
+    {
+      bytes += streamLevelBytes(tex, level);
+    }
+  }
+
+  return bytes;
+}
+
+
+// --------------------------------------------------------[ Texture Stream ]--
+
+void
+createTextureStream(TextureStream *out_stream, Device *device, const TextureStreamDesc &desc)
+{
+  memset(out_stream, 0, sizeof(TextureStream));
+
+  out_stream->device = device;
+  out_stream->desc = desc;
+  out_stream->desc.upload_bytes_per_frame = desc.upload_bytes_per_frame ?
+                                            desc.upload_bytes_per_frame :
+                                            4 << 20;
+  out_stream->desc.tail_size = desc.tail_size > 0 ? desc.tail_size : 64;
+  out_stream->stats.budget_bytes = desc.budget_bytes;
+}
+
+void
+destroyTextureStream(TextureStream *stream)
+{
+  for(size_t i = 0; i < stream->texture_capacity; ++i)
+  {
+    if(stream->textures[i].texture)
+    {
+      streamRemoveTexture(stream, (uint32_t)i + 1);
+    }
+  }
+
+  free(stream->textures);
+  memset(stream, 0, sizeof(TextureStream));
+}
+
+uint32_t
+streamAddTexture(TextureStream *stream, const StreamTextureDesc &desc)
+{
+  if(desc.width <= 0 || desc.height <= 0 || desc.mip_count <= 0 || !desc.levels)
+  {
+    if(stream->device->curr_error_callback)
+    {
+      stream->device->curr_error_callback("Stream texture desc has no size or levels");
+    }
+
+    return 0;
+  }
+
+  size_t slot = 0;
+
+  while(slot < stream->texture_capacity && stream->textures[slot].texture)
+  {
+    ++slot;
+  }
+
+  if(slot == stream->texture_capacity)
+  {
+    const size_t capacity = stream->texture_capacity ? stream->texture_capacity * 2 : 64;
+
+    stream->textures = (StreamTexture*)realloc(stream->textures, capacity * sizeof(StreamTexture));
+    memset(stream->textures + stream->texture_capacity, 0,
+           (capacity - stream->texture_capacity) * sizeof(StreamTexture));
+    stream->texture_capacity = capacity;
+  }
+
+  StreamTexture &tex = stream->textures[slot];
+  memset(&tex, 0, sizeof(StreamTexture));
+
+  tex.desc = desc;
+  tex.desc.levels = (const CompressedLevel*)malloc(desc.mip_count * sizeof(CompressedLevel));
+  memcpy((void*)tex.desc.levels, desc.levels, desc.mip_count * sizeof(CompressedLevel));
+
+  // Tail is every level no bigger than tail_size either way.
+  tex.tail_level = 0;
+
+  while(tex.tail_level < desc.mip_count - 1 &&
+        ((desc.width >> tex.tail_level) > stream->desc.tail_size ||
+         (desc.height >> tex.tail_level) > stream->desc.tail_size))
+  {
+    tex.tail_level += 1;
+  }
+
+  tex.resident_level = desc.mip_count;
+  tex.wanted_level = tex.tail_level;
+  tex.last_used_frame = stream->frame;
+  tex.texture = stream->device->genTexture();
+
+  Device *device = stream->device;
+  device->bindTexture(GL_TEXTURE_2D, tex.texture);
+
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, desc.mip_count - 1);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+                  desc.mip_count > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+
+  // Coarsest first so base level only ever moves down onto a full chain.
+  for(GLsizei level = desc.mip_count - 1; level >= tex.tail_level; --level)
+  {
+    streamUploadLevel(stream, tex, level);
+    tex.resident_level = level;
+  }
+
+  streamApplyLevels(stream, tex);
+  stream->stats.texture_count += 1;
+
+  return (uint32_t)slot + 1;
+}
+
+void
+streamRemoveTexture(TextureStream *stream, const uint32_t handle)
+{
+  if(handle == 0 || handle > stream->texture_capacity || !stream->textures[handle - 1].texture)
+  {
+    return;
+  }
+
+  StreamTexture &tex = stream->textures[handle - 1];
+
+  stream->device->deleteTexture(tex.texture);
+  stream->stats.resident_bytes -= tex.resident_bytes;
+  stream->stats.texture_count -= 1;
+
+  free((void*)tex.desc.levels);
+  memset(&tex, 0, sizeof(StreamTexture));
+}
+
+uintptr_t
+streamRequest(TextureStream *stream, const uint32_t handle, const float lod)
+{
+  if(handle == 0 || handle > stream->texture_capacity)
+  {
+    return 0;
+  }
+
+  StreamTexture &tex = stream->textures[handle - 1];
+
+  const GLsizei max_level = tex.desc.mip_count - 1;
+  const GLsizei level = lod <= 0.f ? 0 : lod >= max_level ? max_level : (GLsizei)lod;
+  const GLsizei wanted = level < tex.tail_level ? level : tex.tail_level;
+
+  // First request of the frame replaces the last frame's.
+  if(tex.last_used_frame != stream->frame)
+  {
+    tex.wanted_level = wanted;
+  }
+  else if(wanted < tex.wanted_level)
+  {
+    tex.wanted_level = wanted;
+  }
+
+  tex.last_used_frame = stream->frame;
+
+  return tex.texture;
+}
+
+void
+streamUpdate(TextureStream *stream)
+{
+  stream->stats.levels_uploaded = 0;
+  stream->stats.levels_evicted = 0;
+  stream->stats.bytes_uploaded = 0;
+
+  // Round robin, one level per texture a pass so every request moves a
+  // step before any gets sharp.
+  bool progress = true;
+  bool out_of_budget = false;
+
+  while(progress && !out_of_budget)
+  {
+    progress = false;
+
+    for(size_t i = 0; i < stream->texture_capacity && !out_of_budget; ++i)
+    {
+      StreamTexture &tex = stream->textures[i];
+
+      if(!tex.texture || tex.last_used_frame != stream->frame ||
+         tex.resident_level <= tex.wanted_level)
+      {
+        continue;
+      }
+
+      const GLsizei level = tex.resident_level - 1;
+      const size_t bytes = streamLevelBytes(tex, level);
+
+      if(stream->stats.bytes_uploaded > 0 &&
+         stream->stats.bytes_uploaded + bytes > stream->desc.upload_bytes_per_frame)
+      {
+        out_of_budget = true;
+        break;
+      }
+
+      // Evicting for a level that still won't fit only loses other levels.
+      if(stream->stats.resident_bytes + bytes > stream->desc.budget_bytes &&
+         stream->stats.resident_bytes + bytes - streamEvictableBytes(stream, &tex) >
+         stream->desc.budget_bytes)
+      {
+        continue;
+      }
+
+      while(stream->stats.resident_bytes + bytes > stream->desc.budget_bytes &&
+            streamEvictOne(stream, &tex))
+      {
+      }
+
+      streamUploadLevel(stream, tex, level);
+      tex.resident_level = level;
+      streamApplyLevels(stream, tex);
+
+      progress = true;
+    }
+  }
+
+  // Over budget can still happen from tails alone or lowered budgets.
+  while(stream->stats.resident_bytes > stream->desc.budget_bytes && streamEvictOne(stream, nullptr))
+  {
+  }
+
+  size_t wanted_bytes = 0;
+
+  for(size_t i = 0; i < stream->texture_capacity; ++i)
+  {
+    const StreamTexture &tex = stream->textures[i];
+
+    // Textures not requested this frame only want their tails.
+    const GLsizei first = !tex.texture ? tex.desc.mip_count :
+                          tex.last_used_frame == stream->frame ? tex.wanted_level :
+                          tex.tail_level;
+
+    for(GLsizei level = first; level < tex.desc.mip_count; ++level)
+    {
+      wanted_bytes += streamLevelBytes(tex, level);
+    }
+  }
+
+  stream->stats.wanted_bytes = wanted_bytes;
+  stream->stats.budget_bytes = stream->desc.budget_bytes;
+  stream->frame += 1;
+}
+
+
+#endif // impl guard
@@ -0,0 +1,549 @@
+#ifndef THIN_VERTEX_FORMAT_INCLUDED_
+#define THIN_VERTEX_FORMAT_INCLUDED_
+
+
+/*
+  Transcodes float vertex streams into compact attribute formats. Define
+  THIN_NO_SIMD to force the scalar kernels, otherwise SSE2 / AVX2 / F16C
+  kernels are picked from the compiler target flags.
+*/
+
+
+#include "ogl_device.hpp"
+
+
+enum class VertexFormat : uint8_t
+{
+  float32,          // GL_FLOAT, copied as is.
+  half16,           // GL_HALF_FLOAT.
+  unorm8,           // GL_UNSIGNED_BYTE normalized, [0,1].
+  snorm16,          // GL_SHORT normalized, [-1,1].
+  snorm_2_10_10_10, // GL_INT_2_10_10_10_REV normalized, 3 or 4 components.
+};
+
+// ---------------------------------------------------------------[ Kernels ]--
+
+void
+floatToHalf(const float *src, uint16_t *dst, const size_t count);
+
+void
+floatToUnorm8(const float *src, uint8_t *dst, const size_t count);
+
+void
+floatToSnorm16(const float *src, int16_t *dst, const size_t count);
+
+void
+floatToSnorm2_10_10_10(const float *src_xyzw, uint32_t *dst, const size_t count);
+
+// ------------------------------------------------------------[ Transcoder ]--
+
+/*
+  Fills out_layout with the compact equivalent of src_layout, which must be
+  float attributes in buffer slot 0. Returns the new stride or zero if the
+  source layout can't be transcoded.
+*/
+size_t
+vertexFormatLayout(const VertexLayout &src_layout,
+                   const VertexFormat formats[],
+                   VertexLayout *out_layout);
+
+/*
+  Converts vertex_count vertices, dst_vertices must hold vertex_count times
+  the stride returned from vertexFormatLayout.
+*/
+size_t
+transcodeVertices(const VertexLayout &src_layout,
+                  const VertexFormat formats[],
+                  const void *src_vertices,
+                  const size_t vertex_count,
+                  void *dst_vertices);
+
+
+#endif // inc guard
+
+
+#if defined(THIN_VERTEX_FORMAT_IMPL) && !defined(THIN_VERTEX_FORMAT_IMPL_INCLUDED_)
+#define THIN_VERTEX_FORMAT_IMPL_INCLUDED_
+
+#include <math.h>
+#include <string.h>
+
+#ifndef THIN_NO_SIMD
+  #if defined(__SSE2__) || defined(_M_X64)
+    #define THIN_VERTEX_FORMAT_SSE2
+    #include <emmintrin.h>
+  #endif
+
+  #if defined(__AVX2__)
+    #define THIN_VERTEX_FORMAT_AVX2
+    #include <immintrin.h>
+  #endif
+#endif
+
+
+// ---------------------------------------------------------------[ Kernels ]--
+
+static inline uint16_t
+floatToHalfScalar(const float f)
+{
+  // Round to nearest even, handles denormals, inf and nan.
+  const uint32_t f32_infty = 255u << 23;
+  const uint32_t f16_max = (127u + 16u) << 23;
+  const uint32_t denorm_magic_bits = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+  uint32_t u;
+  memcpy(&u, &f, sizeof(u));
+
+  const uint32_t sign = u & 0x80000000u;
+  u ^= sign;
+
+  uint16_t out;
+
+  if(u >= f16_max)
+  {
+    out = (u > f32_infty) ? 0x7e00 : 0x7c00;
+  }
+  else if(u < (113u << 23))
+  {
+    float denorm_magic;
+    memcpy(&denorm_magic, &denorm_magic_bits, sizeof(denorm_magic));
+
+    float fu;
+    memcpy(&fu, &u, sizeof(fu));
+    fu += denorm_magic;
+    memcpy(&u, &fu, sizeof(u));
+
+    out = (uint16_t)(u - denorm_magic_bits);
+  }
+  else
+  {
+    const uint32_t mant_odd = (u >> 13) & 1;
+
+    u += ((uint32_t)(15 - 127) << 23) + 0xfff;
+    u += mant_odd;
+    out = (uint16_t)(u >> 13);
+  }
+
+  return out | (uint16_t)(sign >> 16);
+}
+
+static inline float
+clampFloat(const float f, const float lo, const float hi)
+{
+  // Written so nan clamps to lo, matching _mm_max_ps / _mm_min_ps.
+  return f > lo ? (f < hi ? f : hi) : lo;
+}
+
+static inline int32_t
+roundFloat(const float f)
+{
+  // Nearest even, same as the SIMD conversions.
+  return (int32_t)lrintf(f);
+}
+
+#ifdef THIN_VERTEX_FORMAT_SSE2
+static inline __m128i
+floatToHalfSSE2(const __m128 f)
+{
+  // Four lane version of floatToHalfScalar, result is sign extended to 32bit
+  // so it survives _mm_packs_epi32.
+  const __m128i c_f16max = _mm_set1_epi32((127 + 16) << 23);
+  const __m128i c_nanbit = _mm_set1_epi32(0x200);
+  const __m128i c_infty = _mm_set1_epi32(0x7c00);
+  const __m128i c_min_normal = _mm_set1_epi32((127 - 14) << 23);
+  const __m128i c_subnorm_magic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+  const __m128i c_normal_bias = _mm_set1_epi32(0xfff - ((127 - 15) << 23));
+
+  const __m128 just_sign = _mm_and_ps(_mm_castsi128_ps(_mm_set1_epi32(0x80000000)), f);
+  const __m128 abs_f = _mm_xor_ps(f, just_sign);
+  const __m128i abs_i = _mm_castps_si128(abs_f);
+
+  const __m128 is_nan = _mm_cmpunord_ps(abs_f, abs_f);
+  const __m128i is_regular = _mm_cmpgt_epi32(c_f16max, abs_i);
+  const __m128i inf_or_nan = _mm_or_si128(_mm_and_si128(_mm_castps_si128(is_nan), c_nanbit), c_infty);
+  const __m128i is_sub = _mm_cmpgt_epi32(c_min_normal, abs_i);
+
+  const __m128 sub1 = _mm_add_ps(abs_f, _mm_castsi128_ps(c_subnorm_magic));
+  const __m128i sub2 = _mm_sub_epi32(_mm_castps_si128(sub1), c_subnorm_magic);
+
+  const __m128i mant_odd = _mm_srai_epi32(_mm_slli_epi32(abs_i, 31 - 13), 31);
+  const __m128i round = _mm_sub_epi32(_mm_add_epi32(abs_i, c_normal_bias), mant_odd);
+  const __m128i normal = _mm_srli_epi32(round, 13);
+
+  const __m128i non_special = _mm_or_si128(_mm_and_si128(sub2, is_sub), _mm_andnot_si128(is_sub, normal));
+  const __m128i joined = _mm_or_si128(_mm_and_si128(non_special, is_regular), _mm_andnot_si128(is_regular, inf_or_nan));
+
+  return _mm_or_si128(joined, _mm_srai_epi32(_mm_castps_si128(just_sign), 16));
+}
+#endif
+
+void
+floatToHalf(const float *src, uint16_t *dst, const size_t count)
+{
+  size_t i = 0;
+
+  #if defined(THIN_VERTEX_FORMAT_AVX2) && defined(__F16C__)
+  const __m128i c_abs = _mm_set1_epi16(0x7fff);
+  const __m128i c_infty = _mm_set1_epi16(0x7c00);
+  const __m128i c_payload = _mm_set1_epi16(0x01ff);
+
+  for(; i + 8 <= count; i += 8)
+  {
+    const __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+
+    // F16C keeps the nan payload, the other paths all give sign | 0x7e00.
+    // Quiet bit is already set, drop the rest of the payload.
+    const __m128i is_nan = _mm_cmpgt_epi16(_mm_and_si128(h, c_abs), c_infty);
+    _mm_storeu_si128((__m128i*)(dst + i), _mm_andnot_si128(_mm_and_si128(is_nan, c_payload), h));
+  }
+  #elif defined(THIN_VERTEX_FORMAT_SSE2)
+  for(; i + 8 <= count; i += 8)
+  {
+    const __m128i lo = floatToHalfSSE2(_mm_loadu_ps(src + i));
+    const __m128i hi = floatToHalfSSE2(_mm_loadu_ps(src + i + 4));
+    _mm_storeu_si128((__m128i*)(dst + i), _mm_packs_epi32(lo, hi));
+  }
+  #endif
+
+  for(; i < count; ++i)
+  {
+    dst[i] = floatToHalfScalar(src[i]);
+  }
+}
+
+void
+floatToUnorm8(const float *src, uint8_t *dst, const size_t count)
+{
+  size_t i = 0;
+
+  #if defined(THIN_VERTEX_FORMAT_AVX2)
+  {
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.f);
+    const __m256 scale = _mm256_set1_ps(255.f);
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+    for(; i + 32 <= count; i += 32)
+    {
+      __m256i v[4];
+
+      for(int j = 0; j < 4; ++j)
+      {
+        const __m256 f = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(src + i + j * 8), zero), one);
+        v[j] = _mm256_cvtps_epi32(_mm256_mul_ps(f, scale));
+      }
+
+      // Packs work per 128bit lane, permute restores the order.
+      const __m256i ab = _mm256_packs_epi32(v[0], v[1]);
+      const __m256i cd = _mm256_packs_epi32(v[2], v[3]);
+      const __m256i bytes = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(ab, cd), order);
+
+      _mm256_storeu_si256((__m256i*)(dst + i), bytes);
+    }
+  }
+  #endif
+
+  #if defined(THIN_VERTEX_FORMAT_SSE2)
+  {
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.f);
+    const __m128 scale = _mm_set1_ps(255.f);
+
+    for(; i + 16 <= count; i += 16)
+    {
+      __m128i v[4];
+
+      for(int j = 0; j < 4; ++j)
+      {
+        const __m128 f = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i + j * 4), zero), one);
+        v[j] = _mm_cvtps_epi32(_mm_mul_ps(f, scale));
+      }
+
+      const __m128i ab = _mm_packs_epi32(v[0], v[1]);
+      const __m128i cd = _mm_packs_epi32(v[2], v[3]);
+
+      _mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(ab, cd));
+    }
+  }
+  #endif
+
+  for(; i < count; ++i)
+  {
+    dst[i] = (uint8_t)roundFloat(clampFloat(src[i], 0.f, 1.f) * 255.f);
+  }
+}
+
+void
+floatToSnorm16(const float *src, int16_t *dst, const size_t count)
+{
+  size_t i = 0;
+
+  #if defined(THIN_VERTEX_FORMAT_AVX2)
+  {
+    const __m256 lo = _mm256_set1_ps(-1.f);
+    const __m256 hi = _mm256_set1_ps(1.f);
+    const __m256 scale = _mm256_set1_ps(32767.f);
+
+    for(; i + 16 <= count; i += 16)
+    {
+      const __m256 a = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(src + i), lo), hi);
+      const __m256 b = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(src + i + 8), lo), hi);
+
+      const __m256i packed = _mm256_packs_epi32(
+        _mm256_cvtps_epi32(_mm256_mul_ps(a, scale)),
+        _mm256_cvtps_epi32(_mm256_mul_ps(b, scale)));
+
+      _mm256_storeu_si256((__m256i*)(dst + i), _mm256_permute4x64_epi64(packed, 0xd8));
+    }
+  }
+  #endif
+
+  #if defined(THIN_VERTEX_FORMAT_SSE2)
+  {
+    const __m128 lo = _mm_set1_ps(-1.f);
+    const __m128 hi = _mm_set1_ps(1.f);
+    const __m128 scale = _mm_set1_ps(32767.f);
+
+    for(; i + 8 <= count; i += 8)
+    {
+      const __m128 a = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i), lo), hi);
+      const __m128 b = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i + 4), lo), hi);
+
+      const __m128i packed = _mm_packs_epi32(
+        _mm_cvtps_epi32(_mm_mul_ps(a, scale)),
+        _mm_cvtps_epi32(_mm_mul_ps(b, scale)));
+
+      _mm_storeu_si128((__m128i*)(dst + i), packed);
+    }
+  }
+  #endif
+
+  for(; i < count; ++i)
+  {
+    dst[i] = (int16_t)roundFloat(clampFloat(src[i], -1.f, 1.f) * 32767.f);
+  }
+}
+
+void
+floatToSnorm2_10_10_10(const float *src, uint32_t *dst, const size_t count)
+{
+  size_t i = 0;
+
+  #if defined(THIN_VERTEX_FORMAT_SSE2)
+  {
+    const __m128 lo = _mm_set1_ps(-1.f);
+    const __m128 hi = _mm_set1_ps(1.f);
+    const __m128 scale = _mm_set1_ps(511.f);
+    const __m128i mask10 = _mm_set1_epi32(0x3ff);
+
+    for(; i + 4 <= count; i += 4)
+    {
+      // Four xyzw vertices in, transposed so each register is one component.
+      __m128 x = _mm_loadu_ps(src + i * 4 + 0);
+      __m128 y = _mm_loadu_ps(src + i * 4 + 4);
+      __m128 z = _mm_loadu_ps(src + i * 4 + 8);
+      __m128 w = _mm_loadu_ps(src + i * 4 + 12);
+      _MM_TRANSPOSE4_PS(x, y, z, w);
+
+      x = _mm_mul_ps(_mm_min_ps(_mm_max_ps(x, lo), hi), scale);
+      y = _mm_mul_ps(_mm_min_ps(_mm_max_ps(y, lo), hi), scale);
+      z = _mm_mul_ps(_mm_min_ps(_mm_max_ps(z, lo), hi), scale);
+      w = _mm_min_ps(_mm_max_ps(w, lo), hi);
+
+      const __m128i xi = _mm_and_si128(_mm_cvtps_epi32(x), mask10);
+      const __m128i yi = _mm_slli_epi32(_mm_and_si128(_mm_cvtps_epi32(y), mask10), 10);
+      const __m128i zi = _mm_slli_epi32(_mm_and_si128(_mm_cvtps_epi32(z), mask10), 20);
+      const __m128i wi = _mm_slli_epi32(_mm_cvtps_epi32(w), 30);
+
+      const __m128i packed = _mm_or_si128(_mm_or_si128(xi, yi), _mm_or_si128(zi, wi));
+      _mm_storeu_si128((__m128i*)(dst + i), packed);
+    }
+  }
+  #endif
+
+  for(; i < count; ++i)
+  {
+    const float *v = src + i * 4;
+
+    const uint32_t x = (uint32_t)roundFloat(clampFloat(v[0], -1.f, 1.f) * 511.f) & 0x3ff;
+    const uint32_t y = (uint32_t)roundFloat(clampFloat(v[1], -1.f, 1.f) * 511.f) & 0x3ff;
+    const uint32_t z = (uint32_t)roundFloat(clampFloat(v[2], -1.f, 1.f) * 511.f) & 0x3ff;
+    const uint32_t w = (uint32_t)roundFloat(clampFloat(v[3], -1.f, 1.f)) & 0x3;
+
+    dst[i] = x | (y << 10) | (z << 20) | (w << 30);
+  }
+}
+
+// ------------------------------------------------------------[ Transcoder ]--
+
+static size_t
+vertexFormatBytes(const VertexFormat format, const GLint size)
+{
+  // Attributes are kept four byte aligned.
+  switch(format)
+  {
+    case VertexFormat::float32:           return size * 4;
+    case VertexFormat::half16:            return ((size * 2) + 3) & ~3;
+    case VertexFormat::unorm8:            return 4;
+    case VertexFormat::snorm16:           return ((size * 2) + 3) & ~3;
+    case VertexFormat::snorm_2_10_10_10:  return 4;
+  }
+
+  return 0;
+}
+
+size_t
+vertexFormatLayout(const VertexLayout &src_layout,
+                   const VertexFormat formats[],
+                   VertexLayout *out_layout)
+{
+  VertexLayout layout;
+  memset(&layout, 0, sizeof(layout));
+
+  size_t offset = 0;
+
+  for(GLuint i = 0; i < src_layout.attrib_count; ++i)
+  {
+    const VertexAttrib &src = src_layout.attribs[i];
+
+    #ifdef THIN_EXTRA_PARAM_CHECKS
+    if(src.type != GL_FLOAT || src.integer || src.buffer != 0 ||
+       src.size < 1 || src.size > 4)
+    {
+      return 0;
+    }
+
+    if(formats[i] == VertexFormat::snorm_2_10_10_10 && src.size < 3)
+    {
+      return 0;
+    }
+    #endif
+
+    VertexAttrib &dst = layout.attribs[i];
+    dst = src;
+    dst.offset = (GLuint)offset;
+
+    switch(formats[i])
+    {
+      case VertexFormat::float32:
+        break;
+      case VertexFormat::half16:
+        dst.type = GL_HALF_FLOAT;
+        break;
+      case VertexFormat::unorm8:
+        dst.type = GL_UNSIGNED_BYTE;
+        dst.normalized = GL_TRUE;
+        break;
+      case VertexFormat::snorm16:
+        dst.type = GL_SHORT;
+        dst.normalized = GL_TRUE;
+        break;
+      case VertexFormat::snorm_2_10_10_10:
+        dst.type = GL_INT_2_10_10_10_REV;
+        dst.size = 4;
+        dst.normalized = GL_TRUE;
+        break;
+    }
+
+    offset += vertexFormatBytes(formats[i], src.size);
+  }
+
+  layout.attrib_count = src_layout.attrib_count;
+  layout.strides[0] = (GLsizei)offset;
+
+  if(out_layout)
+  {
+    *out_layout = layout;
+  }
+
+  return offset;
+}
+
+size_t
+transcodeVertices(const VertexLayout &src_layout,
+                  const VertexFormat formats[],
+                  const void *src_vertices,
+                  const size_t vertex_count,
+                  void *dst_vertices)
+{
+  VertexLayout dst_layout;
+  const size_t dst_stride = vertexFormatLayout(src_layout, formats, &dst_layout);
+
+  if(!dst_stride)
+  {
+    return 0;
+  }
+
+  const size_t src_stride = src_layout.strides[0];
+  const uint8_t *src_bytes = (const uint8_t*)src_vertices;
+  uint8_t *dst_bytes = (uint8_t*)dst_vertices;
+
+  // Attributes are gathered into a packed chunk so the kernels see
+  // contiguous floats, then the results are scattered into the stream.
+  constexpr size_t chunk = 256;
+  float gather[chunk * 4];
+  uint8_t packed[chunk * 16];
+
+  for(GLuint a = 0; a < src_layout.attrib_count; ++a)
+  {
+    const VertexAttrib &src_attr = src_layout.attribs[a];
+    const VertexAttrib &dst_attr = dst_layout.attribs[a];
+    const size_t comps = (size_t)src_attr.size;
+    const size_t dst_bytes_per = vertexFormatBytes(formats[a], src_attr.size);
+
+    // 2_10_10_10 always takes four components, w defaults to zero.
+    const size_t gather_comps = formats[a] == VertexFormat::snorm_2_10_10_10 ? 4 : comps;
+
+    for(size_t first = 0; first < vertex_count; first += chunk)
+    {
+      const size_t n = vertex_count - first < chunk ? vertex_count - first : chunk;
+
+      memset(gather, 0, sizeof(gather));
+
+      for(size_t v = 0; v < n; ++v)
+      {
+        const uint8_t *src = src_bytes + (first + v) * src_stride + src_attr.offset;
+        memcpy(&gather[v * gather_comps], src, comps * sizeof(float));
+      }
+
+      size_t packed_bytes_per = 0;
+
+      switch(formats[a])
+      {
+        case VertexFormat::float32:
+          memcpy(packed, gather, n * comps * sizeof(float));
+          packed_bytes_per = comps * sizeof(float);
+          break;
+        case VertexFormat::half16:
+          floatToHalf(gather, (uint16_t*)packed, n * comps);
+          packed_bytes_per = comps * sizeof(uint16_t);
+          break;
+        case VertexFormat::unorm8:
+          floatToUnorm8(gather, packed, n * comps);
+          packed_bytes_per = comps;
+          break;
+        case VertexFormat::snorm16:
+          floatToSnorm16(gather, (int16_t*)packed, n * comps);
+          packed_bytes_per = comps * sizeof(int16_t);
+          break;
+        case VertexFormat::snorm_2_10_10_10:
+          floatToSnorm2_10_10_10(gather, (uint32_t*)packed, n);
+          packed_bytes_per = sizeof(uint32_t);
+          break;
+      }
+
+      for(size_t v = 0; v < n; ++v)
+      {
+        uint8_t *dst = dst_bytes + (first + v) * dst_stride + dst_attr.offset;
+
+        memset(dst, 0, dst_bytes_per);
+        memcpy(dst, &packed[v * packed_bytes_per], packed_bytes_per);
+      }
+    }
+  }
+
+  return dst_stride;
+}
+
+
+#endif // impl guard
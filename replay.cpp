@@ -0,0 +1,330 @@
+
+/*
+  Replays a capture from glTraceBegin against a headless context (or the
+  null backend) and writes timings as JSON, like bench.cpp.
+
+    replay <trace.thtr> [options]
+
+    --frame N             Frame to loop, defaults to the last one.
+    --loops N             Times to play it, default 100.
+    --strip NAME          Skip every call to a function, repeatable.
+    --strip-range A:B     Skip records A to B (exclusive), repeatable.
+    --substitute A=B      Call B wherever the trace calls A, signatures
+                          must match (glUniform4fv=glUniform4iv won't).
+    --out FILE            JSON to a file instead of stdout.
+
+  Everything before the looped frame is played once, untimed, to set up.
+*/
+
+#ifndef THIN_NULL_BACKEND
+#define THIN_HEADLESS_IMPL
+#include <thin/ogl_headless.hpp>
+#endif
+
+#define THIN_DEVICE_IMPL
+#include <thin/ogl_device.hpp>
+
+#define THIN_REPLAY_IMPL
+#include <thin/ogl_replay.hpp>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+
+#include "alloc_count.hpp"
+
+
+// ---------------------------------------------------------------[ Filters ]--
+
+constexpr size_t replay_max_rules = 32;
+
+struct ReplayRules
+{
+  bool          strip[gl_id_count];
+  GLFunctionID  substitute[gl_id_count];
+  size_t        ranges[replay_max_rules][2];
+  size_t        range_count;
+};
+
+static ReplayAction
+replayRulesFilter(void *user, const size_t index, GLFunctionID *id)
+{
+  const ReplayRules *rules = (const ReplayRules*)user;
+
+  for(size_t i = 0; i < rules->range_count; ++i)
+  {
+    if(index >= rules->ranges[i][0] && index < rules->ranges[i][1])
+    {
+      return ReplayAction::skip;
+    }
+  }
+
+  if(rules->strip[*id])
+  {
+    return ReplayAction::skip;
+  }
+
+  *id = rules->substitute[*id];
+
+  return ReplayAction::play;
+}
+
+static bool
+replayParseFunction(const char *name, GLFunctionID *out_id)
+{
+  *out_id = replayFunctionID(name);
+
+  if(*out_id == gl_id_count)
+  {
+    fprintf(stderr, "Unknown GL function %s\n", name);
+    return false;
+  }
+
+  return true;
+}
+
+
+// -------------------------------------------------------------------[ Main ]--
+
+int
+main(int argc, char **argv)
+{
+  if(argc < 2)
+  {
+    fprintf(stderr, "usage: replay <trace.thtr> [--frame N] [--loops N] "
+                    "[--strip NAME] [--strip-range A:B] [--substitute A=B] "
+                    "[--out FILE]\n");
+    return 1;
+  }
+
+  static ReplayRules rules;
+
+  for(size_t i = 0; i < gl_id_count; ++i)
+  {
+    rules.substitute[i] = (GLFunctionID)i;
+  }
+
+  long frame_arg = -1;
+  long loops = 100;
+  const char *out_path = nullptr;
+
+  for(int i = 2; i < argc; i += 2)
+  {
+    const char *opt = argv[i];
+    const char *val = argv[i + 1];
+
+    // Every option takes a value.
+    if(i + 1 == argc)
+    {
+      fprintf(stderr, "%s needs a value\n", opt);
+      return 1;
+    }
+
+    if(strcmp(opt, "--frame") == 0)
+    {
+      frame_arg = atol(val);
+    }
+    else if(strcmp(opt, "--loops") == 0)
+    {
+      loops = atol(val) > 0 ? atol(val) : 1;
+    }
+    else if(strcmp(opt, "--out") == 0)
+    {
+      out_path = val;
+    }
+    else if(strcmp(opt, "--strip") == 0)
+    {
+      GLFunctionID id;
+
+      if(!replayParseFunction(val, &id))
+      {
+        return 1;
+      }
+
+      rules.strip[id] = true;
+    }
+    else if(strcmp(opt, "--strip-range") == 0)
+    {
+      unsigned long long a = 0, b = 0;
+
+      if(rules.range_count == replay_max_rules)
+      {
+        fprintf(stderr, "Too many ranges, at most %zu\n", replay_max_rules);
+        return 1;
+      }
+
+      if(sscanf(val, "%llu:%llu", &a, &b) != 2)
+      {
+        fprintf(stderr, "Bad range %s\n", val);
+        return 1;
+      }
+
+      rules.ranges[rules.range_count][0] = (size_t)a;
+      rules.ranges[rules.range_count][1] = (size_t)b;
+      rules.range_count += 1;
+    }
+    else if(strcmp(opt, "--substitute") == 0)
+    {
+      char from[128];
+      const char *eq = strchr(val, '=');
+
+      if(!eq || (size_t)(eq - val) >= sizeof(from))
+      {
+        fprintf(stderr, "Bad substitution %s\n", val);
+        return 1;
+      }
+
+      memcpy(from, val, eq - val);
+      from[eq - val] = '\0';
+
+      GLFunctionID a, b;
+
+      if(!replayParseFunction(from, &a) || !replayParseFunction(eq + 1, &b))
+      {
+        return 1;
+      }
+
+      if(!replaySameSignature(a, b))
+      {
+        fprintf(stderr, "%s and %s have different signatures\n", from, eq + 1);
+        return 1;
+      }
+
+      rules.substitute[a] = b;
+    }
+    else
+    {
+      fprintf(stderr, "Unknown option %s\n", opt);
+      return 1;
+    }
+  }
+
+  ReplayTrace trace;
+
+  if(!loadTrace(argv[1], &trace))
+  {
+    fprintf(stderr, "Failed to load %s, missing or from another build\n", argv[1]);
+    return 1;
+  }
+
+  if(!trace.frame_count)
+  {
+    fprintf(stderr, "%s has no frame markers\n", argv[1]);
+    return 1;
+  }
+
+  const size_t frame = frame_arg < 0 || (size_t)frame_arg >= trace.frame_count ?
+    trace.frame_count - 1 :
+    (size_t)frame_arg;
+
+  FILE *out = out_path ? fopen(out_path, "w") : stdout;
+
+  if(!out)
+  {
+    fprintf(stderr, "Failed to open %s\n", out_path);
+    return 1;
+  }
+
+  #ifdef THIN_NULL_BACKEND
+  Device gl;
+  gl.initialize();
+  #else
+  HeadlessContext headless;
+
+  if(!createHeadlessContext(&headless, 800, 480, 3, 3))
+  {
+    fprintf(stderr, "Failed to create a headless context\n");
+    return 1;
+  }
+
+  Device gl;
+  gl.initialize(GLLoading::all, headlessGetProc);
+  #endif
+
+  Replayer replayer;
+  createReplayer(&replayer, replayRulesFilter, &rules);
+
+  size_t frame_first = 0;
+  size_t frame_last = 0;
+  traceFrameRange(trace, frame, &frame_first, &frame_last);
+
+  replayRecords(&replayer, trace, 0, frame_first);
+  glFinish();
+
+  double *frame_ms = (double*)malloc(loops * sizeof(double));
+  size_t calls = 0;
+  uint64_t allocs = 0;
+
+  for(long i = 0; i < loops; ++i)
+  {
+    const uint64_t start_allocs = alloc_count;
+    const auto start = std::chrono::steady_clock::now();
+
+    calls = replayRecords(&replayer, trace, frame_first, frame_last);
+    glFinish();
+
+    const auto end = std::chrono::steady_clock::now();
+
+    allocs += alloc_count - start_allocs;
+    frame_ms[i] = std::chrono::duration<double, std::milli>(end - start).count();
+  }
+
+  double sum = 0.;
+
+  for(long i = 0; i < loops; ++i)
+  {
+    sum += frame_ms[i];
+  }
+
+  std::sort(frame_ms, frame_ms + loops);
+
+  fprintf(out,
+          "{\n"
+          "  \"trace\": \"%s\",\n"
+          "  \"renderer\": \"%s\",\n"
+          "  \"frame\": %zu,\n"
+          "  \"frame_records\": %zu,\n"
+          "  \"loops\": %ld,\n"
+          "  \"ms_min\": %.4f,\n"
+          "  \"ms_median\": %.4f,\n"
+          "  \"ms_mean\": %.4f,\n"
+          "  \"ms_max\": %.4f,\n"
+          "  \"driver_calls_per_frame\": %zu,\n",
+          argv[1],
+          (const char*)glGetString(GL_RENDERER),
+          frame,
+          frame_last - frame_first,
+          loops,
+          frame_ms[0],
+          frame_ms[loops / 2],
+          sum / (double)loops,
+          frame_ms[loops - 1],
+          calls);
+
+  if(alloc_counting)
+  {
+    fprintf(out, "  \"allocs_per_frame\": %.2f\n}\n", (double)allocs / (double)loops);
+  }
+  else
+  {
+    fprintf(out, "  \"allocs_per_frame\": null\n}\n");
+  }
+
+  free(frame_ms);
+  destroyReplayer(&replayer);
+  unloadTrace(&trace);
+
+  #ifndef THIN_NULL_BACKEND
+  destroyHeadlessContext(&headless);
+  #endif
+
+  if(out != stdout)
+  {
+    fclose(out);
+  }
+
+  return 0;
+}
@@ -1,9 +1,31 @@
 
+#ifdef THIN_HEADLESS
+#define THIN_HEADLESS_IMPL
+#include <thin/ogl_headless.hpp>
+#else
 #include <SDL2/SDL.h>
+#endif
 
 #define THIN_DEVICE_IMPL
 #include <thin/ogl_device.hpp>
 
+#define THIN_VERTEX_FORMAT_IMPL
+#include <thin/vertex_format.hpp>
+
+#define THIN_MESH_IMPL
+#include <thin/mesh.hpp>
+
+#define THIN_IMAGE_IMPL
+#include <thin/image.hpp>
+
+#define THIN_DECODE_POOL_IMPL
+#include <thin/ogl_decode_pool.hpp>
+
+#ifdef THIN_PROFILE
+#define THIN_PROFILE_IMPL
+#include <thin/ogl_profile.hpp>
+#endif
+
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 
@@ -51,6 +73,19 @@ int
 main()
 {
   // SDL Window
+  #ifdef THIN_HEADLESS
+  // No window, renders a fixed number of frames on EGL then exits.
+  HeadlessContext headless;
+
+  if(!createHeadlessContext(&headless, 800, 480, 3, 3))
+  {
+    printf("Failed to create a headless context\n");
+    return 1;
+  }
+
+  gl.initialize(GLLoading::all, headlessGetProc);
+  gl.setDefaultFramebuffer(headless.framebuffer);
+  #else
   SDL_Init(SDL_INIT_EVERYTHING);
 
   auto sdl_window = SDL_CreateWindow("GL",
@@ -62,7 +97,7 @@ main()
 
   // GL
   SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);
-  SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 2);
+  SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 3);
   SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
   SDL_GL_SetAttribute(SDL_GL_RED_SIZE, 5);
   SDL_GL_SetAttribute(SDL_GL_GREEN_SIZE, 5);
@@ -78,6 +113,16 @@ main()
   SDL_GL_MakeCurrent(sdl_window, gl_context);
 
   gl.initialize();
+  #endif
+
+  #ifdef THIN_TRACE
+  glTraceBegin("test.thtr");
+  #endif
+
+  #ifdef THIN_PROFILE
+  Profiler profiler;
+  createProfiler(&profiler, &gl);
+  #endif
 
   gl.errorCallback([](const char *str){
     printf("%s\n", str);
@@ -85,11 +130,6 @@ main()
 
   gl.enable(GL_DEPTH_TEST);
 
-  // Create Vertex Array Object
-
-  const uintptr_t vao = gl.genVertexArray();
-  gl.bindVertexArray(vao);
-
   // Create a Vertex Buffer Object and copy the vertex data to it
   const uintptr_t vbo = gl.genBuffer();
 
@@ -144,9 +184,6 @@ main()
       -1.0f, -1.0f, -0.5f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f
   };
 
-  gl.bindBuffer(GL_ARRAY_BUFFER, vbo);
-  gl.bufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
   // Create and compile the vertex shader
   const uintptr_t shader_program = gl.createProgram(vertexSource, nullptr, fragmentSource);
   gl.useProgram(shader_program);
@@ -154,47 +191,121 @@ main()
   GLuint shaderProgram = (GLuint)shader_program;
 
   // Specify the layout of the vertex data
-  const intptr_t pos_index = gl.getAttribLocation(shader_program, "position");
-  gl.enableVertexAttribArrayPointer(pos_index, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), 0);
+  const GLuint pos_index = (GLuint)gl.getAttribLocation(shader_program, "position");
+  const GLuint col_index = (GLuint)gl.getAttribLocation(shader_program, "color");
+  const GLuint tex_index = (GLuint)gl.getAttribLocation(shader_program, "texcoord");
 
-  const intptr_t col_index = gl.getAttribLocation(shader_program, "color");
-  gl.enableVertexAttribArrayPointer(col_index, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (void*)(3 * sizeof(GLfloat)));
+  const VertexLayout layout = {
+    {
+      {pos_index, 3, GL_FLOAT, GL_FALSE, GL_FALSE, 0, 0 * sizeof(GLfloat), 0},
+      {col_index, 3, GL_FLOAT, GL_FALSE, GL_FALSE, 0, 3 * sizeof(GLfloat), 0},
+      {tex_index, 2, GL_FLOAT, GL_FALSE, GL_FALSE, 0, 6 * sizeof(GLfloat), 0},
+    },
+    3,
+    {8 * sizeof(GLfloat)}
+  };
 
-  const intptr_t tex_index = gl.getAttribLocation(shader_program, "texcoord");
-  gl.enableVertexAttribArrayPointer(tex_index, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (void*)(6 * sizeof(GLfloat)));
+  // Pack colors to bytes and uvs to halfs, 32 bytes a vertex down to 20.
+  const VertexFormat formats[] = {
+    VertexFormat::float32,
+    VertexFormat::unorm8,
+    VertexFormat::half16,
+  };
 
-  // Load textures
-  uintptr_t textures[2];
-  gl.genTextures(2, textures);
+  // Remove duplicate vertices, the cube and floor share 28 of the 42.
+  constexpr size_t vertex_count = sizeof(vertices) / (8 * sizeof(GLfloat));
 
-  unsigned char* image;
+  uint32_t indices[vertex_count];
+  MeshIndexResult mesh = indexMesh(vertices, vertex_count, layout.strides[0], vertices, indices);
 
-  gl.bindActiveTexture(GL_TEXTURE0, GL_TEXTURE_2D, textures[0]);
+  // Reorder triangles per draw, then vertices for the whole buffer.
+  uint8_t *cube_indices = (uint8_t*)indices;
+  uint8_t *floor_indices = cube_indices + 36 * mesh.index_size;
 
-  int x,y,n;
-  auto data = stbi_load("/Users/phil0005/Desktop/slim/img.png", &x, &y, &n, 0);
+  const MeshCacheStats before = analyzeVertexCache(indices, mesh.index_count, mesh.index_type, mesh.vertex_count);
 
-  gl.uniform1i(gl.getUniformLocation(shader_program, "texKitten"), 0);
-  // glUniform1i(glGetUniformLocation(shaderProgram, "texKitten"), 0);
+  optimizeVertexCache(cube_indices, 36, mesh.index_type, mesh.vertex_count);
+  optimizeVertexCache(floor_indices, 6, mesh.index_type, mesh.vertex_count);
+
+  mesh.vertex_count = optimizeVertexFetch(vertices, mesh.vertex_count, layout.strides[0], indices, mesh.index_count, mesh.index_type);
+
+  const MeshCacheStats after = analyzeVertexCache(indices, mesh.index_count, mesh.index_type, mesh.vertex_count);
+
+  printf("ACMR %.2f -> %.2f, ATVR %.2f -> %.2f\n", before.acmr, after.acmr, before.atvr, after.atvr);
+
+  VertexLayout packed_layout;
+  const size_t packed_stride = vertexFormatLayout(layout, formats, &packed_layout);
+
+  uint8_t *packed_vertices = (uint8_t*)malloc(mesh.vertex_count * packed_stride);
+  transcodeVertices(layout, formats, vertices, mesh.vertex_count, packed_vertices);
+
+  gl.bindBuffer(GL_ARRAY_BUFFER, vbo);
+  gl.bufferData(GL_ARRAY_BUFFER, mesh.vertex_count * packed_stride, packed_vertices, GL_STATIC_DRAW);
 
-  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, x, y, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+  free(packed_vertices);
 
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  const uintptr_t ibo = gl.genBuffer();
 
-  gl.bindActiveTexture(GL_TEXTURE1, GL_TEXTURE_2D, textures[1]);
+  gl.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+  gl.bufferData(GL_ELEMENT_ARRAY_BUFFER, mesh.index_count * mesh.index_size, indices, GL_STATIC_DRAW);
+
+  gl.bindVertexLayout(packed_layout, 1, &vbo, ibo);
+
+  const GLvoid *floor_offset = (const GLvoid*)(36 * mesh.index_size);
+
+  // Load textures, decoded on the pool's threads and bound once they're in.
+  uintptr_t textures[2] = {};
+
+  DecodePoolDesc decode_desc = {};
+  decode_desc.decode = [](void*, const uint8_t *bytes, const size_t size, DecodedImage *out_image)
+  {
+    int x = 0, y = 0, n = 0;
+    out_image->pixels = stbi_load_from_memory(bytes, (int)size, &x, &y, &n, 0);
+
+    // Grey and grey alpha come back as RGBA, the pool takes 3 or 4 channels.
+    if(out_image->pixels && n < 3)
+    {
+      stbi_image_free(out_image->pixels);
+      out_image->pixels = stbi_load_from_memory(bytes, (int)size, &x, &y, &n, 4);
+      n = 4;
+    }
+
+    out_image->width = x;
+    out_image->height = y;
+    out_image->channels = n;
+
+    return out_image->pixels != nullptr;
+  };
+  decode_desc.free_pixels = [](void*, uint8_t *pixels) { stbi_image_free(pixels); };
+
+  DecodePool *decode_pool = createDecodePool(&gl, decode_desc);
+
+  for(uintptr_t &texture : textures)
+  {
+    DecodeRequest request = {};
+    request.path = "/Users/phil0005/Desktop/slim/img.png";
+    request.ready = [](void *user, const uintptr_t texture) { *(uintptr_t*)user = texture; };
+    request.ready_user = &texture;
+
+    decodePoolLoad(decode_pool, request);
+  }
+
+  gl.uniform1i(gl.getUniformLocation(shader_program, "texKitten"), 0);
+  // glUniform1i(glGetUniformLocation(shaderProgram, "texKitten"), 0);
 
   // glUniform1i(glGetUniformLocation(shaderProgram, "texPuppy"), 1);
   gl.uniform1i(gl.getUniformLocation(shader_program, "texPuppy"), 0);
 
-  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, x, y, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+  // Both textures filter the same way, one sampler serves the two units.
+  // Sampler objects are core in 3.3, which is what the context asks for.
+  SamplerDesc sampler_desc = {};
+  sampler_desc.min_filter = GL_LINEAR;
+  sampler_desc.wrap_s = GL_CLAMP_TO_EDGE;
+  sampler_desc.wrap_t = GL_CLAMP_TO_EDGE;
 
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  const uintptr_t sampler = gl.getSampler(sampler_desc);
+  gl.bindSampler(0, sampler);
+  gl.bindSampler(1, sampler);
 
   GLint uniModel = (GLint)gl.getUniformLocation(shader_program, "model");
   GLint uniProj = (GLint)gl.getUniformLocation(shaderProgram, "proj");
@@ -216,8 +327,16 @@ main()
 
   // Game loop
   bool is_running = true;
+
+  #ifdef THIN_HEADLESS
+  int frames_left = 300;
+  #endif
+
   while(is_running)
   {
+    #ifdef THIN_HEADLESS
+    is_running = --frames_left > 0;
+    #else
     // Process Events
     SDL_Event sdl_event;
 
@@ -228,6 +347,18 @@ main()
         is_running = false;
       }
     }
+    #endif
+
+    gl.beginFrame();
+
+    #ifdef THIN_PROFILE
+    profileBeginFrame(&profiler);
+    #endif
+
+    // A few MB of texture a frame, the bind cache skips units that haven't
+    // changed.
+    decodePoolUpload(decode_pool, 4 << 20);
+    gl.bindTextures(0, 2, textures);
 
     // *** Do Your Stuff.
 
@@ -249,7 +380,9 @@ main()
     glUniformMatrix4fv(uniModel, 1, GL_FALSE, glm::value_ptr(model));
 
     // Draw cube
-    gl.drawArrays(GL_TRIANGLES, 0, 36);
+    gl.pushGroupMarker("Cube");
+    gl.drawElements(GL_TRIANGLES, 36, mesh.index_type, 0);
+    gl.popGroupMarker();
 
     gl.enable(GL_STENCIL_TEST);
 
@@ -261,7 +394,9 @@ main()
 
     gl.clear(GL_STENCIL_BUFFER_BIT);
 
-    gl.drawArrays(GL_TRIANGLES, 36, 6);
+    gl.pushGroupMarker("Floor");
+    gl.drawElements(GL_TRIANGLES, 6, mesh.index_type, floor_offset);
+    gl.popGroupMarker();
 
     // Draw cube reflection
     glStencilFunc(GL_EQUAL, 1, 0xFF);
@@ -275,18 +410,51 @@ main()
     glUniformMatrix4fv(uniModel, 1, GL_FALSE, glm::value_ptr(model));
 
     glUniform3f(uniColor, 0.3f, 0.3f, 0.3f);
-    gl.drawArrays(GL_TRIANGLES, 0, 36);
+    gl.pushGroupMarker("Reflection");
+    gl.drawElements(GL_TRIANGLES, 36, mesh.index_type, 0);
+    gl.popGroupMarker();
     glUniform3f(uniColor, 1.0f, 1.0f, 1.0f);
 
     gl.disable(GL_STENCIL_TEST);
 
+    #ifdef THIN_PROFILE
+    profileEndFrame(&profiler);
+    #endif
+
+    gl.endFrame();
+
+    #ifdef THIN_HEADLESS
+    glFinish();
+    #else
     SDL_GL_SwapWindow(sdl_window);
+    #endif
+
+    #ifdef THIN_TRACE
+    glTraceFrame();
+    #endif
   }
 
+  destroyDecodePool(decode_pool);
   gl.deleteTextures(2, textures);
   gl.deleteProgram(shaderProgram);
   gl.deleteBuffer(vbo);
-  gl.deleteVertexArray(vao);
+  gl.deleteBuffer(ibo);
+  gl.clearVertexArrayCache();
+  gl.clearUploadPool();
+  gl.clearSamplerCache();
+
+  #ifdef THIN_PROFILE
+  writeChromeTrace(&profiler, "test_profile.json");
+  destroyProfiler(&profiler);
+  #endif
+
+  #ifdef THIN_TRACE
+  glTraceEnd();
+  #endif
+
+  #ifdef THIN_HEADLESS
+  destroyHeadlessContext(&headless);
+  #endif
 
   return 0;
 }